@@ -4,6 +4,7 @@
 #include "exchange_interface.h"
 #include "websocket_client.h"
 #include "rest_client.h"
+#include "user_data_stream.h"
 #include <memory>
 #include <mutex>
 #include <atomic>
@@ -26,6 +27,7 @@ public:
     bool subscribe_orderbook(const std::string& symbol, int depth = 20) override;
     bool subscribe_trades(const std::string& symbol) override;
     bool unsubscribe(const std::string& symbol) override;
+    bool subscribe_user_data() override;
 
     std::optional<OrderBook> get_orderbook(const std::string& symbol, int limit = 20) override;
     std::optional<double> get_current_price(const std::string& symbol) override;
@@ -37,7 +39,8 @@ public:
         OrderSide side,
         double price,
         double quantity,
-        const std::string& client_order_id = ""
+        const std::string& client_order_id = "",
+        bool post_only = false
     ) override;
 
     std::optional<Order> place_market_order(
@@ -86,6 +89,9 @@ public:
         int& price_precision,
         int& quantity_precision
     ) override;
+    std::optional<ExchangeFilters> get_symbol_filters(const std::string& symbol) override;
+    bool sync_clock() override;
+    std::vector<LatencyProbe> probe_latency(const std::optional<ProbeOrder>& order) override;
 
     double format_price(double price, const std::string& symbol) override;
     double format_quantity(double quantity, const std::string& symbol) override;
@@ -101,6 +107,7 @@ private:
     // Binance-specific components
     std::shared_ptr<WebSocketClient> ws_client_;
     std::shared_ptr<RestClient> rest_client_;
+    std::unique_ptr<UserDataStream> user_stream_;  // listenKey from REST
 
     // Symbol info cache
     struct SymbolInfo {
@@ -111,6 +118,7 @@ private:
         double tick_size;
     };
     std::map<std::string, SymbolInfo> symbol_cache_;
+    std::map<std::string, ExchangeFilters> filters_cache_;  // Full exchangeInfo filters
     std::mutex cache_mutex_;
 
     // Connection state
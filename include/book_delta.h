@@ -0,0 +1,67 @@
+#ifndef BOOK_DELTA_H
+#define BOOK_DELTA_H
+
+#include "types.h"
+#include <vector>
+#include <cstdint>
+
+namespace MarketMaker {
+
+// One book level that differs from the previous update. A level that
+// appeared has old price/quantity 0; one that disappeared has new ones 0.
+struct LevelChange {
+    OrderSide side = OrderSide::BUY;
+    uint16_t level = 0;       // Index from the touch
+    double old_price = 0.0;
+    double old_quantity = 0.0;
+    double new_price = 0.0;
+    double new_quantity = 0.0;
+};
+
+// What changed between two consecutive book updates.
+//
+// `mask` has bit i set when bid level i changed and bit MAX_LEVELS + i when
+// ask level i did, for the top MAX_LEVELS levels, plus TOP_OF_BOOK when
+// either level 0 changed and TOUCH_PRICE when a best price moved (the mid
+// moved). `changes` lists every changed level, including deeper ones.
+struct BookDelta {
+    static constexpr int MAX_LEVELS = 31;
+    static constexpr uint64_t TOP_OF_BOOK = 1ULL << 62;
+    static constexpr uint64_t TOUCH_PRICE = 1ULL << 63;
+
+    uint64_t mask = 0;
+    std::vector<LevelChange> changes;
+
+    static constexpr uint64_t level_bit(OrderSide side, int level) {
+        return 1ULL << (side == OrderSide::BUY ? level : MAX_LEVELS + level);
+    }
+    // Bits for levels [0, levels) of both sides
+    static constexpr uint64_t top_levels(int levels) {
+        uint64_t side = (levels >= MAX_LEVELS) ? (1ULL << MAX_LEVELS) - 1 : (1ULL << levels) - 1;
+        return side | (side << MAX_LEVELS);
+    }
+
+    bool empty() const { return mask == 0 && changes.empty(); }
+    bool top_changed() const { return (mask & TOP_OF_BOOK) != 0; }
+    bool touch_moved() const { return (mask & TOUCH_PRICE) != 0; }
+    bool any_within(int levels) const { return (mask & top_levels(levels)) != 0; }
+};
+
+// Turns full-depth snapshots into BookDeltas by comparing each level with
+// the previous snapshot at the same index. The returned delta is reused and
+// valid until the next apply(). Not thread-safe: one feed thread.
+class BookChangeTracker {
+public:
+    const BookDelta& apply(const OrderBook& book);
+    void reset();
+
+private:
+    OrderBook previous_;
+    BookDelta delta_;
+
+    void diff_side(OrderSide side, const std::vector<PriceLevel>& before, const std::vector<PriceLevel>& after);
+};
+
+} // namespace MarketMaker
+
+#endif // BOOK_DELTA_H
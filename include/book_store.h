@@ -0,0 +1,226 @@
+#ifndef BOOK_STORE_H
+#define BOOK_STORE_H
+
+#include "types.h"
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace MarketMaker {
+
+// Columnar on-disk history of one symbol for one UTC day: book level updates
+// (snapshots and deltas) and trades.
+//
+// Rows are grouped into blocks of up to block_rows, each holding one table's
+// columns back to back: time, flags, price, quantity. Prices and quantities
+// are integers (value * 10^decimals); times (microseconds since epoch) and
+// prices and quantities are stored as zigzag varint deltas from the previous
+// row (prices and quantities per side). Every block restarts its deltas, so
+// any block decodes on its own. A footer indexes the blocks by table and time
+// range; files are read through mmap.
+//
+// Layout: BookStoreHeader, blocks, BlockIndexEntry[block_count], trailer.
+
+enum class BookStoreTable : uint8_t {
+    BOOK = 0,    // Level updates
+    TRADES = 1
+};
+
+// Book row flags
+enum BookRowFlag : uint8_t {
+    ROW_ASK = 1 << 0,        // Ask level (bid otherwise); trades: seller was the aggressor
+    ROW_SNAPSHOT = 1 << 1,   // Part of a full snapshot
+    ROW_RESET = 1 << 2,      // First row of a snapshot: clear the book before applying
+    ROW_END = 1 << 3         // Last row of one exchange update: the book is consistent here
+};
+
+#pragma pack(push, 1)
+struct BookStoreHeader {
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint32_t day = 0;              // YYYYMMDD (UTC)
+    uint8_t price_decimals = 0;
+    uint8_t quantity_decimals = 0;
+    uint16_t reserved = 0;
+    char symbol[32] = {};
+    uint8_t padding[16] = {};
+};
+
+struct BlockIndexEntry {
+    uint64_t offset = 0;           // From the start of the file
+    int64_t first_time_us = 0;
+    int64_t last_time_us = 0;
+    uint32_t rows = 0;
+    uint32_t column_bytes[4] = {}; // time, flags, price, quantity
+    uint8_t table = 0;             // BookStoreTable
+    uint8_t has_snapshot = 0;      // Book blocks: holds a ROW_RESET row
+    uint8_t reserved[2] = {};
+};
+
+struct BookStoreTrailer {
+    uint64_t index_offset = 0;
+    uint32_t block_count = 0;
+    uint32_t magic = 0;
+};
+#pragma pack(pop)
+
+// One decoded block, column by column
+struct BookStoreColumns {
+    std::vector<int64_t> time_us;
+    std::vector<uint8_t> flags;
+    std::vector<int64_t> price;     // Scaled by 10^price_decimals
+    std::vector<int64_t> quantity;  // Scaled by 10^quantity_decimals
+
+    size_t size() const { return time_us.size(); }
+};
+
+// Appends rows to one day file. Rows must come in time order; close() (or
+// the destructor) writes the index.
+class BookStoreWriter {
+public:
+    static constexpr uint32_t MAGIC = 0x4b424d4d;  // "MMBK"
+    static constexpr uint32_t VERSION = 2;  // 2: delta-encoded quantities
+
+    BookStoreWriter() = default;
+    ~BookStoreWriter();
+
+    BookStoreWriter(const BookStoreWriter&) = delete;
+    BookStoreWriter& operator=(const BookStoreWriter&) = delete;
+
+    bool open(const std::string& path, const std::string& symbol, uint32_t day,
+              int price_decimals = 8, int quantity_decimals = 8, uint32_t block_rows = 65536);
+    bool close();
+    bool is_open() const { return file_ != nullptr; }
+
+    // Full book: replaces everything before it
+    void add_snapshot(int64_t time_us, const std::vector<PriceLevel>& bids, const std::vector<PriceLevel>& asks);
+    // Changed levels of one update; quantity 0 removes the level
+    void add_delta(int64_t time_us, const std::vector<PriceLevel>& bids, const std::vector<PriceLevel>& asks);
+    void add_trade(int64_t time_us, OrderSide aggressor, double price, double quantity);
+
+    uint64_t rows_written() const { return rows_written_; }
+
+    // Path of a symbol's file for a day under root: root/SYMBOL/YYYY-MM-DD.mmbk
+    static std::string day_path(const std::string& root, const std::string& symbol, uint32_t day);
+    // UTC YYYYMMDD of a time in microseconds since epoch
+    static uint32_t day_of(int64_t time_us);
+
+private:
+    struct Block {
+        std::vector<uint8_t> columns[4];
+        int64_t first_time_us = 0;
+        int64_t last_time_us = 0;
+        int64_t last_price[2] = {0, 0};  // Per side (book) or one chain (trades)
+        int64_t last_quantity[2] = {0, 0};
+        uint32_t rows = 0;
+        bool has_snapshot = false;
+    };
+
+    std::FILE* file_ = nullptr;
+    std::string path_;
+    uint64_t offset_ = 0;
+    double price_scale_ = 1e8;
+    double quantity_scale_ = 1e8;
+    uint32_t block_rows_ = 65536;
+    Block blocks_[2];  // Indexed by BookStoreTable
+    std::vector<BlockIndexEntry> index_;
+    uint64_t rows_written_ = 0;
+
+    void add_row(BookStoreTable table, int64_t time_us, uint8_t flags, double price, double quantity);
+    void flush_block(BookStoreTable table);
+};
+
+// Memory-mapped read access to one day file. Blocks decode independently,
+// so readers can start anywhere through the time index.
+class BookStoreReader {
+public:
+    BookStoreReader() = default;
+    ~BookStoreReader();
+
+    BookStoreReader(const BookStoreReader&) = delete;
+    BookStoreReader& operator=(const BookStoreReader&) = delete;
+
+    bool open(const std::string& path, std::string* error = nullptr);
+    void close();
+
+    const BookStoreHeader& header() const { return header_; }
+    std::string symbol() const;
+    size_t file_size() const { return size_; }
+    double price_scale() const { return price_scale_; }
+    double quantity_scale() const { return quantity_scale_; }
+
+    // Blocks of one table in time order (indices into the file index)
+    const std::vector<uint32_t>& blocks(BookStoreTable table) const { return tables_[static_cast<int>(table)]; }
+    const BlockIndexEntry& block(uint32_t index) const { return index_[index]; }
+
+    // Position in blocks(table) of the first block that may hold rows at or
+    // after time_us
+    size_t seek(BookStoreTable table, int64_t time_us) const;
+
+    // Decodes one block into out (cleared first); false if it is corrupt
+    bool decode(uint32_t index, BookStoreColumns& out) const;
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    BookStoreHeader header_;
+    double price_scale_ = 1e8;
+    double quantity_scale_ = 1e8;
+    const BlockIndexEntry* index_ = nullptr;
+    std::vector<uint32_t> tables_[2];
+};
+
+// Replays a day file as the bot saw it: book rows and trades merged in time
+// order, with the book rebuilt and published at the end of every update.
+//
+//   BookStoreReplay replay(reader);
+//   BookStoreReplay::Event event;
+//   while (replay.next(event)) { ... event.book or event.trade ... }
+class BookStoreReplay {
+public:
+    struct Trade {
+        int64_t time_us = 0;
+        OrderSide aggressor = OrderSide::BUY;
+        double price = 0.0;
+        double quantity = 0.0;
+    };
+
+    struct Event {
+        enum class Kind { BOOK, TRADE } kind = Kind::BOOK;
+        int64_t time_us = 0;
+        const OrderBook* book = nullptr;  // BOOK: valid until the next call
+        Trade trade;                      // TRADE
+    };
+
+    // depth: levels per side in the published OrderBook
+    explicit BookStoreReplay(const BookStoreReader& reader, int64_t from_us = 0, int depth = 20);
+
+    bool next(Event& event);
+
+private:
+    struct Cursor {
+        size_t block = 0;    // Position in reader.blocks(table)
+        size_t row = 0;
+        BookStoreColumns columns;
+        bool done = false;
+    };
+
+    const BookStoreReader& reader_;
+    int64_t from_us_;
+    int depth_;
+    Cursor cursors_[2];  // Indexed by BookStoreTable
+    std::map<int64_t, int64_t, std::greater<int64_t>> bids_;
+    std::map<int64_t, int64_t> asks_;
+    bool synced_ = false;  // A snapshot has been applied
+    OrderBook book_;
+
+    bool ready(BookStoreTable table);
+    void publish(int64_t time_us);
+};
+
+} // namespace MarketMaker
+
+#endif // BOOK_STORE_H
@@ -5,6 +5,14 @@
 #include <chrono>
 #include <map>
 #include <vector>
+#include "types.h"
+#include "socket_options.h"
+#include "order_errors.h"
+#include "latency_slo.h"
+#include "latency_prober.h"
+#include "fair_value.h"
+#include "lead_lag.h"
+#include "flight_recorder.h"
 
 namespace MarketMaker {
 
@@ -37,31 +45,83 @@ struct Config {
     // WebSocket Trading API endpoint (for order management via WebSocket)
     std::string ws_trading_url = "wss://ws-api.binance.com:443";
     bool use_websocket_trading = false;  // Use WebSocket API for trading instead of REST
+    bool use_user_data_stream = true;    // Subscribe to fills for immediate requotes
+    std::string order_response_type = "ACK";  // newOrderRespType: "ACK", "RESULT" or "FULL"
 
     // API Credentials (will be loaded from environment or config file)
     std::string api_key;
     std::string api_secret;
     std::string passphrase;  // For exchanges like Coinbase that require it
+    std::vector<SubAccount> sub_accounts;  // Order entry is sharded over these and the main key
+    std::string shard_by = "side";         // Which account takes an order: "side" or "load"
+
+    // Mock exchange market data
+    std::string replay_file;          // Book store day file played as the feed
+    double replay_speed = 1.0;        // Multiple of the recorded pace (0 = as fast as possible)
 
     // Trading parameters
     double spread_percentage = 0.02;  // 2% spread from mid price
     double order_size = 0.001;        // Order size in base currency
     int price_precision = 2;          // Price decimal precision
     int quantity_precision = 6;       // Quantity decimal precision
+    std::string quote_placement = "spread"; // "spread", "join", "improve" or "back_off" (see QuotePlacer)
+    int placement_depth = 10;               // Book levels the placement scans per side
+    int improve_min_spread_ticks = 3;       // "improve": minimum touch spread in ticks
+    double placement_wall_size = 10.0;      // "back_off": wall size in multiples of order_size
+    bool post_only = true;            // Quote with maker-only orders (Binance LIMIT_MAKER)
+    double inventory_skew = 0.0001;   // Quote shift (fraction of mid) per order_size of inventory
+    double queue_keep_max_ahead = 1.0;    // Keep a quote with at most this many order_size ahead of it...
+    double queue_keep_max_drift = 0.0005; // ...if within this fraction of mid of its new price (0 = always replace)
 
     // Performance settings
     std::chrono::milliseconds order_update_cooldown{100};  // Min time between order updates
+    std::chrono::milliseconds fill_requote_cooldown{50};   // Min time between fill-triggered requotes per side
+    int quote_cache_ticks = 5;                             // Precompute quotes for mids within +/- this many ticks (0 = off)
+    bool inline_strategy = false;                          // Run strategy and order sends on the feed thread
+    int strategy_cpu = -1;                                 // Pin the feed thread to this CPU in inline mode (-1 = no)
     std::chrono::milliseconds reconnect_delay{5000};       // WebSocket reconnect delay
     int max_reconnect_attempts = 10;
 
+    // Network settings
+    bool use_ktls = false;  // Offload TLS record crypto to the kernel (Linux kTLS)
+    SocketProfile socket_profile;  // Socket options for every transport
+
+    // Exchange error handling
+    int error_pause_ms = 1000;         // Rate-limit pause when the error has no retryAfter
+    int side_disable_ms = 60000;       // How long DISABLE_SIDE keeps a side from quoting
+    std::map<int, ErrorPolicy> error_policies;  // Per-code overrides of the built-in policies
+
+    // Hot reload of strategy parameters (ParameterStore)
+    bool hot_reload = true;       // Watch config_file and apply changed parameters live
+    std::string config_file;      // Path the config was loaded from (set by main, not saved)
+
+    // Adaptive quoting on feed / order-ack latency (LatencySloController)
+    SloConfig latency_slo;
+
+    // Background ping / order.test round trips on the trading connections
+    ProbeConfig latency_probe;
+
+    // Quote around a fair value merged from this and other venues' books
+    FairValueConfig fair_value;
+
+    // Shift the fair value with instruments we follow but don't trade
+    LeadLagConfig lead_lag;
+
+    // In-memory event ring dumped to disk on anomalies
+    FlightRecorderConfig flight_recorder;
+
     // Logging
     bool enable_verbose_logging = true;
     std::string log_file = "logs/market_maker.log";
+    std::string decision_journal;  // Binary journal of quote decisions; empty = off
 
     // Rate limiting (exchange-specific, will be overridden)
     int max_orders_per_second = 10;
     int max_requests_per_second = 10;
     int max_weight_per_minute = 1200;  // Binance-specific weight limit
+    int max_cancels_per_second = 20;
+    bool shared_rate_limit = false;    // Share the order/cancel budget with other processes on this API key
+    int order_scheduler_workers = 2;   // Threads draining the order request queue
 
     // Exchange-specific parameters (optional)
     std::map<std::string, std::string> extra_params;
@@ -0,0 +1,102 @@
+#ifndef DECISION_JOURNAL_H
+#define DECISION_JOURNAL_H
+
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace MarketMaker {
+
+// What the strategy did with one set of inputs
+enum class JournalAction : uint8_t {
+    INVALID_INPUT = 0,   // No usable mid
+    PULLED = 1,          // Quoting not allowed (latency SLO)
+    SKIP = 2,            // Mid moved less than the requote threshold
+    KEEP = 3,            // Both resting quotes kept
+    REPLACE_BID = 4,
+    REPLACE_ASK = 5,
+    REPLACE_BOTH = 6,
+    FILL_REQUOTE = 7,    // Filled side quoted again
+    FILL_SKIP = 8        // Filled side left empty (pulled or cooldown)
+};
+
+// Why, as bits; several can be set
+enum JournalReason : uint16_t {
+    REASON_NO_ACTIVE_ORDERS = 1 << 0,
+    REASON_PRICE_MOVED = 1 << 1,
+    REASON_BELOW_THRESHOLD = 1 << 2,
+    REASON_KEEP_BID_QUEUE = 1 << 3,    // Bid kept for its queue position
+    REASON_KEEP_ASK_QUEUE = 1 << 4,
+    REASON_SLO_PULLED = 1 << 5,
+    REASON_SLO_SCALED = 1 << 6,        // Spread/size scaled by the SLO level
+    REASON_QUOTE_CACHE = 1 << 7,       // Prices came from the precomputed quotes
+    REASON_INVENTORY_SKEW = 1 << 8,
+    REASON_PLACEMENT = 1 << 9,         // Prices placed against the book (non-spread placement)
+    REASON_FILL = 1 << 10,
+    REASON_FILL_COOLDOWN = 1 << 11,
+    REASON_BID_SIDE = 1 << 12,         // Fill decisions: which side
+    REASON_ASK_SIDE = 1 << 13
+};
+
+// One decision, fixed size and free of timestamps so that two runs over the
+// same inputs produce byte-identical journals
+#pragma pack(push, 1)
+struct JournalEntry {
+    uint64_t seq = 0;            // Decision number within the journal
+    uint64_t input_id = 0;       // Hash of every input the decision read
+    double fair_value = 0.0;     // Mid the quotes were priced from
+    double bid_target = 0.0;     // Spread and skew applied, before placement
+    double ask_target = 0.0;
+    double bid_price = 0.0;      // Chosen quotes, 0 if the side is not sent
+    double ask_price = 0.0;
+    double quantity = 0.0;
+    uint16_t reasons = 0;        // JournalReason bits
+    uint8_t action = 0;          // JournalAction
+    uint8_t reserved[5] = {};
+};
+#pragma pack(pop)
+static_assert(sizeof(JournalEntry) == 72, "journal entries are a fixed on-disk size");
+
+// Append-only binary file of JournalEntry records behind a 16-byte header
+// (magic, version, entry size). Writes go through a large stdio buffer, so
+// recording a decision is a copy into memory on the strategy thread.
+class DecisionJournal {
+public:
+    static constexpr uint32_t MAGIC = 0x4a444d4d;  // "MMDJ"
+    static constexpr uint32_t VERSION = 1;
+
+    DecisionJournal() = default;
+    ~DecisionJournal();
+
+    DecisionJournal(const DecisionJournal&) = delete;
+    DecisionJournal& operator=(const DecisionJournal&) = delete;
+
+    // Truncates the file
+    bool open(const std::string& path);
+    void close();
+    bool is_open() const { return file_ != nullptr; }
+
+    // Assigns the sequence number
+    void record(JournalEntry entry);
+
+    static std::optional<std::vector<JournalEntry>> read(const std::string& path, std::string* error = nullptr);
+
+    // Hash inputs into an input_id (FNV-1a over the raw bytes)
+    static uint64_t hash(uint64_t seed, double value);
+    static constexpr uint64_t HASH_SEED = 14695981039346656037ULL;
+
+    static const char* action_name(uint8_t action);
+    static std::string reason_names(uint16_t reasons);
+
+private:
+    std::mutex mutex_;
+    std::FILE* file_ = nullptr;
+    uint64_t next_seq_ = 0;
+};
+
+} // namespace MarketMaker
+
+#endif // DECISION_JOURNAL_H
@@ -0,0 +1,43 @@
+#ifndef EXCHANGE_CLOCK_H
+#define EXCHANGE_CLOCK_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace MarketMaker {
+
+// Offset between the local wall clock and the exchange's, used for every
+// signed request timestamp (REST and WebSocket API) so a drifting host clock
+// doesn't turn into -1021 "timestamp outside recvWindow" rejects.
+class ExchangeClock {
+public:
+    static ExchangeClock& instance() {
+        static ExchangeClock instance;
+        return instance;
+    }
+
+    // Local epoch milliseconds, uncorrected
+    static int64_t local_ms();
+
+    // Exchange epoch milliseconds (local clock plus the measured offset)
+    int64_t now_ms() const { return local_ms() + offset_ms_.load(std::memory_order_relaxed); }
+
+    int64_t offset_ms() const { return offset_ms_.load(std::memory_order_relaxed); }
+
+    // Record a server time sampled between sent_ms and received_ms (local);
+    // assumes the server stamped it half way through the round trip
+    void update(int64_t server_time_ms, int64_t sent_ms, int64_t received_ms);
+
+    // Local steady time at which the exchange clock reaches exchange_ms
+    std::chrono::steady_clock::time_point to_steady(int64_t exchange_ms) const;
+
+private:
+    ExchangeClock() = default;
+
+    std::atomic<int64_t> offset_ms_{0};
+};
+
+} // namespace MarketMaker
+
+#endif // EXCHANGE_CLOCK_H
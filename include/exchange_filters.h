@@ -0,0 +1,109 @@
+#ifndef EXCHANGE_FILTERS_H
+#define EXCHANGE_FILTERS_H
+
+#include "types.h"
+#include <string>
+#include <map>
+#include <optional>
+
+namespace Json {
+class Value;
+}
+
+namespace MarketMaker {
+
+// Every symbol filter Binance publishes in exchangeInfo, in one descriptor.
+// A value of 0 means "filter not present / no limit".
+struct ExchangeFilters {
+    std::string symbol;
+    std::string status;              // "TRADING", "BREAK", ...
+
+    // PRICE_FILTER
+    double min_price = 0.0;
+    double max_price = 0.0;
+    double tick_size = 0.0;
+    int price_precision = 8;
+
+    // LOT_SIZE
+    double min_qty = 0.0;
+    double max_qty = 0.0;
+    double step_size = 0.0;
+    int quantity_precision = 8;
+
+    // MARKET_LOT_SIZE
+    double market_min_qty = 0.0;
+    double market_max_qty = 0.0;
+    double market_step_size = 0.0;
+
+    // NOTIONAL (and the older MIN_NOTIONAL)
+    double min_notional = 0.0;
+    double max_notional = 0.0;
+    bool apply_min_to_market = true;
+    bool apply_max_to_market = false;
+    int avg_price_mins = 5;
+
+    // PERCENT_PRICE
+    double multiplier_up = 0.0;
+    double multiplier_down = 0.0;
+
+    // PERCENT_PRICE_BY_SIDE
+    double bid_multiplier_up = 0.0;
+    double bid_multiplier_down = 0.0;
+    double ask_multiplier_up = 0.0;
+    double ask_multiplier_down = 0.0;
+
+    // Order count limits
+    int max_num_orders = 0;          // MAX_NUM_ORDERS
+    int max_num_algo_orders = 0;     // MAX_NUM_ALGO_ORDERS
+    int max_num_iceberg_orders = 0;  // MAX_NUM_ICEBERG_ORDERS
+    int iceberg_parts = 0;           // ICEBERG_PARTS
+    double max_position = 0.0;       // MAX_POSITION
+
+    bool is_trading() const { return status.empty() || status == "TRADING"; }
+};
+
+// Result of checking a limit order against ExchangeFilters
+struct FilterCheckResult {
+    enum class Status {
+        OK,        // Passes as-is
+        ADJUSTED,  // Passes after a safe adjustment (see price/quantity)
+        REJECTED   // Would be rejected by the exchange
+    };
+
+    Status status = Status::OK;
+    double price = 0.0;
+    double quantity = 0.0;
+    const char* reason = "";         // Static string, no allocation
+
+    bool accepted() const { return status != Status::REJECTED; }
+};
+
+// Shared exchangeInfo parser for the REST and WebSocket API responses (both
+// return the same "symbols" array)
+class ExchangeFilterParser {
+public:
+    static std::map<std::string, ExchangeFilters> parse_exchange_info(const Json::Value& root);
+    static ExchangeFilters parse_symbol(const Json::Value& symbol);
+};
+
+// Local pre-validation of limit orders. Constant time: a fixed sequence of
+// arithmetic checks, no lookups. Adjustments are only made where they can't
+// add risk: prices move to the passive side, quantities only shrink.
+class ExchangeFilterCheck {
+public:
+    // reference_price: current mid (stands in for the exchange's average price
+    // in the percent-price filters), 0 skips them.
+    // open_orders: orders already open on the symbol, -1 skips MAX_NUM_ORDERS.
+    static FilterCheckResult check_limit_order(
+        const ExchangeFilters& filters,
+        OrderSide side,
+        double price,
+        double quantity,
+        double reference_price = 0.0,
+        int open_orders = -1
+    );
+};
+
+} // namespace MarketMaker
+
+#endif // EXCHANGE_FILTERS_H
@@ -2,14 +2,37 @@
 #define EXCHANGE_INTERFACE_H
 
 #include "types.h"
+#include "socket_options.h"
+#include "exchange_filters.h"
+#include "book_delta.h"
 #include <string>
 #include <memory>
 #include <optional>
 #include <vector>
 #include <functional>
+#include <chrono>
 
 namespace MarketMaker {
 
+// Order used by an order.test latency probe (validated, never placed)
+struct ProbeOrder {
+    std::string symbol;
+    OrderSide side = OrderSide::BUY;
+    double price = 0.0;
+    double quantity = 0.0;
+    bool post_only = false;
+};
+
+// Round trip of one probe request on one connection
+struct LatencyProbe {
+    std::string connection;   // e.g. "rest", "ws-api"
+    std::string method;       // "ping" or "order.test"
+    int64_t rtt_us = -1;      // -1 if the probe failed
+    int weight = 1;           // Request weight it cost
+
+    bool ok() const { return rtt_us >= 0; }
+};
+
 // Forward declaration for exchange-specific configurations
 struct ExchangeConfig {
     std::string api_url;
@@ -20,6 +43,7 @@ struct ExchangeConfig {
     // WebSocket Trading API settings
     std::string ws_trading_url;        // WebSocket API endpoint for trading
     bool use_websocket_trading = false; // Use WebSocket API for orders instead of REST
+    OrderResponseType order_response_type = OrderResponseType::ACK;  // newOrderRespType for new orders
 
     // Exchange-specific parameters
     std::string exchange_type;  // "binance", "coinbase", "kraken", etc.
@@ -30,10 +54,21 @@ struct ExchangeConfig {
     int max_requests_per_second = 10;
     int max_orders_per_second = 5;
 
+    // Order entry sharding: orders are spread over the main account and these
+    std::vector<SubAccount> sub_accounts;
+    std::string shard_by = "side";     // "side" or "load"
+    std::string shared_rate_label;     // Non-empty: share each account's budget across processes, under this label
+
+    // Mock exchange: book store day file played as its market data
+    std::string replay_file;
+    double replay_speed = 1.0;         // Multiple of the recorded pace; 0 = as fast as possible
+
     // Connection settings
     bool use_testnet = false;
     int connection_timeout_ms = 5000;
     int request_timeout_ms = 10000;
+    bool use_ktls = false;             // Kernel TLS offload for WebSocket sockets
+    SocketProfile socket_profile;      // Applied to market-data, WS trading and REST sockets
 
     // Asset configuration
     std::vector<std::string> display_assets;  // Assets to display in account info
@@ -46,6 +81,8 @@ public:
     using MessageHandler = std::function<void(const std::string&)>;
     using ConnectionHandler = std::function<void(bool)>;
     using OrderbookHandler = std::function<void(const OrderBook&)>;
+    using ExecutionHandler = std::function<void(const ExecutionReport&)>;
+    using BookDeltaHandler = std::function<void(const OrderBook&, const BookDelta&)>;
 
     virtual ~IExchange() = default;
 
@@ -66,13 +103,20 @@ public:
     virtual std::optional<double> get_current_price(const std::string& symbol) = 0;
     virtual std::optional<std::string> get_exchange_info() = 0;
 
+    // Private stream of order updates and fills (delivered to the execution
+    // handler); false if the exchange has none or it failed to start
+    virtual bool subscribe_user_data() { return false; }
+
     // ========== Order Management ==========
+    // post_only: maker-only order (Binance LIMIT_MAKER), rejected instead of
+    // executed if it would cross
     virtual std::optional<Order> place_limit_order(
         const std::string& symbol,
         OrderSide side,
         double price,
         double quantity,
-        const std::string& client_order_id = ""
+        const std::string& client_order_id = "",
+        bool post_only = false
     ) = 0;
 
     virtual std::optional<Order> place_market_order(
@@ -110,6 +154,10 @@ public:
     virtual void set_orderbook_handler(OrderbookHandler handler) = 0;
     virtual void set_message_handler(MessageHandler handler) = 0;
     virtual void set_connection_handler(ConnectionHandler handler) = 0;
+    virtual void set_execution_handler(ExecutionHandler handler) { execution_handler_ = handler; }
+    // Book updates with what changed since the previous one; updates that
+    // change nothing are not delivered
+    virtual void set_book_delta_handler(BookDeltaHandler handler) { book_delta_handler_ = handler; }
 
     // ========== Utility Methods ==========
     virtual std::string get_exchange_name() const = 0;
@@ -120,6 +168,31 @@ public:
         int& quantity_precision
     ) = 0;
 
+    // Measure the exchange clock offset (ExchangeClock) used for request
+    // timestamps; false if the exchange has no time endpoint or it failed
+    virtual bool sync_clock() { return false; }
+
+    // One ping (and an order.test of `order`, if given) on every trading
+    // connection; exchanges without probe endpoints return none
+    virtual std::vector<LatencyProbe> probe_latency(const std::optional<ProbeOrder>& order) {
+        (void)order;
+        return {};
+    }
+
+    // How long until an order on this side fits the exchange's own per-account
+    // budget (sharded order entry); zero when it does or there is none
+    virtual std::chrono::milliseconds time_until_order_slot(OrderSide side) {
+        (void)side;
+        return std::chrono::milliseconds(0);
+    }
+
+    // Every exchangeInfo filter for the symbol, for local order pre-validation.
+    // Exchanges that don't publish filters return nullopt.
+    virtual std::optional<ExchangeFilters> get_symbol_filters(const std::string& symbol) {
+        (void)symbol;
+        return std::nullopt;
+    }
+
     // Format price/quantity according to exchange requirements
     virtual double format_price(double price, const std::string& symbol) = 0;
     virtual double format_quantity(double quantity, const std::string& symbol) = 0;
@@ -137,6 +210,24 @@ protected:
     OrderbookHandler orderbook_handler_;
     MessageHandler message_handler_;
     ConnectionHandler connection_handler_;
+    ExecutionHandler execution_handler_;
+    BookDeltaHandler book_delta_handler_;
+
+    // Feed thread: hand a parsed book to the orderbook and book delta handlers
+    void notify_orderbook(const OrderBook& book) {
+        if (orderbook_handler_) {
+            orderbook_handler_(book);
+        }
+        if (book_delta_handler_) {
+            const BookDelta& delta = book_tracker_.apply(book);
+            if (!delta.empty()) {
+                book_delta_handler_(book, delta);
+            }
+        }
+    }
+
+private:
+    BookChangeTracker book_tracker_;
 };
 
 // Type alias for convenience
@@ -0,0 +1,84 @@
+#ifndef FAIR_VALUE_H
+#define FAIR_VALUE_H
+
+#include "types.h"
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace MarketMaker {
+
+struct FairValueConfig {
+    bool enabled = false;
+    std::vector<std::string> venues;             // Reference exchanges, e.g. "okx"
+    std::chrono::milliseconds half_life{250};    // A quote this old counts half as much
+    std::chrono::milliseconds max_age{2000};     // Older quotes are left out entirely
+    double basis_alpha = 0.01;                   // EWMA weight of each new venue/home basis sample
+};
+
+// Per-venue view, for status output
+struct VenueQuote {
+    std::string venue;
+    double mid = 0.0;
+    double basis = 0.0;          // Average of (venue mid - home mid)
+    int64_t latency_us = 0;      // Average feed latency (receive time - venue stamp)
+    int64_t age_us = 0;          // Since the quote was received
+    double weight = 0.0;         // In the last fair value, 0 if left out
+};
+
+// Merges top-of-book from the home venue (index 0, where we quote) and any
+// number of reference venues into one fair value.
+//
+// Each venue's mid is first shifted by its average basis to the home venue,
+// so a venue that persistently trades a little higher or lower (different
+// quote currency, fees) moves the fair value only when it moves. Venues are
+// then weighted by staleness: a quote's effective age is the time since we
+// received it plus the venue's average feed latency, and its weight halves
+// every half_life of that. A fast venue that has just ticked therefore
+// dominates a home book that has not caught up yet, which is the point.
+// Quotes older than max_age, and venues with no basis yet, are left out.
+//
+// Thread-safe: each venue's feed thread calls on_book().
+class FairValueAggregator {
+public:
+    // venues[0] is the home venue
+    FairValueAggregator(const std::vector<std::string>& venues, const FairValueConfig& config = {});
+
+    void on_book(size_t venue, const OrderBook& book);
+
+    // Weighted fair value; nullopt while no venue has a usable quote
+    std::optional<double> fair_value(
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now()) const;
+
+    std::vector<VenueQuote> get_quotes(
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now()) const;
+
+    size_t venue_count() const { return venues_.size(); }
+
+private:
+    struct Venue {
+        std::string name;
+        double mid = 0.0;
+        std::chrono::steady_clock::time_point received;
+        double latency_us = 0.0;
+        double basis = 0.0;
+        bool has_quote = false;
+        bool has_latency = false;
+        bool has_basis = false;
+    };
+
+    static constexpr double LATENCY_ALPHA = 0.05;
+
+    FairValueConfig config_;
+    mutable std::mutex mutex_;
+    std::vector<Venue> venues_;
+
+    double weight(const Venue& venue, std::chrono::steady_clock::time_point now) const;
+    void update_basis(Venue& venue, double home_mid);
+};
+
+} // namespace MarketMaker
+
+#endif // FAIR_VALUE_H
@@ -0,0 +1,139 @@
+#ifndef FLIGHT_RECORDER_H
+#define FLIGHT_RECORDER_H
+
+#include "types.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace MarketMaker {
+
+enum class FlightEventType : uint8_t {
+    BOOK_TOP,       // price = best bid, quantity = best ask
+    DECISION,       // Quote target; value 1 = kept the resting quote, 0 = replace
+    ORDER_SENT,     // text = client order id
+    ORDER_ACK,      // value = round trip us, text = order id
+    ORDER_FAILED,   // value = round trip us
+    CANCEL_SENT,    // text = order id
+    CANCEL_ACK,     // value = round trip us
+    CANCEL_FAILED,  // value = round trip us (or the wait, for a timeout)
+    FILL,           // price / quantity of the fill, text = order id
+    REJECT,         // value = exchange error code, text = start of the message
+    LATENCY,        // value = reaction latency us (book received to orders sent)
+    CONNECTION,     // value 1 = connected, 0 = disconnected, text = which
+    SLO_LEVEL,      // value = SloLevel
+    TRIGGER         // text = anomaly that triggered a dump
+};
+
+enum class FlightSide : uint8_t { NONE, BID, ASK };
+
+struct FlightEvent {
+    int64_t time_ns = 0;          // steady_clock
+    FlightEventType type = FlightEventType::TRIGGER;
+    FlightSide side = FlightSide::NONE;
+    double price = 0.0;
+    double quantity = 0.0;
+    int64_t value = 0;
+    char text[24] = {};           // Truncated, NUL-terminated
+};
+
+struct FlightRecorderConfig {
+    bool enabled = true;
+    size_t capacity = 65536;                          // Events kept (rounded up to a power of two)
+    std::chrono::milliseconds window{10000};          // Dumps cover this much history
+    std::string dump_dir = "logs/flight";
+    int64_t ack_timeout_us = 100000;                  // Dump when an order/cancel round trip takes longer
+    int reject_storm_count = 5;                       // Dump on this many rejects...
+    std::chrono::milliseconds reject_storm_window{1000};  // ...within this long
+    bool dump_on_disconnect = true;
+    bool dump_on_pull = true;                         // Latency SLO pulled the quotes
+    std::chrono::milliseconds post_trigger{500};      // Keep recording this long before dumping
+    std::chrono::milliseconds min_dump_interval{30000};
+};
+
+// Always-on black box: a fixed ring of the most recent structured events
+// (book tops, quote decisions, requests and their acks, fills, rejects,
+// latencies, connection and SLO changes), written to disk only when an
+// anomaly fires.
+//
+// Writers claim a slot with one fetch_add and publish it through a per-slot
+// sequence number (a seqlock), so recording never blocks and never
+// allocates; a writer lapping a slot being dumped just makes the dumper skip
+// it. Triggers (a slow round trip, a burst of rejects, a disconnect, the SLO
+// pulling quotes, or trigger()) only mark a dump as pending: a background
+// thread waits post_trigger so the aftermath is captured, then writes the
+// last `window` of events as JSON lines to dump_dir. Dumps are at least
+// min_dump_interval apart.
+class FlightRecorder {
+public:
+    static FlightRecorder& instance() {
+        static FlightRecorder instance;
+        return instance;
+    }
+
+    // Allocates the ring and starts the dump thread. Call once, before the
+    // feed and order threads start; until then record() is a no-op.
+    void configure(const FlightRecorderConfig& config);
+
+    // Stops recording; a dump still waiting for post_trigger is written now
+    void stop();
+
+    bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    void record(FlightEventType type, FlightSide side, double price, double quantity,
+                int64_t value = 0, const std::string& text = "");
+    void record(FlightEventType type, int64_t value = 0, const std::string& text = "") {
+        record(type, FlightSide::NONE, 0.0, 0.0, value, text);
+    }
+
+    // Requests a dump; reason must be a string literal (it is kept by pointer)
+    void trigger(const char* reason);
+
+    // Writes the current window now; returns the file, empty on failure
+    std::string dump(const char* reason);
+
+    static FlightSide side_of(OrderSide side) {
+        return side == OrderSide::BUY ? FlightSide::BID : FlightSide::ASK;
+    }
+
+    uint64_t recorded() const { return head_.load(std::memory_order_relaxed); }
+    uint64_t dumps() const { return dumps_.load(std::memory_order_relaxed); }
+
+private:
+    FlightRecorder() = default;
+    ~FlightRecorder();
+
+    FlightRecorder(const FlightRecorder&) = delete;
+    FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+    struct Slot {
+        std::atomic<uint64_t> version{0};  // 2*seq+1 while writing, 2*seq+2 once written
+        FlightEvent event;
+    };
+
+    FlightRecorderConfig config_;
+    std::unique_ptr<Slot[]> slots_;
+    uint64_t mask_ = 0;
+    std::atomic<bool> enabled_{false};
+    std::atomic<uint64_t> head_{0};
+
+    // Reject storm: time of each of the last reject_storm_count rejects
+    std::unique_ptr<std::atomic<int64_t>[]> reject_times_;
+    std::atomic<uint64_t> reject_count_{0};
+
+    std::atomic<const char*> pending_{nullptr};
+    std::atomic<int64_t> pending_since_ns_{0};
+    std::atomic<uint64_t> dumps_{0};
+    std::atomic<bool> running_{false};
+    std::thread dumper_;
+
+    void check_triggers(const FlightEvent& event);
+    void run_dumper();
+};
+
+} // namespace MarketMaker
+
+#endif // FLIGHT_RECORDER_H
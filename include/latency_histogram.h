@@ -0,0 +1,52 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <string>
+#include <cstdint>
+
+namespace MarketMaker {
+
+// Fixed-size log-linear latency histogram in microseconds (about 12% bucket
+// resolution from 16 us up to ~2^40 us, exact below 16 us). Recording is a
+// couple of relaxed atomic increments, so any thread can record while another
+// reads percentiles.
+class LatencyHistogram {
+public:
+    void record(int64_t value_us);
+
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    int64_t max() const { return max_.load(std::memory_order_relaxed); }
+
+    // Upper bound of the bucket holding the given percentile (0-100), 0 if empty
+    int64_t percentile(double p) const;
+
+    void reset();
+
+    // "n=120 p50=850 p90=1400 p99=3100 max=4021 us"
+    std::string summary() const;
+
+private:
+    static constexpr int LINEAR_BUCKETS = 16;
+    static constexpr int SUB_BUCKET_BITS = 3;
+    static constexpr int MAX_EXPONENT = 40;
+    static constexpr int BUCKET_COUNT = LINEAR_BUCKETS + (MAX_EXPONENT - 3) * (1 << SUB_BUCKET_BITS);
+
+    static int bucket_index(int64_t value_us);
+    static int64_t bucket_upper_bound(int index);
+
+    std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<int64_t> max_{0};
+};
+
+// Latency distributions kept by OrderManager
+struct LatencyHistograms {
+    LatencyHistogram reaction;        // Orderbook update -> both quotes placed
+    LatencyHistogram fill_to_order;   // Fill received -> replacement quote placed
+};
+
+} // namespace MarketMaker
+
+#endif // LATENCY_HISTOGRAM_H
@@ -0,0 +1,98 @@
+#ifndef LATENCY_PROBER_H
+#define LATENCY_PROBER_H
+
+#include "exchange_interface.h"
+#include "latency_histogram.h"
+#include <memory>
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <optional>
+#include <chrono>
+
+namespace MarketMaker {
+
+struct ProbeConfig {
+    bool enabled = true;
+    std::chrono::milliseconds interval{1000};  // Between probe rounds
+    int order_test_every = 5;                  // Every Nth round also sends order.test (0 = never)
+    int weight_per_minute = 60;                // Request weight the prober may spend per minute
+};
+
+// Measures order-path round trips between quotes: every interval, a ping
+// (and every order_test_every rounds an order.test) on each trading
+// connection of the exchange. RTTs go into per-connection histograms and to
+// the sample handler (latency SLO); fastest_connection() ranks connections
+// for routing. Rounds that would take the prober past its own weight budget
+// are skipped rather than delayed.
+class LatencyProber {
+public:
+    using OrderSource = std::function<std::optional<ProbeOrder>()>;
+    using SampleHandler = std::function<void(const LatencyProbe&)>;
+
+    struct ConnectionStats {
+        std::string connection;
+        std::string method;
+        int64_t p50_us = 0;
+        int64_t p99_us = 0;
+        uint64_t failures = 0;
+        std::string summary;
+    };
+
+    LatencyProber(std::shared_ptr<IExchange> exchange, const ProbeConfig& config);
+    ~LatencyProber();
+
+    LatencyProber(const LatencyProber&) = delete;
+    LatencyProber& operator=(const LatencyProber&) = delete;
+
+    // Order to test with (e.g. the resting bid); none skips order.test
+    void set_order_source(OrderSource source) { order_source_ = std::move(source); }
+    void set_sample_handler(SampleHandler handler) { sample_handler_ = std::move(handler); }
+
+    void start();
+    void stop();
+
+    std::vector<ConnectionStats> get_stats() const;
+    // Connection with the lowest median ping, if any has been measured
+    std::optional<std::string> fastest_connection() const;
+    uint64_t skipped_rounds() const { return skipped_rounds_.load(); }
+
+private:
+    struct Series {
+        LatencyHistogram rtt;
+        uint64_t failures = 0;
+    };
+
+    std::shared_ptr<IExchange> exchange_;
+    ProbeConfig config_;
+    OrderSource order_source_;
+    SampleHandler sample_handler_;
+
+    mutable std::mutex stats_mutex_;
+    std::map<std::pair<std::string, std::string>, std::unique_ptr<Series>> series_;  // (connection, method)
+
+    // Weight spent in the last minute (probe thread only)
+    std::deque<std::pair<std::chrono::steady_clock::time_point, int>> spent_;
+    int spent_total_ = 0;
+    int last_round_weight_ = 1;
+    std::atomic<uint64_t> skipped_rounds_{0};
+
+    std::mutex run_mutex_;
+    std::condition_variable run_cv_;
+    bool running_ = false;
+    std::thread thread_;
+
+    void run();
+    void probe_round(bool order_test);
+    bool within_budget(int weight, std::chrono::steady_clock::time_point now);
+};
+
+} // namespace MarketMaker
+
+#endif // LATENCY_PROBER_H
@@ -0,0 +1,100 @@
+#ifndef LATENCY_SLO_H
+#define LATENCY_SLO_H
+
+#include <chrono>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace MarketMaker {
+
+// How far quoting is scaled back because we are reacting slowly
+enum class SloLevel {
+    NORMAL = 0,
+    WIDEN = 1,    // Spread multiplied by widen_factor
+    SHRINK = 2,   // ...and size multiplied by shrink_factor
+    PULL = 3      // No quotes at all
+};
+
+struct SloConfig {
+    bool enabled = true;
+    double percentile = 99.0;
+    int64_t feed_slo_us = 20000;     // Market data / fill event to strategy thread
+    int64_t ack_slo_us = 50000;      // Order submitted to exchange response
+    std::chrono::milliseconds window{10000};  // Only samples this recent count
+    std::chrono::milliseconds hold{5000};     // Minimum time at a level before stepping down
+    double widen_factor = 1.5;
+    double shrink_factor = 0.5;
+};
+
+// Scales quoting back as feed and order-ack latency percentiles degrade past
+// their SLOs, and restores it as they recover.
+//
+// The worse of the two percentile/SLO ratios picks the level: WIDEN from 1x,
+// SHRINK from 2x and PULL from 4x the SLO. Escalation is immediate; stepping
+// down is one level at a time, only after the level has been held for `hold`
+// and once the ratio is below 80% of the current level's threshold. A metric
+// with too few samples in the window (e.g. acks while quotes are pulled) is
+// left out, so the level cannot get stuck on stale samples.
+//
+// Level changes are logged as one-line JSON events. Not thread-safe: the
+// strategy thread records and evaluates.
+class LatencySloController {
+public:
+    explicit LatencySloController(const SloConfig& config = {});
+
+    void record_feed(int64_t latency_us);
+    void record_ack(int64_t latency_us);
+
+    // Re-evaluates at most every EVAL_INTERVAL; true if the level changed
+    bool evaluate(std::chrono::steady_clock::time_point now);
+
+    SloLevel level() const { return level_; }
+    bool quoting_allowed() const { return level_ != SloLevel::PULL; }
+    double spread_factor() const;
+    double size_factor() const;
+
+    // Last evaluated percentiles, 0 if not enough samples
+    int64_t feed_percentile_us() const { return feed_p_us_; }
+    int64_t ack_percentile_us() const { return ack_p_us_; }
+
+    static const char* level_name(SloLevel level);
+
+private:
+    // Fixed ring of timestamped samples
+    class Window {
+    public:
+        void add(std::chrono::steady_clock::time_point time, int64_t value);
+        // Percentile over samples newer than since; -1 if fewer than MIN_SAMPLES
+        int64_t percentile(double p, std::chrono::steady_clock::time_point since) const;
+
+    private:
+        struct Sample {
+            std::chrono::steady_clock::time_point time;
+            int64_t value;
+        };
+        std::vector<Sample> samples_;
+        size_t next_ = 0;
+    };
+
+    static constexpr size_t CAPACITY = 512;
+    static constexpr size_t MIN_SAMPLES = 10;
+    static constexpr std::chrono::milliseconds EVAL_INTERVAL{250};
+    static constexpr double RECOVER_RATIO = 0.8;
+
+    SloConfig config_;
+    Window feed_;
+    Window ack_;
+
+    SloLevel level_ = SloLevel::NORMAL;
+    std::chrono::steady_clock::time_point level_since_;
+    std::chrono::steady_clock::time_point last_eval_;
+    int64_t feed_p_us_ = 0;
+    int64_t ack_p_us_ = 0;
+
+    static double threshold(SloLevel level);
+};
+
+} // namespace MarketMaker
+
+#endif // LATENCY_SLO_H
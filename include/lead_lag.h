@@ -0,0 +1,83 @@
+#ifndef LEAD_LAG_H
+#define LEAD_LAG_H
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace MarketMaker {
+
+struct LeadLagConfig {
+    bool enabled = false;
+    std::vector<std::string> leaders;   // Instruments followed but not traded, e.g. "BTCUSDT"
+    double alpha = 0.02;                // EWMA weight of each new sample of our move
+    int min_samples = 50;               // Moves of ours before a leader's beta is used
+    double max_beta = 3.0;
+    double max_shift_bps = 20.0;        // Cap on the shift applied to our fair value
+};
+
+// Per-leader view, for status output
+struct LeaderStats {
+    std::string symbol;
+    double beta = 0.0;
+    double residual_bps = 0.0;   // Std dev of our moves the leader does not explain
+    double pending_bps = 0.0;    // Leader move since ours last moved
+    int64_t samples = 0;
+};
+
+// Shifts our fair value with leader instruments before our own book follows.
+//
+// Each time our mid moves, the log move is regressed (through the origin,
+// EWMA) on every leader's log move since our previous move: beta = E[xy] /
+// E[x^2], plus the EWMA variance of the residual y - beta*x. Between our
+// moves, the leader move since our last one is "pending": we expect beta times
+// it to show up in our price. shift() returns that expectation, averaging the
+// leaders by inverse residual variance so BTC and ETH are not counted twice,
+// capped at max_shift_bps.
+//
+// on_leader() is a store of one atomic; on_follower() is O(leaders); shift()
+// reads a few atomics per leader. Each leader's feed thread calls on_leader()
+// for its own index and our feed thread calls on_follower(); shift() may be
+// called from any of them. No locks.
+class LeadLagEngine {
+public:
+    explicit LeadLagEngine(const LeadLagConfig& config);
+
+    size_t leader_count() const { return leaders_.size(); }
+
+    // Leader feed thread: leader mid changed
+    void on_leader(size_t leader, double mid);
+
+    // Our feed thread: our own mid (ignored unless it moved)
+    void on_follower(double mid);
+
+    // Expected log move of our price not yet in our book (multiply by exp())
+    double shift() const;
+
+    std::vector<LeaderStats> get_stats() const;
+
+private:
+    struct Leader {
+        std::string symbol;
+        std::atomic<double> log_price{0.0};    // Written by the leader's feed thread
+        std::atomic<double> anchor{0.0};       // Leader log price when we last moved
+        std::atomic<double> beta{0.0};         // Published by our feed thread...
+        std::atomic<double> weight{0.0};       // ...0 until min_samples
+        std::atomic<double> residual_var{0.0};
+        std::atomic<int64_t> samples{0};
+
+        // Our feed thread only
+        double sxy = 0.0;
+        double sxx = 0.0;
+    };
+
+    LeadLagConfig config_;
+    std::vector<Leader> leaders_;
+    double last_log_mid_ = 0.0;  // Our feed thread only
+    double max_shift_ = 0.0;     // max_shift_bps as a log move
+};
+
+} // namespace MarketMaker
+
+#endif // LEAD_LAG_H
@@ -5,12 +5,16 @@
 #include "types.h"
 #include "exchange_interface.h"
 #include "order_manager.h"
+#include "latency_prober.h"
+#include "fair_value.h"
+#include "lead_lag.h"
 #include "logger.h"
 #include <memory>
 #include <atomic>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
+#include <deque>
 
 namespace MarketMaker {
 
@@ -35,6 +39,18 @@ private:
     // Core components - now using exchange interface
     std::shared_ptr<IExchange> exchange_;  // Generic exchange interface
     std::shared_ptr<OrderManager> order_manager_;
+    std::unique_ptr<LatencyProber> prober_;
+
+    // Reference venues (market data only) and the fair value quoted around;
+    // null / empty unless fair_value is enabled
+    std::unique_ptr<FairValueAggregator> fair_value_;
+    std::vector<std::shared_ptr<IExchange>> reference_exchanges_;
+
+    // Leader instruments (followed, not traded) shifting the fair value;
+    // null / empty unless lead_lag is enabled
+    std::unique_ptr<LeadLagEngine> lead_lag_;
+    std::vector<std::shared_ptr<IExchange>> leader_exchanges_;
+    std::atomic<double> base_mid_{0.0};  // Mid or fair value before the lead-lag shift
     std::shared_ptr<Logger> logger_;
 
     // State
@@ -42,29 +58,50 @@ private:
     std::atomic<bool> initialized_{false};
 
     // Market data
-    OrderBook current_orderbook_;
-    std::mutex orderbook_mutex_;
+    std::mutex orderbook_mutex_;  // Guards last_orderbook_time_
     std::atomic<double> current_mid_price_{0.0};
     std::chrono::steady_clock::time_point last_orderbook_time_;
     std::atomic<bool> price_changed_{false};
     std::condition_variable price_change_cv_;
     std::mutex price_change_mutex_;
 
-    // Threads
+    // Fills from the user data stream, handed to the strategy thread
+    std::deque<ExecutionReport> pending_executions_;
+    std::mutex executions_mutex_;
+    std::atomic<bool> executions_pending_{false};
+
+    // Inline mode: the feed thread runs the strategy itself. Fills from the
+    // user data thread take turns with it through strategy_mutex_.
+    std::atomic<OrderManager*> inline_manager_{nullptr};
+    std::mutex strategy_mutex_;
+
+    // Threads (in inline mode main_thread_ only does housekeeping)
     std::thread main_thread_;
 
     // Event handlers
-    void handle_orderbook_update(const OrderBook& orderbook);
+    void handle_orderbook_update(const OrderBook& orderbook, const BookDelta& delta);
     void handle_connection_status(bool connected);
+    void handle_execution(const ExecutionReport& report);
+    void handle_reference_book(size_t venue, const OrderBook& orderbook);
+    void handle_leader_book(size_t leader, const OrderBook& orderbook);
 
     // Core logic
     void main_loop();
-    void update_mid_price();
+    void housekeeping_loop();
+    void run_inline(const OrderBook& orderbook, const BookDelta& delta,
+                    std::chrono::steady_clock::time_point received_time);
+    double reference_mid(const OrderBook& orderbook);
+    double with_lead_lag(double mid) const;
+    void requote_from_feed(double mid_price, std::chrono::steady_clock::time_point received_time);
+    void update_mid_price(double new_mid_price);
     void check_and_update_orders();
+    void process_executions();
 
     // Utilities
     bool validate_config();
     bool setup_exchange();
+    void setup_reference_venues();
+    void setup_leaders(const ExchangeConfig& exchange_config);
     void print_status();
     std::string format_symbol_for_exchange();
 };
@@ -0,0 +1,137 @@
+#ifndef MOCK_EXCHANGE_H
+#define MOCK_EXCHANGE_H
+
+#include "exchange_interface.h"
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace MarketMaker {
+
+class BookStoreReader;
+
+// In-memory exchange for offline runs: books are pushed in by the caller
+// (a replay, a synthetic feed, another venue's adapter) instead of coming
+// off a socket, and orders rest in a local book.
+//
+// A pushed book fills every resting order it crosses (bid at or above the
+// best ask, ask at or below the best bid) in full at that touch price and
+// reports it to the execution handler before the book itself is delivered.
+// Non-post-only orders that cross on arrival fill at once; their reports are
+// held until the next pushed book, as a user data stream would send them
+// after the order call returned (reporting from inside the call would
+// re-enter the caller's locks). Post-only orders that would cross on arrival
+// are rejected. Balances only change through set_balance().
+//
+// With exchange.replay_file set, subscribe_orderbook() plays that book store
+// day file (see BookStoreReplay) into push_orderbook() on its own thread.
+class MockExchange : public IExchange {
+public:
+    explicit MockExchange(std::string name = "Mock");
+    ~MockExchange() override;
+
+    // ========== Feeding the mock ==========
+    void push_orderbook(const OrderBook& book);
+    void set_balance(const std::string& asset, double amount);
+    void set_tick_size(double tick_size) { tick_size_ = tick_size; }
+    void set_step_size(double step_size) { step_size_ = step_size; }
+    std::vector<Order> get_resting_orders() const;
+
+    // ========== Connection Management ==========
+    bool initialize(const ExchangeConfig& config) override;
+    bool connect() override;
+    void disconnect() override;
+    bool is_connected() const override { return connected_.load(); }
+
+    // ========== Market Data ==========
+    bool subscribe_orderbook(const std::string& symbol, int depth = 20) override;
+    bool subscribe_trades(const std::string& symbol) override;
+    bool unsubscribe(const std::string& symbol) override;
+    bool subscribe_user_data() override { return true; }
+
+    std::optional<OrderBook> get_orderbook(const std::string& symbol, int limit = 20) override;
+    std::optional<double> get_current_price(const std::string& symbol) override;
+    std::optional<std::string> get_exchange_info() override;
+
+    // ========== Order Management ==========
+    std::optional<Order> place_limit_order(
+        const std::string& symbol,
+        OrderSide side,
+        double price,
+        double quantity,
+        const std::string& client_order_id = "",
+        bool post_only = false
+    ) override;
+
+    std::optional<Order> place_market_order(
+        const std::string& symbol,
+        OrderSide side,
+        double quantity,
+        const std::string& client_order_id = ""
+    ) override;
+
+    std::optional<bool> cancel_order(const std::string& symbol, const std::string& order_id) override;
+    std::optional<bool> cancel_all_orders(const std::string& symbol) override;
+
+    std::optional<Order> modify_order(
+        const std::string& symbol,
+        const std::string& order_id,
+        double new_price,
+        double new_quantity
+    ) override;
+
+    std::optional<std::vector<Order>> get_open_orders(const std::string& symbol) override;
+    std::optional<Order> get_order_status(const std::string& symbol, const std::string& order_id) override;
+
+    // ========== Account Information ==========
+    std::optional<std::string> get_account_info() override;
+    std::optional<double> get_balance(const std::string& asset) override;
+
+    // ========== Event Handlers ==========
+    void set_orderbook_handler(OrderbookHandler handler) override { orderbook_handler_ = handler; }
+    void set_message_handler(MessageHandler handler) override { message_handler_ = handler; }
+    void set_connection_handler(ConnectionHandler handler) override { connection_handler_ = handler; }
+
+    // ========== Utility Methods ==========
+    std::string get_exchange_name() const override { return name_; }
+    bool supports_websocket_trading() const override { return false; }
+    bool get_symbol_info(const std::string& symbol, int& price_precision, int& quantity_precision) override;
+
+    double format_price(double price, const std::string& symbol) override;
+    double format_quantity(double quantity, const std::string& symbol) override;
+
+    double get_min_order_size(const std::string& symbol) override { (void)symbol; return step_size_; }
+    double get_max_order_size(const std::string& symbol) override { (void)symbol; return 1e9; }
+    double get_tick_size(const std::string& symbol) override { (void)symbol; return tick_size_; }
+
+private:
+    std::string name_;
+    std::atomic<bool> connected_{false};
+    double tick_size_ = 0.01;
+    double step_size_ = 0.001;
+
+    mutable std::mutex mutex_;
+    OrderBook book_;
+    std::map<std::string, Order> orders_;        // Resting, by order id
+    std::map<std::string, double> balances_;
+    std::vector<ExecutionReport> pending_reports_;  // Fills on arrival, sent with the next book
+    uint64_t next_order_id_ = 1;
+
+    // Replay feed
+    std::unique_ptr<BookStoreReader> replay_reader_;
+    std::thread replay_thread_;
+    std::atomic<bool> replaying_{false};
+
+    bool crosses(const Order& order) const;
+    double touch_price(OrderSide side) const;  // mutex_ held, the side's order crosses
+    static ExecutionReport fill_report(const Order& order, double price,
+                                       std::chrono::steady_clock::time_point received_time);
+    void run_replay(int depth);
+    void stop_replay();
+};
+
+} // namespace MarketMaker
+
+#endif // MOCK_EXCHANGE_H
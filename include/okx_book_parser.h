@@ -0,0 +1,33 @@
+#ifndef OKX_BOOK_PARSER_H
+#define OKX_BOOK_PARSER_H
+
+#include "types.h"
+#include <optional>
+#include <string>
+
+namespace Json {
+class Value;
+}
+
+namespace MarketMaker {
+
+// OKX v5 order book payloads, kept apart from the connection so they can be
+// checked against recorded messages offline.
+class OkxBookParser {
+public:
+    // Public WebSocket push (books5, bbo-tbt):
+    //   {"arg":{"channel":"books5","instId":"BTC-USDT"},"data":[{"asks":[...],"bids":[...],"ts":"..."}]}
+    // nullopt for subscription events and anything without levels; an error
+    // event's "code: msg" goes to *error.
+    static std::optional<OrderBook> parse_push(const std::string& message, std::string* error = nullptr);
+
+    // REST /api/v5/market/books response: {"code":"0","msg":"","data":[{...}]}
+    static std::optional<OrderBook> parse_rest(const std::string& response);
+
+    // One data entry; levels are [price, size, "0", order count] as strings
+    static bool parse_book(const Json::Value& data, OrderBook& book);
+};
+
+} // namespace MarketMaker
+
+#endif // OKX_BOOK_PARSER_H
@@ -0,0 +1,119 @@
+#ifndef OKX_EXCHANGE_H
+#define OKX_EXCHANGE_H
+
+#include "exchange_interface.h"
+#include "websocket_client.h"
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <map>
+
+namespace MarketMaker {
+
+// OKX public market data (v5 API): order book over the public WebSocket and
+// REST snapshots/instrument info. Used as a reference venue for fair value,
+// so order entry and account queries are not implemented and fail cleanly.
+class OkxExchange : public IExchange {
+public:
+    OkxExchange();
+    ~OkxExchange() override;
+
+    // ========== Connection Management ==========
+    bool initialize(const ExchangeConfig& config) override;
+    bool connect() override;
+    void disconnect() override;
+    bool is_connected() const override;
+
+    // ========== Market Data ==========
+    // depth 1 streams every top-of-book change (bbo-tbt), otherwise 5 levels (books5)
+    bool subscribe_orderbook(const std::string& symbol, int depth = 20) override;
+    bool subscribe_trades(const std::string& symbol) override;
+    bool unsubscribe(const std::string& symbol) override;
+
+    std::optional<OrderBook> get_orderbook(const std::string& symbol, int limit = 20) override;
+    std::optional<double> get_current_price(const std::string& symbol) override;
+    std::optional<std::string> get_exchange_info() override;
+
+    // ========== Order Management (not supported) ==========
+    std::optional<Order> place_limit_order(
+        const std::string& symbol,
+        OrderSide side,
+        double price,
+        double quantity,
+        const std::string& client_order_id = "",
+        bool post_only = false
+    ) override;
+
+    std::optional<Order> place_market_order(
+        const std::string& symbol,
+        OrderSide side,
+        double quantity,
+        const std::string& client_order_id = ""
+    ) override;
+
+    std::optional<bool> cancel_order(const std::string& symbol, const std::string& order_id) override;
+    std::optional<bool> cancel_all_orders(const std::string& symbol) override;
+
+    std::optional<Order> modify_order(
+        const std::string& symbol,
+        const std::string& order_id,
+        double new_price,
+        double new_quantity
+    ) override;
+
+    std::optional<std::vector<Order>> get_open_orders(const std::string& symbol) override;
+    std::optional<Order> get_order_status(const std::string& symbol, const std::string& order_id) override;
+
+    // ========== Account Information (not supported) ==========
+    std::optional<std::string> get_account_info() override;
+    std::optional<double> get_balance(const std::string& asset) override;
+
+    // ========== Event Handlers ==========
+    void set_orderbook_handler(OrderbookHandler handler) override;
+    void set_message_handler(MessageHandler handler) override;
+    void set_connection_handler(ConnectionHandler handler) override;
+
+    // ========== Utility Methods ==========
+    std::string get_exchange_name() const override { return "OKX"; }
+    bool supports_websocket_trading() const override { return false; }
+
+    bool get_symbol_info(const std::string& symbol, int& price_precision, int& quantity_precision) override;
+
+    double format_price(double price, const std::string& symbol) override;
+    double format_quantity(double quantity, const std::string& symbol) override;
+
+    double get_min_order_size(const std::string& symbol) override;
+    double get_max_order_size(const std::string& symbol) override;
+    double get_tick_size(const std::string& symbol) override;
+
+    // "BTCUSDT" / "BTC/USDT" -> "BTC-USDT"
+    std::string convert_symbol_to_okx(const std::string& symbol) const;
+
+private:
+    std::shared_ptr<WebSocketClient> ws_client_;
+    std::atomic<bool> ws_connected_{false};
+
+    // Instrument info from /api/v5/public/instruments
+    struct InstrumentInfo {
+        double tick_size = 0.0;
+        double lot_size = 0.0;
+        double min_size = 0.0;
+        double max_size = 0.0;
+    };
+    std::map<std::string, InstrumentInfo> instruments_;
+    std::mutex instruments_mutex_;
+
+    // Subscription, resent on every (re)connect
+    std::string subscribed_inst_;
+    std::string subscribed_channel_;
+
+    std::vector<std::string> quote_currencies_ = {"USDT", "USDC", "BTC", "ETH"};
+
+    void handle_websocket_message(const std::string& message);
+    std::optional<std::string> http_get(const std::string& path);
+    std::optional<InstrumentInfo> get_instrument(const std::string& inst_id);
+};
+
+} // namespace MarketMaker
+
+#endif // OKX_EXCHANGE_H
@@ -0,0 +1,89 @@
+#ifndef ORDER_ERRORS_H
+#define ORDER_ERRORS_H
+
+#include "types.h"
+#include <string>
+#include <map>
+#include <mutex>
+#include <functional>
+#include <cstdint>
+
+namespace MarketMaker {
+
+// Automatic response to an exchange error code
+enum class OrderErrorAction {
+    NONE,
+    PAUSE_ALL,      // Hold every request class (request weight / IP limits)
+    PAUSE_ORDERS,   // Hold new orders and replaces, cancels still go out
+    RESYNC_CLOCK,   // Re-measure the exchange clock offset
+    DISABLE_SIDE    // Stop quoting the side that failed
+};
+
+struct ErrorPolicy {
+    OrderErrorAction action = OrderErrorAction::NONE;
+    std::string match;  // Only applies if the message contains this (case-insensitive), empty = always
+};
+
+// One rejected request, from either transport
+struct OrderError {
+    std::string symbol;
+    bool has_side = false;
+    OrderSide side = OrderSide::BUY;
+    int code = 0;
+    std::string message;
+    int64_t retry_after_ms = 0;     // Exchange epoch ms when retrying is allowed, 0 if not given
+    const char* transport = "";     // "REST" or "WS"
+};
+
+// Counts exchange errors per code and per symbol, and hands errors that have a
+// policy to the registered action handler (OrderManager applies them). Both
+// transports report here, so the handler sees the same errors either way.
+class OrderErrorTracker {
+public:
+    using ActionHandler = std::function<void(const OrderError&, OrderErrorAction)>;
+
+    struct Stats {
+        uint64_t total = 0;
+        std::map<int, uint64_t> by_code;
+        std::map<std::string, std::map<int, uint64_t>> by_symbol;  // symbol -> code -> count
+        int last_code = 0;
+        std::string last_message;
+        uint64_t post_only_rejects = 0;  // Post-only orders rejected because they would have crossed
+    };
+
+    static OrderErrorTracker& instance() {
+        static OrderErrorTracker instance;
+        return instance;
+    }
+
+    void record(const OrderError& error);
+
+    // Replace the policy for a code (NONE removes the automatic response)
+    void set_policy(int code, const ErrorPolicy& policy);
+    void set_action_handler(ActionHandler handler);
+
+    Stats get_stats() const;
+    void reset_stats();
+    void log_status() const;
+
+    static OrderErrorAction parse_action(const std::string& name);
+    static const char* action_name(OrderErrorAction action);
+
+    // "... IP banned until 1700000000000." -> 1700000000000, 0 if absent
+    static int64_t parse_banned_until(const std::string& message);
+
+    // Binance -2010 "Order would immediately match and take." on a LIMIT_MAKER
+    static bool is_post_only_reject(const OrderError& error);
+
+private:
+    OrderErrorTracker();
+
+    mutable std::mutex mutex_;
+    std::map<int, ErrorPolicy> policies_;
+    ActionHandler handler_;
+    Stats stats_;
+};
+
+} // namespace MarketMaker
+
+#endif // ORDER_ERRORS_H
@@ -4,6 +4,15 @@
 #include "types.h"
 #include "config.h"
 #include "exchange_interface.h"
+#include "order_scheduler.h"
+#include "order_errors.h"
+#include "latency_histogram.h"
+#include "queue_position.h"
+#include "quote_placement.h"
+#include "quote_cache.h"
+#include "parameter_store.h"
+#include "latency_slo.h"
+#include "decision_journal.h"
 #include <memory>
 #include <mutex>
 #include <atomic>
@@ -11,6 +20,7 @@
 #include <chrono>
 #include <future>
 #include <thread>
+#include <optional>
 
 namespace MarketMaker {
 
@@ -26,12 +36,40 @@ public:
     bool update_orders_if_needed(double new_mid_price);
     bool update_orders_if_needed(double new_mid_price, const std::chrono::steady_clock::time_point& orderbook_time);
 
+    // Fill path (strategy thread): track inventory and, when one of our quotes
+    // is completely filled, requote that side at once. Bypasses
+    // order_update_cooldown, limited per side by fill_requote_cooldown.
+    bool on_execution(const ExecutionReport& report, double mid_price);
+
+    // Book updates (any thread): queue position of our quotes and the top of
+    // book post-only prices are kept behind
+    void on_orderbook(const OrderBook& book);
+    std::optional<QueueEstimate> get_queue_estimate(OrderSide side) const { return queue_.get(side); }
+
+    // Idle time on the strategy thread: precompute quotes for the mids
+    // around this one (see QuoteCache)
+    void precompute_quotes(double mid_price);
+
+    // Hot-reloadable strategy parameters (spread, size, cooldowns, ...)
+    ParameterStore& parameters() { return params_; }
+
+    // Strategy thread, every loop: re-evaluate feed/ack latency against the
+    // SLOs; pulls the quotes when the controller says so
+    void check_latency_slo();
+    // Any thread: an order-path round trip measured by the LatencyProber;
+    // every one queued is fed to the SLO controller on the next check
+    void on_probe_rtt(int64_t rtt_us);
+    SloLevel get_slo_level() const { return slo_.level(); }
+
     // Get current orders
     std::pair<std::shared_ptr<Order>, std::shared_ptr<Order>> get_active_orders() const;
 
     // Metrics
     LatencyMetrics get_metrics() const;
     void reset_metrics();
+    OrderScheduler::Stats get_scheduler_stats() const;
+    const LatencyHistograms& get_histograms() const { return histograms_; }
+    double get_inventory() const { return inventory_.load(); }
 
     // Price formatting
     double format_price(double price) const;
@@ -40,21 +78,97 @@ public:
 private:
     std::shared_ptr<IExchange> exchange_;
     Config config_;
+    ParameterStore params_;  // Read once per tick; overrides the matching config_ fields
+    std::unique_ptr<OrderScheduler> scheduler_;  // All order traffic goes through here
+
+    // Exchange filters for config_.symbol; orders are checked locally before sending
+    std::optional<ExchangeFilters> filters_;
+    std::atomic<uint64_t> filter_adjusted_{0};
+    std::atomic<uint64_t> filter_rejected_{0};
+
+    // Latest local top of book; post-only quotes are clamped one tick behind
+    // the opposite touch so they never cross
+    std::atomic<double> best_bid_{0.0};
+    std::atomic<double> best_ask_{0.0};
+    std::atomic<uint64_t> post_only_clamped_{0};
+
+    // Book-aware quote placement, fed by on_orderbook
+    QuotePlacer placer_;
+    std::mutex placer_mutex_;
+
+    // Quotes for nearby mids (strategy thread only); the generation changes
+    // whenever something besides the mid moves the quotes
+    QuoteCache quote_cache_;
+    uint64_t quote_generation_ = 0;
+
+    // Scales spread and size back while we react slowly (strategy thread only)
+    LatencySloController slo_;
+    // Probe round trips not yet fed to slo_ (one probe round spans connections
+    // and shards, so several arrive at once)
+    static constexpr size_t MAX_PENDING_PROBES = 1024;
+    std::mutex probe_mutex_;
+    std::vector<int64_t> probe_samples_;
+    std::vector<int64_t> probe_drain_;  // Strategy thread only
+
+    // Error policies: sides switched off until a steady_clock time (ns since
+    // epoch, 0 = enabled), and the in-flight clock resync
+    std::atomic<int64_t> side_disabled_until_[2]{};  // Indexed by OrderSide
+    std::mutex clock_resync_mutex_;
+    std::future<void> clock_resync_;
 
     mutable std::mutex orders_mutex_;
     std::shared_ptr<Order> active_bid_order_;
     std::shared_ptr<Order> active_ask_order_;
 
+    // Queue ahead of each resting quote; lets the requote planner keep quotes
+    // that are close to filling
+    QueuePositionEstimator queue_;
+
     std::atomic<double> last_mid_price_{0.0};
     std::chrono::steady_clock::time_point last_order_update_;
 
     LatencyMetrics metrics_;
     mutable std::mutex metrics_mutex_;
+    LatencyHistograms histograms_;
+
+    // Net base-asset position from fills since start
+    std::atomic<double> inventory_{0.0};
+    std::chrono::steady_clock::time_point last_fill_requote_[2]{};  // Indexed by OrderSide
+
+    // Every quote decision with a hash of its inputs, for replay diffs
+    DecisionJournal journal_;
 
     // Helper methods
-    bool place_order(OrderSide side, double price, double quantity);
-    bool cancel_order(const std::shared_ptr<Order>& order);
-    bool should_update_orders(double new_mid_price) const;
+    bool place_market_maker_orders(double mid_price, const std::chrono::steady_clock::time_point& orderbook_time,
+                                   const StrategyParams& params);
+    std::future<OrderScheduler::OrderResult> submit_order(OrderSide side, double price, double quantity,
+                                                         double reference_price);
+    bool handle_order_result(OrderSide side, double price, double quantity,
+                             const OrderScheduler::OrderResult& result);
+    std::future<OrderScheduler::CancelResult> submit_cancel(const std::shared_ptr<Order>& order);
+    bool handle_cancel_result(const std::shared_ptr<Order>& order,
+                              const OrderScheduler::CancelResult& result);
+    // Ack latency of requests that reached the exchange, for the SLO
+    void record_ack(const OrderScheduler::OrderResult& result);
+    // SLO pull from the strategy (or feed) thread: waits 100ms at most per cancel
+    void pull_quotes();
+    PreparedQuote prepare_quote(OrderSide side, double target_price, double mid_price,
+                                const StrategyParams& params) const;
+    std::future<OrderScheduler::OrderResult> submit_prepared(OrderSide side, const PreparedQuote& quote,
+                                                            double mid_price);
+    double place_quote(OrderSide side, double target_price, const StrategyParams& params);
+    double clamp_to_maker(OrderSide side, double price);
+    double tick_size() const;
+    bool should_keep_quote(const std::shared_ptr<Order>& order, double target_price, double mid_price,
+                           const StrategyParams& params) const;
+    double inventory_shift(double mid_price, const StrategyParams& params) const;
+    StrategyParams effective_params() const;
+    uint64_t quote_generation(const StrategyParams& params) const;
+    void apply_error_action(const OrderError& error, OrderErrorAction action);
+    void journal_decision(JournalAction action, uint16_t reasons, double mid_price, const StrategyParams& params,
+                          double bid_price, double ask_price);
+    bool is_side_enabled(OrderSide side) const;
+    bool should_update_orders(double new_mid_price, const StrategyParams& params) const;
     void update_metrics(const std::chrono::steady_clock::time_point& start_time,
                        const std::chrono::steady_clock::time_point& orderbook_time);
     std::string generate_client_order_id(OrderSide side);
@@ -0,0 +1,146 @@
+#ifndef ORDER_SCHEDULER_H
+#define ORDER_SCHEDULER_H
+
+#include "types.h"
+#include "exchange_interface.h"
+#include <memory>
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <atomic>
+#include <chrono>
+#include <optional>
+
+namespace MarketMaker {
+
+// Outbound order queue in front of IExchange (and so of every transport).
+//
+// Requests are drained strictly by class: cancels, then replaces, then new
+// orders. A class only goes out when OrderRateLimiter has budget for it; while
+// a higher class is queued, lower classes wait, so a protective cancel is never
+// stuck behind new orders. A new order still queued when a fresher one for the
+// same symbol and side arrives is dropped (superseded), as is a queued replace
+// of the same order.
+//
+// With zero worker threads requests are sent inline on the submitting thread,
+// which never waits: a new order or replace that can't go out right away
+// (paused, throttled, or behind a throttled cancel) resolves as DROPPED and the
+// next tick quotes again. Cancels that can't go are left to one deferred
+// worker, started on first need, which sends them once budget allows and
+// never takes a replace or new order.
+class OrderScheduler {
+public:
+    enum class Priority {
+        CANCEL = 0,
+        REPLACE = 1,
+        NEW = 2
+    };
+
+    enum class Outcome {
+        SENT,        // Exchange accepted the request
+        FAILED,      // Exchange rejected it or the transport failed
+        SUPERSEDED,  // Replaced by a fresher request before it was sent
+        DROPPED      // Not sent: scheduler stopped, or held back in inline mode
+    };
+
+    struct OrderResult {
+        Outcome outcome = Outcome::DROPPED;
+        std::optional<Order> order;
+        int64_t ack_us = -1;  // Submission to the exchange's answer; -1 if never sent
+    };
+
+    struct CancelResult {
+        Outcome outcome = Outcome::DROPPED;
+    };
+
+    struct Stats {
+        uint64_t submitted[3] = {0, 0, 0};   // Indexed by Priority
+        uint64_t dispatched[3] = {0, 0, 0};
+        uint64_t superseded = 0;
+        uint64_t budget_waits = 0;           // Times the head request waited for rate budget
+        uint64_t held_back = 0;              // Inline mode: orders dropped instead of waiting
+        size_t queued[3] = {0, 0, 0};
+        int64_t max_queue_delay_us = 0;
+    };
+
+    OrderScheduler(std::shared_ptr<IExchange> exchange, int worker_threads = 2);
+    ~OrderScheduler();
+
+    OrderScheduler(const OrderScheduler&) = delete;
+    OrderScheduler& operator=(const OrderScheduler&) = delete;
+
+    std::future<CancelResult> submit_cancel(const std::string& symbol, const std::string& order_id);
+
+    std::future<OrderResult> submit_replace(
+        const std::string& symbol,
+        const std::string& order_id,
+        OrderSide side,
+        double price,
+        double quantity
+    );
+
+    std::future<OrderResult> submit_new(
+        const std::string& symbol,
+        OrderSide side,
+        double price,
+        double quantity,
+        const std::string& client_order_id = "",
+        bool post_only = false
+    );
+
+    // Hold the given class and every lower one until the given time (e.g. after
+    // an exchange rate-limit error); the default holds everything
+    void pause_until(std::chrono::steady_clock::time_point until, Priority from = Priority::CANCEL);
+
+    // Stop the workers; queued requests resolve as DROPPED
+    void stop();
+
+    Stats get_stats() const;
+
+private:
+    struct Request {
+        Priority priority;
+        std::string symbol;
+        std::string order_id;          // CANCEL / REPLACE
+        std::string client_order_id;   // NEW
+        OrderSide side = OrderSide::BUY;
+        double price = 0.0;
+        double quantity = 0.0;
+        bool post_only = false;        // NEW
+        std::chrono::steady_clock::time_point enqueued;
+        std::promise<OrderResult> order_promise;
+        std::promise<CancelResult> cancel_promise;
+    };
+    using RequestPtr = std::shared_ptr<Request>;
+
+    std::shared_ptr<IExchange> exchange_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<RequestPtr> queues_[3];
+    std::chrono::steady_clock::time_point paused_until_[3]{};  // Indexed by Priority
+    bool running_ = true;
+    Stats stats_;
+
+    std::vector<std::thread> workers_;
+    std::thread deferred_;  // Inline mode: sends held-back cancels
+
+    void run_worker();
+    void run_deferred();
+    void drain_inline();
+    void enqueue(const RequestPtr& request);
+    void dispatch(const RequestPtr& request);
+    void send(const RequestPtr& request);
+    static void resolve(const RequestPtr& request, Outcome outcome);
+
+    // Called with mutex_ held: next request of class lowest or above whose
+    // budget is available, or nullptr and how long to wait before checking again
+    RequestPtr take_next(std::chrono::steady_clock::duration& wait, Priority lowest = Priority::NEW);
+};
+
+} // namespace MarketMaker
+
+#endif // ORDER_SCHEDULER_H
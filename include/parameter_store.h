@@ -0,0 +1,78 @@
+#ifndef PARAMETER_STORE_H
+#define PARAMETER_STORE_H
+
+#include "config.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdint>
+
+namespace MarketMaker {
+
+// Strategy parameters that can change without a restart
+struct StrategyParams {
+    double spread_percentage = 0.02;
+    double order_size = 0.001;
+    std::chrono::milliseconds order_update_cooldown{100};
+    std::chrono::milliseconds fill_requote_cooldown{50};
+    double inventory_skew = 0.0001;
+    double queue_keep_max_ahead = 1.0;
+    double queue_keep_max_drift = 0.0005;
+
+    uint64_t version = 0;  // Set by ParameterStore::publish
+
+    static StrategyParams from_config(const Config& config);
+
+    // Empty if valid, otherwise what is wrong
+    std::string validate() const;
+};
+
+// Immutable StrategyParams snapshots behind an atomic pointer (RCU style).
+//
+// Readers do a single acquire load and use the snapshot for the whole tick,
+// with no lock and no reference counting. publish() validates, installs a
+// new snapshot and keeps the old ones alive until the store is destroyed, so
+// a reader can never see a snapshot freed under it; reloads are rare enough
+// that this costs nothing.
+//
+// watch_file() reloads from the config file whenever it is written or
+// replaced (inotify on its directory, so editors that save via rename are
+// seen too). Only the StrategyParams fields are taken from the new file.
+class ParameterStore {
+public:
+    explicit ParameterStore(const StrategyParams& initial);
+    ~ParameterStore();
+
+    ParameterStore(const ParameterStore&) = delete;
+    ParameterStore& operator=(const ParameterStore&) = delete;
+
+    const StrategyParams& get() const { return *current_.load(std::memory_order_acquire); }
+
+    // Validate and swap in; false (and the current snapshot kept) if invalid
+    bool publish(StrategyParams params, std::string& error);
+
+    bool watch_file(const std::string& path);
+    void stop();
+
+private:
+    std::atomic<const StrategyParams*> current_;
+    std::vector<std::unique_ptr<const StrategyParams>> snapshots_;  // Every published snapshot
+    std::mutex publish_mutex_;
+
+    std::string path_;
+    int inotify_fd_ = -1;
+    std::atomic<bool> watching_{false};
+    std::thread watch_thread_;
+
+    void run_watcher(std::string filename);
+    void reload();
+};
+
+} // namespace MarketMaker
+
+#endif // PARAMETER_STORE_H
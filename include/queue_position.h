@@ -0,0 +1,68 @@
+#ifndef QUEUE_POSITION_H
+#define QUEUE_POSITION_H
+
+#include "types.h"
+#include <string>
+#include <optional>
+#include <mutex>
+
+namespace MarketMaker {
+
+// Estimated place in the price-time queue of one resting quote
+struct QueueEstimate {
+    std::string order_id;
+    double price = 0.0;
+    double remaining = 0.0;     // Our unfilled quantity
+    double ahead = 0.0;         // Quantity estimated to trade before us
+    double level_qty = 0.0;     // Visible quantity at our price in the last book
+    bool at_touch = false;      // Our price is the best price on our side
+};
+
+// Tracks the queue ahead of our bid and ask.
+//
+// When an order is acked the whole visible quantity at its price (passed in by
+// the caller, which holds the book) is assumed to be ahead of it. If the
+// caller's book doesn't reach that deep, the order has no estimate until a
+// book update shows its level. After that, every book update compares the
+// level with the previous one:
+//   - at the touch a decrease is taken as trades, which come off the front;
+//   - behind the touch a decrease is taken as cancels, split pro rata between
+//     the quantity ahead of us and behind us;
+//   - increases join behind us;
+//   - a level that emptied or that the market traded through leaves us first.
+// Any fill of ours also means nothing is left ahead.
+//
+// Each book update costs one level lookup per tracked order: the index the
+// level was at last time and its neighbours, then a binary search. No copy of
+// the book is kept.
+class QueuePositionEstimator {
+public:
+    // level_qty: visible quantity at price when acked, nullopt if unknown;
+    // at_touch: nothing better on our side
+    void on_order_acked(OrderSide side, const std::string& order_id, double price, double quantity,
+                        std::optional<double> level_qty, bool at_touch);
+    void on_order_removed(OrderSide side, const std::string& order_id = "");
+    void on_fill(OrderSide side, const std::string& order_id, double remaining);
+    void on_book(const OrderBook& book);
+
+    std::optional<QueueEstimate> get(OrderSide side) const;
+
+private:
+    struct Tracked {
+        bool active = false;
+        bool seeded = false;    // Queue ahead known (at ack or from a later book)
+        QueueEstimate estimate;
+        size_t level_hint = 0;  // Index the level was found at last time
+    };
+
+    mutable std::mutex mutex_;
+    Tracked orders_[2];         // Indexed by OrderSide
+
+    void update(Tracked& tracked, const std::vector<PriceLevel>& levels, bool is_bid);
+    static std::optional<size_t> find_level(const std::vector<PriceLevel>& levels, double price,
+                                            bool is_bid, size_t hint);
+};
+
+} // namespace MarketMaker
+
+#endif // QUEUE_POSITION_H
@@ -0,0 +1,72 @@
+#ifndef QUOTE_CACHE_H
+#define QUOTE_CACHE_H
+
+#include <vector>
+#include <functional>
+#include <cstdint>
+
+namespace MarketMaker {
+
+// One side of a quote, priced, formatted and run through the exchange filters
+struct PreparedQuote {
+    bool sendable = false;  // False if the filters would reject it
+    double price = 0.0;
+    double quantity = 0.0;
+};
+
+struct QuoteSet {
+    PreparedQuote bid;
+    PreparedQuote ask;
+};
+
+// Quotes for the mids around the current one, built by the strategy thread
+// while it is idle. The mid of a book is always on the half-tick grid, so the
+// table holds one QuoteSet per half tick within +/- ticks_each_side ticks; a
+// book update landing on one of them needs a lookup instead of pricing.
+//
+// Anything else the quotes depend on (inventory, config) is folded into a
+// generation number; a lookup with a different generation misses.
+//
+// Not thread-safe: strategy thread only.
+class QuoteCache {
+public:
+    using Builder = std::function<QuoteSet(double mid_price)>;
+
+    explicit QuoteCache(int ticks_each_side = 0, double tick_size = 0.01);
+
+    bool enabled() const { return ticks_each_side_ > 0 && tick_size_ > 0; }
+
+    // Rebuild around mid_price unless the table is already centred there for
+    // this generation
+    void prepare(double mid_price, uint64_t generation, const Builder& builder);
+
+    // nullptr on a miss (off the table, off the grid or stale generation)
+    const QuoteSet* lookup(double mid_price, uint64_t generation);
+
+    void invalidate() { built_ = false; }
+
+    uint64_t hits() const { return hits_; }
+    uint64_t misses() const { return misses_; }
+    uint64_t rebuilds() const { return rebuilds_; }
+
+private:
+    int ticks_each_side_;
+    double tick_size_;
+
+    std::vector<QuoteSet> table_;
+    int64_t first_key_ = 0;     // Half-tick key of table_[0]
+    int64_t center_key_ = 0;
+    uint64_t generation_ = 0;
+    bool built_ = false;
+
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+    uint64_t rebuilds_ = 0;
+
+    // Mid in half ticks; false if the mid isn't on the half-tick grid
+    bool to_key(double mid_price, int64_t& key) const;
+};
+
+} // namespace MarketMaker
+
+#endif // QUOTE_CACHE_H
@@ -0,0 +1,77 @@
+#ifndef QUOTE_PLACEMENT_H
+#define QUOTE_PLACEMENT_H
+
+#include "types.h"
+#include <string>
+#include <cstdint>
+#include <optional>
+
+namespace MarketMaker {
+
+enum class PlacementMode {
+    SPREAD,     // Target price as is (percentage of mid)
+    JOIN,       // Join the best level at or behind the target
+    IMPROVE,    // One tick better than that level when the spread is wide enough
+    BACK_OFF    // One tick behind the first level holding at least wall_size quotes
+};
+
+struct PlacementParams {
+    PlacementMode mode = PlacementMode::SPREAD;
+    int depth = 10;                  // Book levels scanned per side
+    int improve_min_spread_ticks = 3; // IMPROVE only when the touch spread is at least this wide
+    double wall_size = 0.0;          // BACK_OFF: size that counts as a wall, in multiples of the quote size
+};
+
+// Picks a quote price from the local book, in integer ticks.
+//
+// The target price (spread around mid, inventory skew) is the most aggressive
+// price allowed; the mode only decides where behind it to sit. set_book()
+// converts the top levels once per update into fixed-size tick/size arrays
+// with asks negated, so both sides are searched as "higher is better" by the
+// same branch-free loops, which the compiler vectorizes.
+//
+// Not thread-safe: the caller serializes set_book() and place().
+class QuotePlacer {
+public:
+    static constexpr int MAX_DEPTH = 32;
+
+    QuotePlacer(double tick_size = 0.01, const PlacementParams& params = {});
+
+    void set_tick_size(double tick_size) { tick_size_ = tick_size; }
+    double tick_size() const { return tick_size_; }
+    const PlacementParams& params() const { return params_; }
+
+    void set_book(const OrderBook& book);
+
+    // Price for a quote of quote_size whose target is target_ticks, in ticks
+    int64_t place(OrderSide side, int64_t target_ticks, double quote_size) const;
+
+    // Visible quantity at a price on one side (0 if the book shows no such
+    // level, nullopt if the price is deeper than the levels kept), and whether
+    // nothing on that side is better; seeds the queue of new quotes
+    std::optional<double> quantity_at(OrderSide side, int64_t ticks) const;
+    bool at_touch(OrderSide side, int64_t ticks) const;
+
+    int64_t to_ticks(double price) const;
+    double to_price(int64_t ticks) const { return ticks * tick_size_; }
+
+    static PlacementMode parse_mode(const std::string& name);
+    static const char* mode_name(PlacementMode mode);
+
+private:
+    struct Side {
+        alignas(64) int64_t ticks[MAX_DEPTH];  // Bids as is, asks negated; padded with INT64_MIN
+        alignas(64) double sizes[MAX_DEPTH];
+        int levels = 0;
+    };
+
+    double tick_size_;
+    PlacementParams params_;
+    Side sides_[2];  // Indexed by OrderSide
+
+    void load_side(Side& side, const std::vector<PriceLevel>& levels, bool negate);
+};
+
+} // namespace MarketMaker
+
+#endif // QUOTE_PLACEMENT_H
@@ -5,25 +5,42 @@
 #include <deque>
 #include <mutex>
 #include <atomic>
+#include <memory>
+#include <string>
+#include "shared_rate_limiter.h"
 
 namespace MarketMaker {
 
+// Sliding-window limiter: at most burst_size requests in any second and
+// max_requests_per_second on average over 10 seconds (Binance counts ORDERS
+// per 10s window)
 class RateLimiter {
 public:
     RateLimiter(int max_requests_per_second = 10, int burst_size = 20);
 
+    // Change the limits at runtime
+    void configure(int max_requests_per_second, int burst_size);
+
     // Check if we can make a request
     bool can_request();
 
+    // How long until can_request() turns true (zero if it already is)
+    std::chrono::milliseconds time_until_available();
+
     // Wait until we can make a request
     void wait_if_needed();
 
     // Record that a request was made
     void record_request();
 
+    // Check and record in one step, so concurrent callers can't overrun the
+    // limit; otherwise set wait and return false
+    bool try_acquire(std::chrono::milliseconds& wait);
+
     // Get current usage stats
     struct Stats {
         int requests_in_last_second;
+        int requests_in_rate_window;   // Last 10 s, the window the average limit applies to
         int requests_in_last_minute;
         double current_rate;
         bool is_limited;
@@ -35,10 +52,12 @@ public:
 
 private:
     void cleanup_old_requests();
+    std::chrono::milliseconds wait_locked() const;  // mutex_ held
 
-    const int max_requests_per_second_;
-    const int burst_size_;
-    const std::chrono::milliseconds window_size_{1000};
+    int max_requests_per_second_;
+    int burst_size_;
+    const std::chrono::seconds burst_window_{1};
+    const std::chrono::seconds rate_window_{10};
 
     mutable std::mutex mutex_;
     std::deque<std::chrono::steady_clock::time_point> request_times_;
@@ -65,6 +84,26 @@ public:
         order_limiter_.wait_if_needed();
     }
 
+    std::chrono::milliseconds time_until_order_slot() {
+        return order_limiter_.time_until_available();
+    }
+
+    std::chrono::milliseconds time_until_cancel_slot() {
+        return cancel_limiter_.time_until_available();
+    }
+
+    // Check and take a slot in one step (the scheduler's path); when the
+    // budget is shared this is what keeps processes from overrunning it
+    bool try_acquire_order_slot(std::chrono::milliseconds& wait);
+    bool try_acquire_cancel_slot(std::chrono::milliseconds& wait);
+
+    // Count orders and cancels against every process using the same API key
+    // (SharedRateLimiter). Call once at startup; false keeps local limits.
+    bool share_with_processes(const std::string& api_key, const std::string& label);
+
+    // Apply exchange limits from config (bursts default to twice the rate)
+    void configure(int orders_per_second, int cancels_per_second);
+
     void record_order_placed() {
         order_limiter_.record_request();
     }
@@ -82,6 +121,9 @@ private:
 
     RateLimiter order_limiter_;
     RateLimiter cancel_limiter_;
+    std::unique_ptr<SharedRateLimiter> shared_;
+    std::atomic<int> orders_per_second_{10};
+    std::atomic<int> cancels_per_second_{20};
 };
 
 } // namespace MarketMaker
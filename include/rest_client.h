@@ -2,6 +2,7 @@
 #define REST_CLIENT_H
 
 #include "types.h"
+#include "socket_options.h"
 #include <string>
 #include <memory>
 #include <optional>
@@ -18,17 +19,24 @@ public:
     // Set display assets for account info filtering
     void set_display_assets(const std::vector<std::string>& assets);
 
+    // Socket tuning applied to every new connection via CURLOPT_SOCKOPTFUNCTION
+    void set_socket_profile(const SocketProfile& profile);
+    AppliedSocketOptions get_socket_report() const;
+
     // Account endpoints
     std::string get_account_info();
     std::optional<std::vector<Order>> get_open_orders(const std::string& symbol);
 
-    // Order management
+    // Order management (post_only sends LIMIT_MAKER instead of LIMIT/GTC).
+    // With an ACK response the returned order is what we sent, status NEW.
     std::optional<Order> place_limit_order(
         const std::string& symbol,
         OrderSide side,
         double price,
         double quantity,
-        const std::string& client_order_id = ""
+        const std::string& client_order_id = "",
+        bool post_only = false,
+        OrderResponseType response_type = OrderResponseType::ACK
     );
 
     std::optional<bool> cancel_order(
@@ -73,6 +81,17 @@ public:
     // Market data
     std::optional<OrderBook> get_orderbook(const std::string& symbol, int limit = 20);
     std::optional<double> get_current_price(const std::string& symbol);
+    std::optional<int64_t> get_server_time();  // GET /api/v3/time, epoch ms
+
+    // Latency probes, round trip in microseconds (nullopt on failure):
+    // GET /api/v3/ping and a validated-but-not-sent POST /api/v3/order/test
+    std::optional<int64_t> ping();
+    std::optional<int64_t> test_order(const std::string& symbol, OrderSide side, double price,
+                                      double quantity, bool post_only);
+
+    // User data stream (API key only, not signed)
+    std::optional<std::string> create_listen_key();
+    bool keepalive_listen_key(const std::string& listen_key);
 
     // Exchange info
     std::optional<std::string> get_exchange_info();
@@ -95,6 +114,13 @@ private:
         const std::vector<std::pair<std::string, std::string>>& params = {}
     );
 
+    // Request carrying the API key header; query_string is sent as-is
+    std::optional<std::string> send_keyed_request(
+        const std::string& method,
+        const std::string& endpoint,
+        const std::string& query_string
+    );
+
     std::optional<std::string> send_public_request(
         const std::string& endpoint,
         const std::vector<std::pair<std::string, std::string>>& params = {}
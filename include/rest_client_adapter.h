@@ -41,8 +41,9 @@ public:
         OrderSide side,
         double price,
         double quantity,
-        const std::string& client_order_id = "") override {
-        return rest_client_->place_limit_order(symbol, side, price, quantity, client_order_id);
+        const std::string& client_order_id = "",
+        bool post_only = false) override {
+        return rest_client_->place_limit_order(symbol, side, price, quantity, client_order_id, post_only);
     }
 
     std::optional<Order> place_market_order(
@@ -93,6 +94,17 @@ public:
         return rest_client_->get_symbol_info(symbol, price_precision, quantity_precision);
     }
 
+    std::vector<LatencyProbe> probe_latency(const std::optional<ProbeOrder>& order) override {
+        std::vector<LatencyProbe> probes;
+        probes.push_back({"rest", "ping", rest_client_->ping().value_or(-1), 1});
+        if (order) {
+            auto rtt = rest_client_->test_order(order->symbol, order->side, order->price,
+                                                order->quantity, order->post_only);
+            probes.push_back({"rest", "order.test", rtt.value_or(-1), 1});
+        }
+        return probes;
+    }
+
     double format_price(double price, const std::string&) override { return price; }
     double format_quantity(double quantity, const std::string&) override { return quantity; }
     double get_min_order_size(const std::string&) override { return 0.00001; }
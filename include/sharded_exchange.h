@@ -0,0 +1,148 @@
+#ifndef SHARDED_EXCHANGE_H
+#define SHARDED_EXCHANGE_H
+
+#include "exchange_interface.h"
+#include "rate_limiter.h"
+#include "shared_rate_limiter.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace MarketMaker {
+
+// Order entry spread over several accounts (the main one plus sub-accounts),
+// each an exchange instance with its own sessions and order budget.
+//
+// Market data, symbol info and the clock come from the first (primary) shard.
+// New orders go to a shard picked by ShardPolicy among those with order budget
+// left; cancels and modifies follow the order to the shard that placed it. An
+// order that no eligible account has budget for fails rather than overrun one.
+// With a shared label each account's budget lives in its own shared-memory
+// segment (keyed on that account's API key), shared with other processes. Fills from every shard arrive on the
+// one execution handler, and balances are summed, so inventory and risk stay
+// aggregated above this layer.
+class ShardedExchange : public IExchange {
+public:
+    enum class ShardPolicy {
+        SIDE,   // Bids on even shards, asks on odd ones (one shard: both)
+        LOAD    // Shard with the fewest orders in the last 10 s
+    };
+
+    struct Shard {
+        std::string name;
+        std::shared_ptr<IExchange> exchange;
+    };
+
+    // orders_per_second: each account's own order limit; shared_label:
+    // non-empty to share each account's budget across processes
+    ShardedExchange(std::vector<Shard> shards, ShardPolicy policy, int orders_per_second,
+                    const std::vector<std::string>& api_keys = {}, const std::string& shared_label = "");
+
+    static ShardPolicy parse_policy(const std::string& name);
+
+    // ========== Connection Management ==========
+    bool initialize(const ExchangeConfig& config) override;
+    bool connect() override;
+    void disconnect() override;
+    bool is_connected() const override;
+
+    // ========== Market Data (primary shard) ==========
+    bool subscribe_orderbook(const std::string& symbol, int depth = 20) override;
+    bool subscribe_trades(const std::string& symbol) override;
+    bool unsubscribe(const std::string& symbol) override;
+    std::optional<OrderBook> get_orderbook(const std::string& symbol, int limit = 20) override;
+    std::optional<double> get_current_price(const std::string& symbol) override;
+    std::optional<std::string> get_exchange_info() override;
+    bool subscribe_user_data() override;
+
+    // ========== Order Management ==========
+    std::optional<Order> place_limit_order(
+        const std::string& symbol,
+        OrderSide side,
+        double price,
+        double quantity,
+        const std::string& client_order_id = "",
+        bool post_only = false
+    ) override;
+    std::optional<Order> place_market_order(
+        const std::string& symbol,
+        OrderSide side,
+        double quantity,
+        const std::string& client_order_id = ""
+    ) override;
+    std::optional<bool> cancel_order(const std::string& symbol, const std::string& order_id) override;
+    std::optional<bool> cancel_all_orders(const std::string& symbol) override;
+    std::optional<Order> modify_order(
+        const std::string& symbol,
+        const std::string& order_id,
+        double new_price,
+        double new_quantity
+    ) override;
+    std::optional<std::vector<Order>> get_open_orders(const std::string& symbol) override;
+    std::optional<Order> get_order_status(const std::string& symbol, const std::string& order_id) override;
+
+    // ========== Account Information (aggregated) ==========
+    std::optional<std::string> get_account_info() override;
+    std::optional<double> get_balance(const std::string& asset) override;
+
+    // ========== Event Handlers ==========
+    void set_orderbook_handler(OrderbookHandler handler) override;
+    void set_message_handler(MessageHandler handler) override;
+    void set_connection_handler(ConnectionHandler handler) override;
+    void set_execution_handler(ExecutionHandler handler) override;
+    void set_book_delta_handler(BookDeltaHandler handler) override;
+
+    // ========== Utility Methods (primary shard) ==========
+    std::string get_exchange_name() const override;
+    bool supports_websocket_trading() const override;
+    bool get_symbol_info(const std::string& symbol, int& price_precision, int& quantity_precision) override;
+    bool sync_clock() override;
+    std::optional<ExchangeFilters> get_symbol_filters(const std::string& symbol) override;
+    std::vector<LatencyProbe> probe_latency(const std::optional<ProbeOrder>& order) override;
+    double format_price(double price, const std::string& symbol) override;
+    double format_quantity(double quantity, const std::string& symbol) override;
+    double get_min_order_size(const std::string& symbol) override;
+    double get_max_order_size(const std::string& symbol) override;
+    double get_tick_size(const std::string& symbol) override;
+    std::chrono::milliseconds time_until_order_slot(OrderSide side) override;
+
+    // Orders placed per shard since start
+    std::vector<std::pair<std::string, uint64_t>> get_shard_order_counts() const;
+
+private:
+    struct ShardState {
+        Shard shard;
+        RateLimiter orders;               // This account's order budget (local count and stats)
+        std::unique_ptr<SharedRateLimiter> shared;  // Account-wide budget across processes
+        std::atomic<uint64_t> placed{0};
+
+        ShardState(Shard s, int per_second)
+            : shard(std::move(s)), orders(per_second, per_second * 2) {}
+    };
+
+    std::vector<std::unique_ptr<ShardState>> shards_;
+    ShardPolicy policy_;
+    int orders_per_second_;
+    std::atomic<uint64_t> next_[2]{};  // Rotation per side (SIDE policy)
+
+    // Which shard holds each live order
+    mutable std::mutex routes_mutex_;
+    std::unordered_map<std::string, size_t> routes_;
+
+    IExchange& primary() const { return *shards_.front()->shard.exchange; }
+    // Picks a shard for a new order and takes its budget; nullopt if none has any
+    std::optional<size_t> pick_shard(OrderSide side);
+    bool try_acquire(ShardState& state);
+    std::chrono::milliseconds time_until_slot(ShardState& state) const;
+    std::vector<size_t> side_shards(OrderSide side) const;
+    std::optional<size_t> route_of(const std::string& order_id) const;
+    void remember(const std::string& order_id, size_t shard);
+    void forget(const std::string& order_id);
+};
+
+} // namespace MarketMaker
+
+#endif // SHARDED_EXCHANGE_H
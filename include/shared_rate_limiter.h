@@ -0,0 +1,68 @@
+#ifndef SHARED_RATE_LIMITER_H
+#define SHARED_RATE_LIMITER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+
+namespace MarketMaker {
+
+// Order/cancel budget shared by every process trading with the same API key,
+// in a POSIX shared-memory segment named after a hash of the key.
+//
+// Each window is a ring of 100 ms buckets; a bucket is one atomic word
+// holding its bucket number and count, so a process claims a slot with a
+// single CAS and no lock is ever held across processes. A zero-filled
+// segment is a valid empty one, so no process has to initialize it.
+// Per-process totals are kept in a small table for attribution.
+class SharedRateLimiter {
+public:
+    enum class Kind {
+        ORDERS = 0,
+        CANCELS = 1
+    };
+
+    struct ProcessUsage {
+        int pid = 0;
+        std::string label;
+        uint64_t orders = 0;
+        uint64_t cancels = 0;
+    };
+
+    // Attach to (or create) the segment for api_key; nullptr if shared memory
+    // is unavailable or the segment has an incompatible layout
+    static std::unique_ptr<SharedRateLimiter> open(const std::string& api_key, const std::string& label);
+    ~SharedRateLimiter();
+
+    SharedRateLimiter(const SharedRateLimiter&) = delete;
+    SharedRateLimiter& operator=(const SharedRateLimiter&) = delete;
+
+    // Take a slot if the account-wide counts stay within per_second (averaged
+    // over 10 s) and burst (within 1 s); otherwise set wait and return false
+    bool try_acquire(Kind kind, int per_second, int burst, std::chrono::milliseconds& wait);
+
+    // Account-wide count within the last window
+    int count(Kind kind, std::chrono::milliseconds window) const;
+
+    std::vector<ProcessUsage> usage() const;
+    const std::string& name() const { return name_; }
+
+private:
+    struct Segment;
+
+    SharedRateLimiter(Segment* segment, std::string name, int slot);
+
+    Segment* segment_;
+    std::string name_;
+    int slot_;  // Our row in the process table, -1 if it was full
+
+    static int64_t now_bucket();
+    void release(Kind kind, int64_t bucket);
+    int64_t wait_for(Kind kind, int64_t bucket, int buckets, int limit) const;
+};
+
+} // namespace MarketMaker
+
+#endif // SHARED_RATE_LIMITER_H
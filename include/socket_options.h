@@ -0,0 +1,101 @@
+#ifndef SOCKET_OPTIONS_H
+#define SOCKET_OPTIONS_H
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <mutex>
+#include <future>
+#include <optional>
+#include <unordered_map>
+#include <sys/socket.h>
+
+namespace MarketMaker {
+
+// Kernel-level socket settings applied identically to every transport
+// (market-data WebSocket, WebSocket trading, REST via CURLOPT_SOCKOPTFUNCTION)
+struct SocketProfile {
+    bool tcp_nodelay = true;     // Disable Nagle
+    bool tcp_quickack = true;    // Ack immediately (re-armed after each read where possible)
+    int busy_poll_us = 0;        // SO_BUSY_POLL, 0 = off
+    int rcvbuf_bytes = 0;        // SO_RCVBUF, 0 = kernel default
+    int sndbuf_bytes = 0;        // SO_SNDBUF, 0 = kernel default
+    int ip_tos = 0;              // IP_TOS / IPV6_TCLASS, 0 = leave unset (e.g. 0x10 = low delay)
+    int io_timeout_ms = 10000;   // SO_RCVTIMEO / SO_SNDTIMEO, 0 = none
+};
+
+// Values read back from the kernel after a profile was applied
+struct AppliedSocketOptions {
+    int fd = -1;
+    int tcp_nodelay = -1;
+    int tcp_quickack = -1;
+    int busy_poll_us = -1;
+    int rcvbuf_bytes = -1;      // As reported by the kernel (doubled by Linux)
+    int sndbuf_bytes = -1;
+    int ip_tos = -1;
+    std::vector<std::string> failures;  // Options the kernel refused
+
+    std::string to_string() const;
+};
+
+class SocketTuning {
+public:
+    // Apply the profile to a connected or connecting socket and report what stuck
+    static AppliedSocketOptions apply(int fd, const SocketProfile& profile);
+
+    // TCP_QUICKACK is not sticky; call after reads to keep it in effect
+    static void rearm_quickack(int fd);
+};
+
+struct ResolvedAddress {
+    sockaddr_storage addr{};
+    socklen_t addr_len = 0;
+    int family = 0;
+
+    std::string to_string() const;
+};
+
+// Asynchronous resolver with a process-wide cache. Fresh entries are returned
+// immediately; stale entries are returned immediately and refreshed in the
+// background, so a reconnect never blocks on DNS once a host was seen.
+class DnsCache {
+public:
+    static DnsCache& instance() {
+        static DnsCache instance;
+        return instance;
+    }
+
+    // Resolve host:port, waiting at most timeout for a cold lookup
+    std::optional<std::vector<ResolvedAddress>> resolve(
+        const std::string& host,
+        int port,
+        std::chrono::milliseconds timeout = std::chrono::milliseconds(3000)
+    );
+
+    // Start a background lookup without waiting (e.g. at startup)
+    void prefetch(const std::string& host, int port);
+
+    void set_ttl(std::chrono::seconds ttl) { ttl_ = ttl; }
+
+private:
+    DnsCache() = default;
+
+    using Result = std::optional<std::vector<ResolvedAddress>>;
+
+    struct Entry {
+        std::vector<ResolvedAddress> addresses;
+        std::chrono::steady_clock::time_point resolved_at;
+        std::shared_future<Result> pending;
+    };
+
+    std::shared_future<Result> start_lookup(const std::string& key, const std::string& host, int port);
+    static Result lookup(const std::string& host, int port);
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;
+    std::chrono::seconds ttl_{300};
+};
+
+} // namespace MarketMaker
+
+#endif // SOCKET_OPTIONS_H
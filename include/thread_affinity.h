@@ -0,0 +1,15 @@
+#ifndef THREAD_AFFINITY_H
+#define THREAD_AFFINITY_H
+
+namespace MarketMaker {
+
+// Pin the calling thread to one CPU; false (and a message) if the kernel refuses
+bool pin_current_thread(int cpu);
+
+// Run the calling thread only when nothing else wants the CPU (SCHED_IDLE,
+// falling back to the lowest nice value)
+bool lower_current_thread_priority();
+
+} // namespace MarketMaker
+
+#endif // THREAD_AFFINITY_H
@@ -5,6 +5,7 @@
 #include <chrono>
 #include <vector>
 #include <memory>
+#include <cstdint>
 
 namespace MarketMaker {
 
@@ -22,6 +23,15 @@ enum class OrderStatus {
     EXPIRED
 };
 
+// newOrderRespType: how much of the new order the exchange reports back.
+// ACK returns as soon as the order is accepted; fills come from the user
+// data stream either way.
+enum class OrderResponseType {
+    ACK,
+    RESULT,
+    FULL
+};
+
 struct PriceLevel {
     double price;
     double quantity;
@@ -33,6 +43,7 @@ struct OrderBook {
     std::vector<PriceLevel> bids;
     std::vector<PriceLevel> asks;
     std::chrono::steady_clock::time_point timestamp;
+    int64_t exchange_time_ms = 0;  // Venue's own stamp (epoch ms), 0 if the feed has none
 
     double get_mid_price() const {
         if (bids.empty() || asks.empty()) {
@@ -63,6 +74,23 @@ struct Order {
     std::chrono::steady_clock::time_point updated_time;
 };
 
+// executionReport from the user data stream (one per order update/fill)
+struct ExecutionReport {
+    std::string symbol;
+    std::string order_id;
+    std::string client_order_id;
+    OrderSide side = OrderSide::BUY;
+    OrderStatus status = OrderStatus::NEW;
+    bool is_trade = false;                  // Execution type TRADE (a fill)
+    double price = 0.0;                     // Order price
+    double quantity = 0.0;                  // Order quantity
+    double last_filled_price = 0.0;
+    double last_filled_quantity = 0.0;
+    double cumulative_filled_quantity = 0.0;
+    int64_t event_time_ms = 0;              // Exchange time
+    std::chrono::steady_clock::time_point received_time;  // When the frame was read off the socket
+};
+
 struct MarketData {
     std::string symbol;
     double last_price;
@@ -111,6 +139,14 @@ struct LatencyMetrics {
     }
 };
 
+// Extra credential set on the same exchange. Each sub-account has its own
+// sessions and order-rate budget.
+struct SubAccount {
+    std::string name;
+    std::string api_key;
+    std::string api_secret;
+};
+
 } // namespace MarketMaker
 
 #endif // TYPES_H
\ No newline at end of file
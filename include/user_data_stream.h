@@ -0,0 +1,74 @@
+#ifndef USER_DATA_STREAM_H
+#define USER_DATA_STREAM_H
+
+#include "types.h"
+#include "ws_connection.h"
+#include <string>
+#include <string_view>
+#include <optional>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+namespace MarketMaker {
+
+// Binance user data stream: order updates and fills pushed over a WebSocket
+// opened with a listenKey. Key creation and keepalive are injected so the
+// same stream works with the key obtained over REST or the WebSocket API.
+//
+// Only executionReport events are decoded; the rest (balance updates etc.)
+// are ignored. A listenKeyExpired event or a dropped socket triggers a
+// reconnect with a fresh key.
+class UserDataStream {
+public:
+    using ListenKeyProvider = std::function<std::optional<std::string>()>;
+    using ListenKeyKeepalive = std::function<bool(const std::string&)>;
+    using ExecutionHandler = std::function<void(const ExecutionReport&)>;
+
+    // ws_base_url: stream endpoint the key is appended to, e.g. wss://stream.binance.com:9443/ws
+    UserDataStream(const std::string& ws_base_url,
+                   ListenKeyProvider create_listen_key,
+                   ListenKeyKeepalive keepalive_listen_key);
+    ~UserDataStream();
+
+    UserDataStream(const UserDataStream&) = delete;
+    UserDataStream& operator=(const UserDataStream&) = delete;
+
+    void set_execution_handler(ExecutionHandler handler) { execution_handler_ = handler; }
+    void set_socket_profile(const SocketProfile& profile);
+    void enable_ktls(bool enable = true);
+
+    // Get a key, connect and start the reader thread
+    bool start();
+    void stop();
+
+    bool is_connected() const { return connected_.load(); }
+
+private:
+    std::string ws_base_url_;
+    ListenKeyProvider create_listen_key_;
+    ListenKeyKeepalive keepalive_listen_key_;
+    ExecutionHandler execution_handler_;
+
+    std::unique_ptr<WsConnection> connection_;
+    std::string listen_key_;
+
+    std::atomic<bool> running_{false};
+    std::atomic<bool> connected_{false};
+    std::atomic<bool> key_expired_{false};
+    std::thread reader_thread_;
+
+    // Binance expires keys after 60 minutes without a keepalive
+    static constexpr std::chrono::minutes KEEPALIVE_INTERVAL{30};
+    static constexpr std::chrono::milliseconds RECONNECT_DELAY{1000};
+
+    bool open();
+    void run_reader();
+    void process_message(std::string_view message);
+};
+
+} // namespace MarketMaker
+
+#endif // USER_DATA_STREAM_H
@@ -2,6 +2,7 @@
 #define WEBSOCKET_CLIENT_H
 
 #include "types.h"
+#include "ws_connection.h"
 #include <functional>
 #include <thread>
 #include <atomic>
@@ -10,14 +11,6 @@
 #include <mutex>
 #include <condition_variable>
 
-// Forward declarations for WebSocket++ library
-namespace websocketpp {
-    template <typename config> class client;
-    namespace config {
-        struct asio_tls_client;
-    }
-}
-
 namespace MarketMaker {
 
 class WebSocketClient {
@@ -37,6 +30,9 @@ public:
     void subscribe_orderbook(const std::string& symbol, int depth = 20);
     void subscribe_trades(const std::string& symbol);
 
+    // Send a raw text frame (e.g. other SUBSCRIBE requests)
+    bool send_text(const std::string& message);
+
     // Event handlers
     void set_message_handler(MessageHandler handler);
     void set_connection_handler(ConnectionHandler handler);
@@ -45,9 +41,18 @@ public:
     void enable_auto_reconnect(bool enable = true);
     void set_reconnect_delay(std::chrono::milliseconds delay);
 
+    // Socket tuning (applied on next connect) and what the kernel accepted
+    void set_socket_profile(const SocketProfile& profile);
+    AppliedSocketOptions get_socket_report() const;
+
+    // Kernel TLS offload (applied on next connect). When the kernel accepts the
+    // session keys, the socket is read/written with plain recv/send afterwards.
+    void enable_ktls(bool enable = true);
+
+    TransportStats get_transport_stats() const;
+
 private:
-    class Impl;  // PIMPL idiom for WebSocket++ dependencies
-    std::unique_ptr<Impl> pImpl;
+    std::unique_ptr<WsConnection> connection_;
 
     std::atomic<bool> connected_{false};
     std::atomic<bool> auto_reconnect_{true};
@@ -57,6 +62,7 @@ private:
     std::string current_uri_;
 
     MessageHandler message_handler_;
+    std::string message_buffer_;  // Reused for handlers taking std::string
     ConnectionHandler connection_handler_;
 
     std::thread worker_thread_;
@@ -68,7 +74,7 @@ private:
 
     void run_worker();
     void handle_reconnect();
-    void process_message(const std::string& message);
+    void process_message(std::string_view message);
     void run_heartbeat();
     void send_ping();
 };
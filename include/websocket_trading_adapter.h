@@ -4,6 +4,7 @@
 #include "exchange_interface.h"
 #include "websocket_trading_client.h"
 #include "websocket_client.h"
+#include "user_data_stream.h"
 #include <memory>
 #include <string>
 
@@ -31,10 +32,8 @@ public:
     bool supports_websocket_trading() const override { return true; }
 
     // Initialize method (required by interface)
-    bool initialize([[maybe_unused]] const ExchangeConfig& config) override {
-        // Already initialized in constructor
-        return true;
-    }
+    // Clients are created in the constructor; this only applies transport options
+    bool initialize(const ExchangeConfig& config) override;
 
     // Connection management
     bool connect() override;
@@ -44,6 +43,7 @@ public:
     bool subscribe_orderbook(const std::string& symbol, int depth) override;
     bool subscribe_trades(const std::string& symbol) override;
     bool unsubscribe(const std::string& symbol) override;
+    bool subscribe_user_data() override;
 
     std::optional<OrderBook> get_orderbook(const std::string& symbol, int limit = 20) override;
     std::optional<double> get_current_price(const std::string& symbol) override;
@@ -55,7 +55,8 @@ public:
         OrderSide side,
         double price,
         double quantity,
-        const std::string& client_order_id = ""
+        const std::string& client_order_id = "",
+        bool post_only = false
     ) override;
 
     std::optional<Order> place_market_order(
@@ -101,6 +102,9 @@ public:
         int& price_precision,
         int& quantity_precision
     ) override;
+    std::optional<ExchangeFilters> get_symbol_filters(const std::string& symbol) override;
+    bool sync_clock() override;
+    std::vector<LatencyProbe> probe_latency(const std::optional<ProbeOrder>& order) override;
 
     double format_price(double price, const std::string& symbol) override;
     double format_quantity(double quantity, const std::string& symbol) override;
@@ -127,6 +131,7 @@ private:
     // WebSocket clients
     std::shared_ptr<WebSocketClient> ws_market_client_;       // For market data
     std::shared_ptr<WebSocketTradingClient> ws_trading_client_; // For trading
+    std::unique_ptr<UserDataStream> user_stream_;             // Fills (listenKey via WS API)
 
     // Configuration
     std::string api_key_;
@@ -143,6 +148,7 @@ private:
         double tick_size = 0.01;
     };
     mutable std::unordered_map<std::string, SymbolInfo> symbol_info_cache_;
+    std::unordered_map<std::string, ExchangeFilters> filters_cache_;  // Fetched on first use
     mutable std::mutex cache_mutex_;
 
     // Current orderbook (updated from market data WebSocket)
@@ -158,6 +164,7 @@ private:
     Order json_to_order(const Json::Value& json_order);
     void handle_market_data_message(const std::string& message);
     void handle_trading_response(const Json::Value& response);
+    void handle_trading_ack(const WsApiAck& ack);
     void update_orderbook_from_message(const Json::Value& data);
 };
 
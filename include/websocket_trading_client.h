@@ -2,9 +2,10 @@
 #define WEBSOCKET_TRADING_CLIENT_H
 
 #include "types.h"
-#include <websocketpp/config/asio_client.hpp>
-#include <websocketpp/client.hpp>
+#include "ws_connection.h"
+#include "ws_api_response.h"
 #include <string>
+#include <string_view>
 #include <memory>
 #include <optional>
 #include <functional>
@@ -13,17 +14,18 @@
 #include <condition_variable>
 #include <unordered_map>
 #include <chrono>
+#include <future>
+#include <thread>
+#include <tuple>
+#include <vector>
 #include <json/json.h>
 
 namespace MarketMaker {
 
-using WsClient = websocketpp::client<websocketpp::config::asio_tls_client>;
-using WsMessagePtr = websocketpp::config::asio_client::message_type::ptr;
-using WsConnectionPtr = websocketpp::client<websocketpp::config::asio_tls_client>::connection_ptr;
-
 class WebSocketTradingClient {
 public:
     using OrderResponseHandler = std::function<void(const Json::Value&)>;
+    using AckHandler = std::function<void(const WsApiAck&)>;
     using ConnectionHandler = std::function<void(bool)>;
     using ErrorHandler = std::function<void(const std::string&)>;
 
@@ -39,6 +41,14 @@ public:
     void enable_auto_reconnect(bool enable) { auto_reconnect_ = enable; }
     void set_reconnect_delay(std::chrono::milliseconds delay) { reconnect_delay_ = delay; }
 
+    // Socket tuning (applied on next connect) and what the kernel accepted
+    void set_socket_profile(const SocketProfile& profile);
+    AppliedSocketOptions get_socket_report() const;
+
+    // Kernel TLS offload for the order connection (applied on next connect)
+    void enable_ktls(bool enable = true);
+    TransportStats get_transport_stats() const;
+
     // Order operations via WebSocket
     std::optional<std::string> place_limit_order(
         const std::string& symbol,
@@ -46,7 +56,9 @@ public:
         double price,
         double quantity,
         const std::string& client_order_id = "",
-        bool wait_for_response = true
+        bool wait_for_response = true,
+        bool post_only = false,  // LIMIT_MAKER
+        OrderResponseType response_type = OrderResponseType::ACK
     );
 
     std::optional<bool> cancel_order(
@@ -71,17 +83,38 @@ public:
         bool wait_for_response = true
     );
 
+    // User data stream listenKey (userDataStream.start / .ping, API key only)
+    std::optional<std::string> start_user_data_stream();
+    bool ping_user_data_stream(const std::string& listen_key);
+
+    // Exchange time in epoch ms ("time" method, unsigned)
+    std::optional<int64_t> get_server_time();
+
+    // Latency probes, round trip in microseconds (nullopt on failure): "ping"
+    // and "order.test" (validated by the exchange, never sent to the book)
+    std::optional<int64_t> ping();
+    std::optional<int64_t> test_order(const std::string& symbol, OrderSide side, double price,
+                                      double quantity, bool post_only);
+
+    // exchangeInfo for one symbol (unsigned); same "symbols" layout as REST
+    std::optional<Json::Value> get_exchange_info(const std::string& symbol);
+
     // Batch operations for efficiency
     void place_orders_batch(
         const std::vector<std::tuple<std::string, OrderSide, double, double>>& orders,
         OrderResponseHandler handler
     );
 
-    // Set handlers
+    // Set handlers. Acks of order.place/order.cancel/order.cancelReplace go to
+    // the ack handler only; everything else is parsed with JsonCpp.
     void set_order_response_handler(OrderResponseHandler handler) {
         order_response_handler_ = handler;
     }
 
+    void set_ack_handler(AckHandler handler) {
+        ack_handler_ = handler;
+    }
+
     void set_connection_handler(ConnectionHandler handler) {
         connection_handler_ = handler;
     }
@@ -105,10 +138,12 @@ public:
 
     const TradingMetrics& get_metrics() const { return metrics_; }
 
+    // Usage reported by the most recent response's "rateLimits"
+    std::vector<WsApiRateLimit> get_rate_limits() const;
+
 private:
-    // WebSocket client
-    std::unique_ptr<WsClient> ws_client_;
-    websocketpp::connection_hdl connection_hdl_;
+    // WebSocket connection (shared RFC 6455 core with the market-data client)
+    std::unique_ptr<WsConnection> connection_;
 
     // Authentication
     std::string api_key_;
@@ -122,18 +157,30 @@ private:
 
     // Request tracking
     struct PendingRequest {
+        uint64_t id{0};
         std::string method;
+        bool fast_path{false};  // Response handled by WsApiResponseScanner
+        std::string symbol;     // From params, for error attribution
+        bool has_side{false};
+        OrderSide side{OrderSide::BUY};
         std::chrono::steady_clock::time_point sent_time;
         std::promise<Json::Value> promise;
+        std::promise<WsApiAck> ack_promise;
         bool waiting{true};
     };
 
     std::mutex requests_mutex_;
-    std::unordered_map<std::string, std::shared_ptr<PendingRequest>> pending_requests_;
+    std::unordered_map<uint64_t, std::shared_ptr<PendingRequest>> pending_requests_;
     std::atomic<uint64_t> request_id_counter_{1};
 
+    // Latest rateLimits snapshot
+    WsApiRateLimit rate_limits_[WsApiAck::MAX_RATE_LIMITS];
+    size_t rate_limit_count_{0};
+    mutable std::mutex rate_limits_mutex_;
+
     // Handlers
     OrderResponseHandler order_response_handler_;
+    AckHandler ack_handler_;
     ConnectionHandler connection_handler_;
     ErrorHandler error_handler_;
 
@@ -141,30 +188,39 @@ private:
     mutable TradingMetrics metrics_;
 
     // Threads
-    std::thread ws_thread_;
+    std::thread reader_thread_;
     std::thread reconnect_thread_;
 
     // Internal methods
-    void run_event_loop();
+    void run_reader();
     void handle_reconnect();
-
-    // WebSocket callbacks
-    void on_open(websocketpp::connection_hdl hdl);
-    void on_close(websocketpp::connection_hdl hdl);
-    void on_fail(websocketpp::connection_hdl hdl);
-    void on_message(websocketpp::connection_hdl hdl, WsMessagePtr msg);
+    void on_close();
 
     // Message handling
-    void process_message(const std::string& message);
+    void process_message(std::string_view message);
     void handle_order_response(const Json::Value& response);
-    void handle_error_response(const Json::Value& response);
+    void handle_error_response(const Json::Value& response, const PendingRequest& request);
+    void handle_ack(const WsApiAck& ack, const PendingRequest& request);
+    void record_rate_limits(const WsApiAck& ack);
 
     // Request management
-    std::string generate_request_id();
+    uint64_t generate_request_id();
     Json::Value create_signed_request(
         const std::string& method,
         const Json::Value& params
     );
+    Json::Value create_unsigned_request(
+        const std::string& method,
+        const Json::Value& params
+    );
+    static bool requires_signature(const std::string& method);
+
+    // Register the request as pending and send it; nullptr if not sent
+    std::shared_ptr<PendingRequest> send_tracked_request(
+        const std::string& method,
+        const Json::Value& params,
+        bool waiting
+    );
 
     std::optional<Json::Value> send_request_and_wait(
         const std::string& method,
@@ -172,6 +228,12 @@ private:
         std::chrono::milliseconds timeout = std::chrono::milliseconds(5000)
     );
 
+    std::optional<WsApiAck> send_ack_request_and_wait(
+        const std::string& method,
+        const Json::Value& params,
+        std::chrono::milliseconds timeout = std::chrono::milliseconds(5000)
+    );
+
     void send_request_async(
         const std::string& method,
         const Json::Value& params,
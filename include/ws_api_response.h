@@ -0,0 +1,77 @@
+#ifndef WS_API_RESPONSE_H
+#define WS_API_RESPONSE_H
+
+#include "types.h"
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+
+namespace Json {
+class Value;
+}
+
+namespace MarketMaker {
+
+// One entry of the "rateLimits" array attached to every WS API response
+struct WsApiRateLimit {
+    enum class Type : uint8_t { UNKNOWN, REQUEST_WEIGHT, ORDERS, RAW_REQUESTS };
+    enum class Interval : uint8_t { UNKNOWN, SECOND, MINUTE, HOUR, DAY };
+
+    Type type = Type::UNKNOWN;
+    Interval interval = Interval::UNKNOWN;
+    int interval_num = 0;
+    int limit = 0;
+    int count = 0;
+};
+
+// Compact, trivially copyable result of an order.place / order.cancel /
+// order.cancelReplace response. Strings are truncated into fixed buffers so the
+// struct can cross threads (promise) without owning heap memory.
+struct WsApiAck {
+    static constexpr size_t MAX_RATE_LIMITS = 4;
+
+    uint64_t request_id = 0;
+    bool has_id = false;
+    int status = 0;                    // HTTP-style status (200, 400, 429, ...)
+
+    // Success fields ("result")
+    bool has_result = false;
+    int64_t order_id = 0;              // New order for cancelReplace
+    int64_t cancelled_order_id = 0;    // cancelReplace only
+    bool has_order_status = false;
+    OrderStatus order_status = OrderStatus::NEW;
+    char client_order_id[40] = {0};    // Binance allows up to 36 characters
+
+    // Failure fields ("error")
+    bool has_error = false;
+    int error_code = 0;
+    char error_msg[128] = {0};
+    int64_t retry_after_ms = 0;        // error.data.retryAfter: epoch ms when requests may resume, 0 if absent
+
+    WsApiRateLimit rate_limits[MAX_RATE_LIMITS];
+    size_t rate_limit_count = 0;
+
+    bool ok() const { return has_result && !has_error; }
+};
+
+// Single-pass scanner for the high-volume WS API responses. It only knows the
+// handful of keys above, skips everything else without materializing it, and
+// never allocates. Anything it cannot handle (arrays as result, malformed
+// JSON) makes scan() return false so the caller can fall back to JsonCpp.
+class WsApiResponseScanner {
+public:
+    static bool scan(std::string_view message, WsApiAck& ack);
+
+    // Same fields from a response already parsed by JsonCpp, for acks scan()
+    // gave up on; false if it has no id or neither result nor error
+    static bool from_json(const Json::Value& response, WsApiAck& ack);
+
+    // Methods whose responses are handled by scan() instead of JsonCpp
+    static bool is_fast_method(std::string_view method) {
+        return method == "order.place" || method == "order.cancel" || method == "order.cancelReplace";
+    }
+};
+
+} // namespace MarketMaker
+
+#endif // WS_API_RESPONSE_H
@@ -0,0 +1,138 @@
+#ifndef WS_CONNECTION_H
+#define WS_CONNECTION_H
+
+#include "socket_options.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <functional>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Forward declarations for OpenSSL
+typedef struct ssl_ctx_st SSL_CTX;
+typedef struct ssl_st SSL;
+
+namespace MarketMaker {
+
+// Read-path counters, used to compare user-space TLS against kTLS
+struct TransportStats {
+    bool ktls_tx = false;
+    bool ktls_rx = false;
+    uint64_t bytes_read = 0;
+    uint64_t read_calls = 0;
+    uint64_t read_time_ns = 0;  // Time spent inside recv/SSL_read
+};
+
+// Minimal RFC 6455 client connection shared by the market-data and trading clients.
+//
+// - TLS over a non-blocking socket once the upgrade is done; SSL calls are
+//   serialized by a mutex so one reader thread and any number of writers can
+//   share the connection
+// - Frames are decoded in place in a preallocated receive buffer and complete
+//   messages are handed out as string_views (no copy unless fragmented)
+// - Outgoing frames are built and masked in a preallocated send buffer and
+//   written with a single SSL_write/send
+// - fd() + read_available() let an external poll/epoll loop drive several
+//   connections from one thread; wait_and_read() is the single-connection loop
+class WsConnection {
+public:
+    using MessageHandler = std::function<void(std::string_view)>;
+
+    enum class ReadStatus {
+        OK,        // Zero or more messages dispatched, connection still open
+        TIMEOUT,   // Nothing readable within the timeout
+        CLOSED,    // Peer closed (close frame or EOF)
+        ERROR      // Transport error
+    };
+
+    WsConnection();
+    ~WsConnection();
+
+    WsConnection(const WsConnection&) = delete;
+    WsConnection& operator=(const WsConnection&) = delete;
+
+    // Options applied on the next connect()
+    void set_socket_profile(const SocketProfile& profile);
+    void enable_ktls(bool enable = true);
+
+    // Blocking TCP connect + TLS handshake + HTTP upgrade (wss://host[:port]/path)
+    bool connect(const std::string& uri);
+
+    // Send a close frame and shut the socket down. Resources are released on the
+    // next connect() or in the destructor, so a concurrent reader never sees a
+    // recycled fd.
+    void close(uint16_t code = 1000);
+
+    bool is_open() const { return open_.load(); }
+    int fd() const { return socket_fd_; }
+
+    // Thread-safe sends
+    bool send_text(std::string_view payload);
+    bool send_ping();
+
+    // Drain everything currently readable and dispatch complete messages.
+    // Never blocks; call when fd() is readable.
+    ReadStatus read_available(const MessageHandler& on_message);
+
+    // poll() for readability up to timeout, then read_available()
+    ReadStatus wait_and_read(std::chrono::milliseconds timeout, const MessageHandler& on_message);
+
+    AppliedSocketOptions socket_report() const;
+    TransportStats transport_stats() const;
+
+    std::chrono::steady_clock::time_point last_receive_time() const {
+        return std::chrono::steady_clock::time_point(
+            std::chrono::steady_clock::duration(last_receive_ns_.load()));
+    }
+
+private:
+    // TLS
+    SSL_CTX* ssl_ctx_ = nullptr;
+    SSL* ssl_ = nullptr;
+    int socket_fd_ = -1;
+    bool ktls_tx_ = false;
+    bool ktls_rx_ = false;
+    bool quickack_ = false;
+    std::atomic<bool> open_{false};
+    mutable std::mutex io_mutex_;  // Guards ssl_ and socket writes
+
+    // Options
+    SocketProfile socket_profile_;
+    AppliedSocketOptions socket_report_;
+    bool use_ktls_ = false;
+    mutable std::mutex options_mutex_;
+
+    // Receive side (owned by the reader thread)
+    std::vector<char> recv_buffer_;
+    size_t recv_begin_ = 0;
+    size_t recv_end_ = 0;
+    std::string fragment_buffer_;
+    bool in_fragment_ = false;
+
+    // Send side (guarded by io_mutex_)
+    std::vector<unsigned char> send_buffer_;
+    uint32_t mask_state_;
+
+    // Counters
+    TransportStats stats_;
+    std::atomic<int64_t> last_receive_ns_{0};
+
+    void release();
+    bool perform_upgrade(const std::string& host, const std::string& path);
+    void detect_ktls();
+
+    // Raw TLS I/O, io_mutex_ must be held
+    int tls_read(char* buffer, int length, bool& would_block);
+    bool tls_write_all(const unsigned char* data, size_t length);
+
+    bool send_frame(uint8_t opcode, std::string_view payload);
+    ReadStatus parse_frames(const MessageHandler& on_message);
+    uint32_t next_mask();
+};
+
+} // namespace MarketMaker
+
+#endif // WS_CONNECTION_H
@@ -1,4 +1,5 @@
 #include "binance_exchange.h"
+#include "exchange_clock.h"
 #include <json/json.h>
 #include <iostream>
 #include <sstream>
@@ -27,6 +28,8 @@ bool BinanceExchange::initialize(const ExchangeConfig& config) {
         config.api_secret
     );
 
+    rest_client_->set_socket_profile(config.socket_profile);
+
     // Configure REST client with display assets
     if (!config.display_assets.empty()) {
         rest_client_->set_display_assets(config.display_assets);
@@ -59,6 +62,8 @@ bool BinanceExchange::initialize(const ExchangeConfig& config) {
     });
 
     ws_client_->enable_auto_reconnect(true);
+    ws_client_->enable_ktls(config.use_ktls);
+    ws_client_->set_socket_profile(config.socket_profile);
 
     // Fetch exchange info to populate symbol cache
     auto exchange_info = get_exchange_info();
@@ -67,6 +72,9 @@ bool BinanceExchange::initialize(const ExchangeConfig& config) {
         return false;
     }
 
+    // Signed requests are stamped with exchange time from here on
+    sync_clock();
+
     initialized_ = true;
     std::cout << "BinanceExchange initialized successfully" << std::endl;
 
@@ -90,6 +98,9 @@ bool BinanceExchange::connect() {
 }
 
 void BinanceExchange::disconnect() {
+    if (user_stream_) {
+        user_stream_->stop();
+    }
     if (ws_client_) {
         ws_client_->disconnect();
     }
@@ -141,6 +152,30 @@ bool BinanceExchange::subscribe_orderbook(const std::string& symbol, int depth)
     return true;
 }
 
+bool BinanceExchange::subscribe_user_data() {
+    if (!rest_client_) {
+        return false;
+    }
+
+    if (!user_stream_) {
+        auto rest = rest_client_;
+        user_stream_ = std::make_unique<UserDataStream>(
+            config_.ws_url,
+            [rest]() { return rest->create_listen_key(); },
+            [rest](const std::string& key) { return rest->keepalive_listen_key(key); }
+        );
+        user_stream_->set_socket_profile(config_.socket_profile);
+        user_stream_->enable_ktls(config_.use_ktls);
+        user_stream_->set_execution_handler([this](const ExecutionReport& report) {
+            if (execution_handler_) {
+                execution_handler_(report);
+            }
+        });
+    }
+
+    return user_stream_->start();
+}
+
 bool BinanceExchange::subscribe_trades(const std::string& symbol) {
     if (!ws_client_ || !ws_connected_) {
         return false;
@@ -181,51 +216,25 @@ std::optional<std::string> BinanceExchange::get_exchange_info() {
 
     auto info = rest_client_->get_exchange_info();
 
-    // Parse and cache symbol information
+    // Parse every symbol filter; SymbolInfo keeps the precision/limit subset
     if (info.has_value()) {
         try {
             Json::Value root;
             Json::Reader reader;
             if (reader.parse(info.value(), root)) {
-                const Json::Value& symbols = root["symbols"];
+                auto filters = ExchangeFilterParser::parse_exchange_info(root);
 
                 std::lock_guard<std::mutex> lock(cache_mutex_);
-                for (const auto& symbol : symbols) {
+                for (const auto& [symbol_name, symbol_filters] : filters) {
                     SymbolInfo sym_info;
-                    std::string symbol_name = symbol["symbol"].asString();
-
-                    // Parse filters for precision and limits
-                    const Json::Value& filters = symbol["filters"];
-                    for (const auto& filter : filters) {
-                        std::string filterType = filter["filterType"].asString();
-
-                        if (filterType == "PRICE_FILTER") {
-                            sym_info.tick_size = std::stod(filter["tickSize"].asString());
-                            // Calculate precision from tick size
-                            std::string tick_str = filter["tickSize"].asString();
-                            size_t decimal_pos = tick_str.find('.');
-                            if (decimal_pos != std::string::npos) {
-                                sym_info.price_precision = tick_str.length() - decimal_pos - 1;
-                            } else {
-                                sym_info.price_precision = 0;
-                            }
-                        } else if (filterType == "LOT_SIZE") {
-                            sym_info.min_qty = std::stod(filter["minQty"].asString());
-                            sym_info.max_qty = std::stod(filter["maxQty"].asString());
-
-                            // Calculate quantity precision
-                            std::string step_str = filter["stepSize"].asString();
-                            size_t decimal_pos = step_str.find('.');
-                            if (decimal_pos != std::string::npos) {
-                                sym_info.quantity_precision = step_str.length() - decimal_pos - 1;
-                            } else {
-                                sym_info.quantity_precision = 0;
-                            }
-                        }
-                    }
-
+                    sym_info.price_precision = symbol_filters.price_precision;
+                    sym_info.quantity_precision = symbol_filters.quantity_precision;
+                    sym_info.min_qty = symbol_filters.min_qty;
+                    sym_info.max_qty = symbol_filters.max_qty;
+                    sym_info.tick_size = symbol_filters.tick_size;
                     symbol_cache_[symbol_name] = sym_info;
                 }
+                filters_cache_ = std::move(filters);
             }
         } catch (const std::exception& e) {
             std::cerr << "Error parsing Binance exchange info: " << e.what() << std::endl;
@@ -242,7 +251,8 @@ std::optional<Order> BinanceExchange::place_limit_order(
     OrderSide side,
     double price,
     double quantity,
-    const std::string& client_order_id
+    const std::string& client_order_id,
+    bool post_only
 ) {
     if (!rest_client_) {
         return std::nullopt;
@@ -261,7 +271,9 @@ std::optional<Order> BinanceExchange::place_limit_order(
         side,
         formatted_price,
         formatted_qty,
-        client_order_id
+        client_order_id,
+        post_only,
+        config_.order_response_type
     );
 }
 
@@ -408,6 +420,51 @@ void BinanceExchange::set_connection_handler(ConnectionHandler handler) {
 
 // ========== Utility Methods ==========
 
+bool BinanceExchange::sync_clock() {
+    if (!rest_client_) {
+        return false;
+    }
+
+    int64_t sent = ExchangeClock::local_ms();
+    auto server_time = rest_client_->get_server_time();
+    int64_t received = ExchangeClock::local_ms();
+
+    if (!server_time) {
+        std::cerr << "[CLOCK] Failed to fetch Binance server time" << std::endl;
+        return false;
+    }
+
+    ExchangeClock::instance().update(*server_time, sent, received);
+    return true;
+}
+
+std::vector<LatencyProbe> BinanceExchange::probe_latency(const std::optional<ProbeOrder>& order) {
+    std::vector<LatencyProbe> probes;
+    if (!rest_client_) {
+        return probes;
+    }
+
+    // Orders go over REST here, so that is the one connection to probe
+    probes.push_back({"rest", "ping", rest_client_->ping().value_or(-1), 1});
+    if (order) {
+        auto rtt = rest_client_->test_order(convert_symbol_to_binance(order->symbol), order->side,
+                                            order->price, order->quantity, order->post_only);
+        probes.push_back({"rest", "order.test", rtt.value_or(-1), 1});
+    }
+    return probes;
+}
+
+std::optional<ExchangeFilters> BinanceExchange::get_symbol_filters(const std::string& symbol) {
+    std::string binance_symbol = convert_symbol_to_binance(symbol);
+
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    auto it = filters_cache_.find(binance_symbol);
+    if (it != filters_cache_.end()) {
+        return it->second;
+    }
+    return std::nullopt;
+}
+
 bool BinanceExchange::get_symbol_info(
     const std::string& symbol,
     int& price_precision,
@@ -536,10 +593,8 @@ void BinanceExchange::process_binance_orderbook(const std::string& json_str) {
                 current_orderbook_ = orderbook;
             }
 
-            // Notify handler
-            if (orderbook_handler_) {
-                orderbook_handler_(orderbook);
-            }
+            // Notify handlers
+            notify_orderbook(orderbook);
         }
     } catch (const std::exception& e) {
         std::cerr << "Error processing Binance orderbook: " << e.what() << std::endl;
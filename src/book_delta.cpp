@@ -0,0 +1,59 @@
+#include "book_delta.h"
+#include <algorithm>
+
+namespace MarketMaker {
+
+const BookDelta& BookChangeTracker::apply(const OrderBook& book) {
+    delta_.mask = 0;
+    delta_.changes.clear();
+
+    diff_side(OrderSide::BUY, previous_.bids, book.bids);
+    diff_side(OrderSide::SELL, previous_.asks, book.asks);
+
+    if (delta_.mask & (BookDelta::level_bit(OrderSide::BUY, 0) | BookDelta::level_bit(OrderSide::SELL, 0))) {
+        delta_.mask |= BookDelta::TOP_OF_BOOK;
+    }
+    if (previous_.get_best_bid() != book.get_best_bid() || previous_.get_best_ask() != book.get_best_ask()) {
+        delta_.mask |= BookDelta::TOUCH_PRICE;
+    }
+
+    // Assign rather than copy-construct: keeps the vectors' capacity
+    previous_.bids.assign(book.bids.begin(), book.bids.end());
+    previous_.asks.assign(book.asks.begin(), book.asks.end());
+    previous_.timestamp = book.timestamp;
+    return delta_;
+}
+
+void BookChangeTracker::reset() {
+    previous_.bids.clear();
+    previous_.asks.clear();
+}
+
+void BookChangeTracker::diff_side(OrderSide side, const std::vector<PriceLevel>& before,
+                                  const std::vector<PriceLevel>& after) {
+    size_t levels = std::max(before.size(), after.size());
+    for (size_t i = 0; i < levels; ++i) {
+        PriceLevel old_level = i < before.size() ? before[i] : PriceLevel{};
+        PriceLevel new_level = i < after.size() ? after[i] : PriceLevel{};
+        // Exchange decimals parse to the same double every time, so exact
+        // comparison is what we want here
+        if (old_level.price == new_level.price && old_level.quantity == new_level.quantity) {
+            continue;
+        }
+
+        LevelChange change;
+        change.side = side;
+        change.level = static_cast<uint16_t>(i);
+        change.old_price = old_level.price;
+        change.old_quantity = old_level.quantity;
+        change.new_price = new_level.price;
+        change.new_quantity = new_level.quantity;
+        delta_.changes.push_back(change);
+
+        if (i < static_cast<size_t>(BookDelta::MAX_LEVELS)) {
+            delta_.mask |= BookDelta::level_bit(side, static_cast<int>(i));
+        }
+    }
+}
+
+} // namespace MarketMaker
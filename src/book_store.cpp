@@ -0,0 +1,511 @@
+#include "book_store.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace MarketMaker {
+
+namespace {
+
+enum Column { TIME = 0, FLAGS = 1, PRICE = 2, QUANTITY = 3 };
+
+void put_varint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+uint64_t zigzag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t unzigzag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+// Reads one varint; nullptr past the end or on an overlong encoding
+const uint8_t* get_varint(const uint8_t* in, const uint8_t* end, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && in < end; shift += 7) {
+        uint8_t byte = *in++;
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            return in;
+        }
+    }
+    return nullptr;
+}
+
+int side_index(uint8_t flags) {
+    return (flags & ROW_ASK) ? 1 : 0;
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// Writer
+
+BookStoreWriter::~BookStoreWriter() {
+    close();
+}
+
+bool BookStoreWriter::open(const std::string& path, const std::string& symbol, uint32_t day,
+                           int price_decimals, int quantity_decimals, uint32_t block_rows) {
+    close();
+
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) {
+        std::cerr << "[STORE] Cannot open " << path << std::endl;
+        return false;
+    }
+    std::setvbuf(file_, nullptr, _IOFBF, 1 << 20);
+
+    BookStoreHeader header;
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.day = day;
+    header.price_decimals = static_cast<uint8_t>(price_decimals);
+    header.quantity_decimals = static_cast<uint8_t>(quantity_decimals);
+    std::strncpy(header.symbol, symbol.c_str(), sizeof(header.symbol) - 1);
+    std::fwrite(&header, sizeof(header), 1, file_);
+
+    path_ = path;
+    offset_ = sizeof(header);
+    price_scale_ = std::pow(10.0, price_decimals);
+    quantity_scale_ = std::pow(10.0, quantity_decimals);
+    block_rows_ = std::max<uint32_t>(block_rows, 1);
+    blocks_[0] = Block{};
+    blocks_[1] = Block{};
+    index_.clear();
+    rows_written_ = 0;
+    return true;
+}
+
+bool BookStoreWriter::close() {
+    if (!file_) {
+        return true;
+    }
+
+    flush_block(BookStoreTable::BOOK);
+    flush_block(BookStoreTable::TRADES);
+
+    BookStoreTrailer trailer;
+    trailer.index_offset = offset_;
+    trailer.block_count = static_cast<uint32_t>(index_.size());
+    trailer.magic = MAGIC;
+    std::fwrite(index_.data(), sizeof(BlockIndexEntry), index_.size(), file_);
+    std::fwrite(&trailer, sizeof(trailer), 1, file_);
+
+    bool ok = std::ferror(file_) == 0;
+    ok = std::fclose(file_) == 0 && ok;
+    file_ = nullptr;
+    if (!ok) {
+        std::cerr << "[STORE] Write failed: " << path_ << std::endl;
+    }
+    return ok;
+}
+
+void BookStoreWriter::add_snapshot(int64_t time_us, const std::vector<PriceLevel>& bids,
+                                   const std::vector<PriceLevel>& asks) {
+    size_t total = bids.size() + asks.size();
+    if (total == 0) {
+        add_row(BookStoreTable::BOOK, time_us, ROW_SNAPSHOT | ROW_RESET | ROW_END, 0.0, 0.0);
+        return;
+    }
+
+    size_t row = 0;
+    for (int side = 0; side < 2; ++side) {
+        for (const auto& level : side == 0 ? bids : asks) {
+            uint8_t flags = ROW_SNAPSHOT | (side ? ROW_ASK : 0);
+            flags |= row == 0 ? ROW_RESET : 0;
+            flags |= ++row == total ? ROW_END : 0;
+            add_row(BookStoreTable::BOOK, time_us, flags, level.price, level.quantity);
+        }
+    }
+}
+
+void BookStoreWriter::add_delta(int64_t time_us, const std::vector<PriceLevel>& bids,
+                                const std::vector<PriceLevel>& asks) {
+    size_t total = bids.size() + asks.size();
+    size_t row = 0;
+    for (int side = 0; side < 2; ++side) {
+        for (const auto& level : side == 0 ? bids : asks) {
+            uint8_t flags = (side ? ROW_ASK : 0) | (++row == total ? ROW_END : 0);
+            add_row(BookStoreTable::BOOK, time_us, flags, level.price, level.quantity);
+        }
+    }
+}
+
+void BookStoreWriter::add_trade(int64_t time_us, OrderSide aggressor, double price, double quantity) {
+    add_row(BookStoreTable::TRADES, time_us, aggressor == OrderSide::SELL ? ROW_ASK : 0, price, quantity);
+}
+
+void BookStoreWriter::add_row(BookStoreTable table, int64_t time_us, uint8_t flags, double price, double quantity) {
+    if (!file_) {
+        return;
+    }
+
+    Block& block = blocks_[static_cast<int>(table)];
+    if (block.rows == 0) {
+        block.first_time_us = time_us;
+        block.last_time_us = time_us;
+    }
+
+    // Trades share one price chain; book sides each have their own
+    int chain = table == BookStoreTable::BOOK ? side_index(flags) : 0;
+    int64_t price_units = std::llround(price * price_scale_);
+    int64_t quantity_units = std::max<int64_t>(std::llround(quantity * quantity_scale_), 0);
+
+    put_varint(block.columns[TIME], zigzag(time_us - block.last_time_us));
+    block.columns[FLAGS].push_back(flags);
+    put_varint(block.columns[PRICE], zigzag(price_units - block.last_price[chain]));
+    put_varint(block.columns[QUANTITY], zigzag(quantity_units - block.last_quantity[chain]));
+
+    block.last_time_us = time_us;
+    block.last_price[chain] = price_units;
+    block.last_quantity[chain] = quantity_units;
+    block.has_snapshot |= (flags & ROW_RESET) != 0;
+    ++rows_written_;
+
+    // Only cut book blocks between updates so a block never splits one
+    bool boundary = table == BookStoreTable::TRADES || (flags & ROW_END);
+    if (++block.rows >= block_rows_ && boundary) {
+        flush_block(table);
+    }
+}
+
+void BookStoreWriter::flush_block(BookStoreTable table) {
+    Block& block = blocks_[static_cast<int>(table)];
+    if (block.rows == 0 || !file_) {
+        return;
+    }
+
+    BlockIndexEntry entry;
+    entry.offset = offset_;
+    entry.first_time_us = block.first_time_us;
+    entry.last_time_us = block.last_time_us;
+    entry.rows = block.rows;
+    entry.table = static_cast<uint8_t>(table);
+    entry.has_snapshot = block.has_snapshot ? 1 : 0;
+    for (int column = 0; column < 4; ++column) {
+        const auto& bytes = block.columns[column];
+        entry.column_bytes[column] = static_cast<uint32_t>(bytes.size());
+        std::fwrite(bytes.data(), 1, bytes.size(), file_);
+        offset_ += bytes.size();
+    }
+    index_.push_back(entry);
+
+    block = Block{};
+}
+
+std::string BookStoreWriter::day_path(const std::string& root, const std::string& symbol, uint32_t day) {
+    std::ostringstream path;
+    path << root << "/" << symbol << "/" << day / 10000 << "-" << std::setw(2) << std::setfill('0')
+         << (day / 100) % 100 << "-" << std::setw(2) << day % 100 << ".mmbk";
+    return path.str();
+}
+
+uint32_t BookStoreWriter::day_of(int64_t time_us) {
+    std::time_t seconds = static_cast<std::time_t>(time_us / 1000000);
+    std::tm utc{};
+    gmtime_r(&seconds, &utc);
+    return static_cast<uint32_t>((utc.tm_year + 1900) * 10000 + (utc.tm_mon + 1) * 100 + utc.tm_mday);
+}
+
+// ---------------------------------------------------------------------------
+// Reader
+
+BookStoreReader::~BookStoreReader() {
+    close();
+}
+
+bool BookStoreReader::open(const std::string& path, std::string* error) {
+    close();
+
+    auto fail = [this, error](const std::string& message) {
+        close();
+        if (error) {
+            *error = message;
+        }
+        return false;
+    };
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return fail("cannot open " + path);
+    }
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(BookStoreHeader) + sizeof(BookStoreTrailer))) {
+        ::close(fd);
+        return fail(path + " is not a book store file");
+    }
+
+    size_ = static_cast<size_t>(st.st_size);
+    void* mapped = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        size_ = 0;
+        return fail("cannot map " + path);
+    }
+    data_ = static_cast<const uint8_t*>(mapped);
+    ::madvise(mapped, size_, MADV_SEQUENTIAL);
+
+    std::memcpy(&header_, data_, sizeof(header_));
+    BookStoreTrailer trailer;
+    std::memcpy(&trailer, data_ + size_ - sizeof(trailer), sizeof(trailer));
+    if (header_.magic != BookStoreWriter::MAGIC || trailer.magic != BookStoreWriter::MAGIC) {
+        return fail(path + " is not a book store file (or was not closed)");
+    }
+    if (header_.version != BookStoreWriter::VERSION) {
+        return fail(path + ": unsupported version " + std::to_string(header_.version));
+    }
+    uint64_t index_bytes = static_cast<uint64_t>(trailer.block_count) * sizeof(BlockIndexEntry);
+    if (trailer.index_offset < sizeof(header_) || trailer.index_offset + index_bytes + sizeof(trailer) != size_) {
+        return fail(path + ": corrupt block index");
+    }
+
+    price_scale_ = std::pow(10.0, header_.price_decimals);
+    quantity_scale_ = std::pow(10.0, header_.quantity_decimals);
+    index_ = reinterpret_cast<const BlockIndexEntry*>(data_ + trailer.index_offset);
+    for (uint32_t i = 0; i < trailer.block_count; ++i) {
+        const auto& entry = index_[i];
+        uint64_t bytes = 0;
+        for (uint32_t column : entry.column_bytes) {
+            bytes += column;
+        }
+        if (entry.table > 1 || entry.offset + bytes > trailer.index_offset) {
+            return fail(path + ": corrupt block " + std::to_string(i));
+        }
+        tables_[entry.table].push_back(i);
+    }
+    return true;
+}
+
+void BookStoreReader::close() {
+    if (data_) {
+        ::munmap(const_cast<uint8_t*>(data_), size_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+    index_ = nullptr;
+    tables_[0].clear();
+    tables_[1].clear();
+}
+
+std::string BookStoreReader::symbol() const {
+    return std::string(header_.symbol, strnlen(header_.symbol, sizeof(header_.symbol)));
+}
+
+size_t BookStoreReader::seek(BookStoreTable table, int64_t time_us) const {
+    const auto& list = tables_[static_cast<int>(table)];
+    auto it = std::lower_bound(list.begin(), list.end(), time_us, [this](uint32_t index, int64_t time) {
+        return index_[index].last_time_us < time;
+    });
+    return static_cast<size_t>(it - list.begin());
+}
+
+bool BookStoreReader::decode(uint32_t index, BookStoreColumns& out) const {
+    const auto& entry = index_[index];
+    const size_t rows = entry.rows;
+    out.time_us.resize(rows);
+    out.flags.resize(rows);
+    out.price.resize(rows);
+    out.quantity.resize(rows);
+
+    const uint8_t* column = data_ + entry.offset;
+    const uint8_t* end = column + entry.column_bytes[TIME];
+    uint64_t raw = 0;
+
+    // Times: running sum from the block's first time
+    int64_t time = entry.first_time_us;
+    for (size_t i = 0; i < rows; ++i) {
+        if (!(column = get_varint(column, end, raw))) {
+            return false;
+        }
+        time += unzigzag(raw);
+        out.time_us[i] = time;
+    }
+
+    if (entry.column_bytes[FLAGS] != rows) {
+        return false;
+    }
+    std::memcpy(out.flags.data(), end, rows);
+    column = end + rows;
+    end = column + entry.column_bytes[PRICE];
+
+    int64_t last_price[2] = {0, 0};
+    bool book = entry.table == static_cast<uint8_t>(BookStoreTable::BOOK);
+    for (size_t i = 0; i < rows; ++i) {
+        if (!(column = get_varint(column, end, raw))) {
+            return false;
+        }
+        int chain = book ? side_index(out.flags[i]) : 0;
+        last_price[chain] += unzigzag(raw);
+        out.price[i] = last_price[chain];
+    }
+
+    column = end;
+    end = column + entry.column_bytes[QUANTITY];
+    int64_t last_quantity[2] = {0, 0};
+    for (size_t i = 0; i < rows; ++i) {
+        if (!(column = get_varint(column, end, raw))) {
+            return false;
+        }
+        int chain = book ? side_index(out.flags[i]) : 0;
+        last_quantity[chain] += unzigzag(raw);
+        out.quantity[i] = last_quantity[chain];
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Replay
+
+BookStoreReplay::BookStoreReplay(const BookStoreReader& reader, int64_t from_us, int depth)
+    : reader_(reader), from_us_(from_us), depth_(std::max(depth, 1)) {
+    // Deltas need the snapshot before them: start the book at the last block
+    // whose snapshot is no later than from_us. A block can begin before
+    // from_us and still reset after it, so candidates are decoded to check.
+    const auto& book_blocks = reader_.blocks(BookStoreTable::BOOK);
+    size_t candidates = 0;
+    while (candidates < book_blocks.size() && reader_.block(book_blocks[candidates]).first_time_us <= from_us_) {
+        ++candidates;
+    }
+
+    Cursor& books = cursors_[0];
+    for (size_t i = candidates; i-- > 0;) {
+        if (!reader_.block(book_blocks[i]).has_snapshot || !reader_.decode(book_blocks[i], books.columns)) {
+            continue;
+        }
+        size_t reset = 0;
+        while (reset < books.columns.size() && !(books.columns.flags[reset] & ROW_RESET)) {
+            ++reset;
+        }
+        if (reset < books.columns.size() && books.columns.time_us[reset] <= from_us_) {
+            // Rows before the reset are overwritten by it
+            books.block = i + 1;
+            books.row = reset;
+            break;
+        }
+    }
+    if (books.block == 0) {
+        // No snapshot early enough: read from the start, publishing after the first reset
+        books.columns = BookStoreColumns{};
+    }
+    cursors_[1].block = reader_.seek(BookStoreTable::TRADES, from_us_);
+}
+
+bool BookStoreReplay::ready(BookStoreTable table) {
+    Cursor& cursor = cursors_[static_cast<int>(table)];
+    const auto& blocks = reader_.blocks(table);
+    while (!cursor.done && cursor.row >= cursor.columns.size()) {
+        if (cursor.block >= blocks.size() || !reader_.decode(blocks[cursor.block], cursor.columns)) {
+            if (cursor.block < blocks.size()) {
+                std::cerr << "[STORE] Corrupt block " << blocks[cursor.block] << ", replay stopped" << std::endl;
+            }
+            cursor.done = true;
+            cursor.columns = BookStoreColumns{};
+            break;
+        }
+        ++cursor.block;
+        cursor.row = 0;
+    }
+    return !cursor.done;
+}
+
+bool BookStoreReplay::next(Event& event) {
+    while (true) {
+        bool have_book = ready(BookStoreTable::BOOK);
+        bool have_trade = ready(BookStoreTable::TRADES);
+        if (!have_book && !have_trade) {
+            return false;
+        }
+
+        Cursor& books = cursors_[0];
+        Cursor& trades = cursors_[1];
+
+        // Trades first on equal times: the book update reflects them
+        bool take_trade = have_trade &&
+            (!have_book || trades.columns.time_us[trades.row] <= books.columns.time_us[books.row]);
+
+        if (take_trade) {
+            size_t row = trades.row++;
+            int64_t time = trades.columns.time_us[row];
+            if (time < from_us_) {
+                continue;
+            }
+            event.kind = Event::Kind::TRADE;
+            event.time_us = time;
+            event.book = nullptr;
+            event.trade.time_us = time;
+            event.trade.aggressor = (trades.columns.flags[row] & ROW_ASK) ? OrderSide::SELL : OrderSide::BUY;
+            event.trade.price = trades.columns.price[row] / reader_.price_scale();
+            event.trade.quantity = trades.columns.quantity[row] / reader_.quantity_scale();
+            return true;
+        }
+
+        // Apply book rows up to the end of this update
+        int64_t time = 0;
+        bool end = false;
+        while (!end && ready(BookStoreTable::BOOK)) {
+            size_t row = books.row++;
+            uint8_t flags = books.columns.flags[row];
+            time = books.columns.time_us[row];
+            if (flags & ROW_RESET) {
+                bids_.clear();
+                asks_.clear();
+                synced_ = true;
+            }
+            int64_t price = books.columns.price[row];
+            int64_t quantity = books.columns.quantity[row];
+            if (price != 0 || quantity != 0) {
+                if (flags & ROW_ASK) {
+                    quantity > 0 ? void(asks_[price] = quantity) : void(asks_.erase(price));
+                } else {
+                    quantity > 0 ? void(bids_[price] = quantity) : void(bids_.erase(price));
+                }
+            }
+            end = (flags & ROW_END) != 0;
+        }
+
+        // Deltas before the first snapshot would build a partial book
+        if (end && synced_ && time >= from_us_) {
+            publish(time);
+            event.kind = Event::Kind::BOOK;
+            event.time_us = time;
+            event.book = &book_;
+            return true;
+        }
+    }
+}
+
+void BookStoreReplay::publish(int64_t time_us) {
+    book_.bids.clear();
+    book_.asks.clear();
+    for (const auto& [price, quantity] : bids_) {
+        if (static_cast<int>(book_.bids.size()) >= depth_) {
+            break;
+        }
+        book_.bids.emplace_back(price / reader_.price_scale(), quantity / reader_.quantity_scale());
+    }
+    for (const auto& [price, quantity] : asks_) {
+        if (static_cast<int>(book_.asks.size()) >= depth_) {
+            break;
+        }
+        book_.asks.emplace_back(price / reader_.price_scale(), quantity / reader_.quantity_scale());
+    }
+    book_.exchange_time_ms = time_us / 1000;
+    book_.timestamp = std::chrono::steady_clock::now();
+}
+
+} // namespace MarketMaker
@@ -3,6 +3,8 @@
 #include <fstream>
 #include <iostream>
 #include <cstdlib>
+#include <algorithm>
+#include <cctype>
 
 namespace MarketMaker {
 
@@ -29,6 +31,16 @@ std::optional<Config> ConfigLoader::load_from_file(const std::string& filename)
         if (root.isMember("api")) {
             config.api_key = root["api"]["key"].asString();
             config.api_secret = root["api"]["secret"].asString();
+
+            if (root["api"].isMember("sub_accounts") && root["api"]["sub_accounts"].isArray()) {
+                for (const auto& account : root["api"]["sub_accounts"]) {
+                    SubAccount sub;
+                    sub.name = account.get("name", "sub" + std::to_string(config.sub_accounts.size() + 1)).asString();
+                    sub.api_key = account["key"].asString();
+                    sub.api_secret = account["secret"].asString();
+                    config.sub_accounts.push_back(sub);
+                }
+            }
         }
 
         // Trading parameters
@@ -37,6 +49,27 @@ std::optional<Config> ConfigLoader::load_from_file(const std::string& filename)
             config.order_size = root["trading"]["order_size"].asDouble();
             config.spread_percentage = root["trading"]["spread_percentage"].asDouble();
 
+            if (root["trading"].isMember("quote_placement")) {
+                const auto& placement = root["trading"]["quote_placement"];
+                config.quote_placement = placement.get("mode", config.quote_placement).asString();
+                config.placement_depth = placement.get("depth", config.placement_depth).asInt();
+                config.improve_min_spread_ticks =
+                    placement.get("improve_min_spread_ticks", config.improve_min_spread_ticks).asInt();
+                config.placement_wall_size = placement.get("wall_size", config.placement_wall_size).asDouble();
+            }
+            if (root["trading"].isMember("post_only")) {
+                config.post_only = root["trading"]["post_only"].asBool();
+            }
+            if (root["trading"].isMember("inventory_skew")) {
+                config.inventory_skew = root["trading"]["inventory_skew"].asDouble();
+            }
+            if (root["trading"].isMember("queue_keep_max_ahead")) {
+                config.queue_keep_max_ahead = root["trading"]["queue_keep_max_ahead"].asDouble();
+            }
+            if (root["trading"].isMember("queue_keep_max_drift")) {
+                config.queue_keep_max_drift = root["trading"]["queue_keep_max_drift"].asDouble();
+            }
+
             // Load base and quote assets
             if (root["trading"].isMember("base_asset")) {
                 config.base_asset = root["trading"]["base_asset"].asString();
@@ -77,6 +110,24 @@ std::optional<Config> ConfigLoader::load_from_file(const std::string& filename)
                 config.use_websocket_trading = root["exchange"]["use_websocket_trading"].asBool();
             }
 
+            if (root["exchange"].isMember("order_response_type")) {
+                config.order_response_type = root["exchange"]["order_response_type"].asString();
+                std::transform(config.order_response_type.begin(), config.order_response_type.end(),
+                               config.order_response_type.begin(), ::toupper);
+            }
+            if (root["exchange"].isMember("user_data_stream")) {
+                config.use_user_data_stream = root["exchange"]["user_data_stream"].asBool();
+            }
+            if (root["exchange"].isMember("shard_by")) {
+                config.shard_by = root["exchange"]["shard_by"].asString();
+            }
+            if (root["exchange"].isMember("replay_file")) {
+                config.replay_file = root["exchange"]["replay_file"].asString();
+            }
+            if (root["exchange"].isMember("replay_speed")) {
+                config.replay_speed = root["exchange"]["replay_speed"].asDouble();
+            }
+
             // Check for testnet setting
             if (root["exchange"].isMember("testnet")) {
                 config.use_testnet = root["exchange"]["testnet"].asBool();
@@ -93,12 +144,230 @@ std::optional<Config> ConfigLoader::load_from_file(const std::string& filename)
             );
             config.max_reconnect_attempts = root["performance"]["max_reconnect_attempts"].asInt();
             config.max_orders_per_second = root["performance"]["max_orders_per_second"].asInt();
+            if (root["performance"].isMember("inline_strategy")) {
+                config.inline_strategy = root["performance"]["inline_strategy"].asBool();
+            }
+            if (root["performance"].isMember("strategy_cpu")) {
+                config.strategy_cpu = root["performance"]["strategy_cpu"].asInt();
+            }
+            if (root["performance"].isMember("hot_reload")) {
+                config.hot_reload = root["performance"]["hot_reload"].asBool();
+            }
+            if (root["performance"].isMember("quote_cache_ticks")) {
+                config.quote_cache_ticks = root["performance"]["quote_cache_ticks"].asInt();
+            }
+            if (root["performance"].isMember("fill_requote_cooldown_ms")) {
+                config.fill_requote_cooldown = std::chrono::milliseconds(
+                    root["performance"]["fill_requote_cooldown_ms"].asInt()
+                );
+            }
+            if (root["performance"].isMember("max_cancels_per_second")) {
+                config.max_cancels_per_second = root["performance"]["max_cancels_per_second"].asInt();
+            }
+            if (root["performance"].isMember("shared_rate_limit")) {
+                config.shared_rate_limit = root["performance"]["shared_rate_limit"].asBool();
+            }
+            if (root["performance"].isMember("order_scheduler_workers")) {
+                config.order_scheduler_workers = root["performance"]["order_scheduler_workers"].asInt();
+            }
+        }
+
+        // Network settings
+        if (root.isMember("network")) {
+            const Json::Value& network = root["network"];
+            if (network.isMember("ktls")) {
+                config.use_ktls = network["ktls"].asBool();
+            }
+            if (network.isMember("tcp_nodelay")) {
+                config.socket_profile.tcp_nodelay = network["tcp_nodelay"].asBool();
+            }
+            if (network.isMember("tcp_quickack")) {
+                config.socket_profile.tcp_quickack = network["tcp_quickack"].asBool();
+            }
+            if (network.isMember("busy_poll_us")) {
+                config.socket_profile.busy_poll_us = network["busy_poll_us"].asInt();
+            }
+            if (network.isMember("rcvbuf_bytes")) {
+                config.socket_profile.rcvbuf_bytes = network["rcvbuf_bytes"].asInt();
+            }
+            if (network.isMember("sndbuf_bytes")) {
+                config.socket_profile.sndbuf_bytes = network["sndbuf_bytes"].asInt();
+            }
+            if (network.isMember("ip_tos")) {
+                config.socket_profile.ip_tos = network["ip_tos"].asInt();
+            }
+            if (network.isMember("io_timeout_ms")) {
+                config.socket_profile.io_timeout_ms = network["io_timeout_ms"].asInt();
+            }
+        }
+
+        // Error handling (optional section)
+        if (root.isMember("errors")) {
+            const Json::Value& errors = root["errors"];
+            if (errors.isMember("pause_ms")) {
+                config.error_pause_ms = errors["pause_ms"].asInt();
+            }
+            if (errors.isMember("side_disable_ms")) {
+                config.side_disable_ms = errors["side_disable_ms"].asInt();
+            }
+            if (errors.isMember("policies") && errors["policies"].isObject()) {
+                // "-1003": "pause_all" or "-2010": {"action": "disable_side", "match": "..."}
+                const Json::Value& policies = errors["policies"];
+                for (const auto& code : policies.getMemberNames()) {
+                    const Json::Value& entry = policies[code];
+                    ErrorPolicy policy;
+                    if (entry.isString()) {
+                        policy.action = OrderErrorTracker::parse_action(entry.asString());
+                    } else {
+                        policy.action = OrderErrorTracker::parse_action(entry["action"].asString());
+                        policy.match = entry["match"].asString();
+                    }
+                    config.error_policies[std::stoi(code)] = policy;
+                }
+            }
+        }
+
+        // Latency probes (optional section)
+        if (root.isMember("latency_probe")) {
+            const Json::Value& probe = root["latency_probe"];
+            if (probe.isMember("enabled")) {
+                config.latency_probe.enabled = probe["enabled"].asBool();
+            }
+            if (probe.isMember("interval_ms")) {
+                config.latency_probe.interval = std::chrono::milliseconds(probe["interval_ms"].asInt());
+            }
+            if (probe.isMember("order_test_every")) {
+                config.latency_probe.order_test_every = probe["order_test_every"].asInt();
+            }
+            if (probe.isMember("weight_per_minute")) {
+                config.latency_probe.weight_per_minute = probe["weight_per_minute"].asInt();
+            }
+        }
+
+        // Cross-venue fair value (optional section)
+        if (root.isMember("fair_value")) {
+            const Json::Value& fair = root["fair_value"];
+            if (fair.isMember("enabled")) {
+                config.fair_value.enabled = fair["enabled"].asBool();
+            }
+            if (fair.isMember("venues") && fair["venues"].isArray()) {
+                config.fair_value.venues.clear();
+                for (const auto& venue : fair["venues"]) {
+                    config.fair_value.venues.push_back(venue.asString());
+                }
+            }
+            if (fair.isMember("half_life_ms")) {
+                config.fair_value.half_life = std::chrono::milliseconds(fair["half_life_ms"].asInt());
+            }
+            if (fair.isMember("max_age_ms")) {
+                config.fair_value.max_age = std::chrono::milliseconds(fair["max_age_ms"].asInt());
+            }
+            if (fair.isMember("basis_alpha")) {
+                config.fair_value.basis_alpha = fair["basis_alpha"].asDouble();
+            }
+        }
+
+        // Lead-lag leaders (optional section)
+        if (root.isMember("lead_lag")) {
+            const Json::Value& lead_lag = root["lead_lag"];
+            if (lead_lag.isMember("enabled")) {
+                config.lead_lag.enabled = lead_lag["enabled"].asBool();
+            }
+            if (lead_lag.isMember("leaders") && lead_lag["leaders"].isArray()) {
+                config.lead_lag.leaders.clear();
+                for (const auto& leader : lead_lag["leaders"]) {
+                    config.lead_lag.leaders.push_back(leader.asString());
+                }
+            }
+            if (lead_lag.isMember("alpha")) {
+                config.lead_lag.alpha = lead_lag["alpha"].asDouble();
+            }
+            if (lead_lag.isMember("min_samples")) {
+                config.lead_lag.min_samples = lead_lag["min_samples"].asInt();
+            }
+            if (lead_lag.isMember("max_beta")) {
+                config.lead_lag.max_beta = lead_lag["max_beta"].asDouble();
+            }
+            if (lead_lag.isMember("max_shift_bps")) {
+                config.lead_lag.max_shift_bps = lead_lag["max_shift_bps"].asDouble();
+            }
+        }
+
+        // Flight recorder (optional section)
+        if (root.isMember("flight_recorder")) {
+            const Json::Value& recorder = root["flight_recorder"];
+            auto& flight = config.flight_recorder;
+            if (recorder.isMember("enabled")) {
+                flight.enabled = recorder["enabled"].asBool();
+            }
+            if (recorder.isMember("capacity")) {
+                flight.capacity = recorder["capacity"].asUInt();
+            }
+            if (recorder.isMember("window_ms")) {
+                flight.window = std::chrono::milliseconds(recorder["window_ms"].asInt());
+            }
+            if (recorder.isMember("dump_dir")) {
+                flight.dump_dir = recorder["dump_dir"].asString();
+            }
+            if (recorder.isMember("ack_timeout_ms")) {
+                flight.ack_timeout_us = recorder["ack_timeout_ms"].asInt64() * 1000;
+            }
+            if (recorder.isMember("reject_storm_count")) {
+                flight.reject_storm_count = recorder["reject_storm_count"].asInt();
+            }
+            if (recorder.isMember("reject_storm_window_ms")) {
+                flight.reject_storm_window = std::chrono::milliseconds(recorder["reject_storm_window_ms"].asInt());
+            }
+            if (recorder.isMember("dump_on_disconnect")) {
+                flight.dump_on_disconnect = recorder["dump_on_disconnect"].asBool();
+            }
+            if (recorder.isMember("dump_on_pull")) {
+                flight.dump_on_pull = recorder["dump_on_pull"].asBool();
+            }
+            if (recorder.isMember("post_trigger_ms")) {
+                flight.post_trigger = std::chrono::milliseconds(recorder["post_trigger_ms"].asInt());
+            }
+            if (recorder.isMember("min_dump_interval_ms")) {
+                flight.min_dump_interval = std::chrono::milliseconds(recorder["min_dump_interval_ms"].asInt());
+            }
+        }
+
+        // Latency SLOs (optional section)
+        if (root.isMember("latency_slo")) {
+            const Json::Value& slo = root["latency_slo"];
+            if (slo.isMember("enabled")) {
+                config.latency_slo.enabled = slo["enabled"].asBool();
+            }
+            if (slo.isMember("percentile")) {
+                config.latency_slo.percentile = slo["percentile"].asDouble();
+            }
+            if (slo.isMember("feed_ms")) {
+                config.latency_slo.feed_slo_us = static_cast<int64_t>(slo["feed_ms"].asDouble() * 1000);
+            }
+            if (slo.isMember("ack_ms")) {
+                config.latency_slo.ack_slo_us = static_cast<int64_t>(slo["ack_ms"].asDouble() * 1000);
+            }
+            if (slo.isMember("window_ms")) {
+                config.latency_slo.window = std::chrono::milliseconds(slo["window_ms"].asInt());
+            }
+            if (slo.isMember("hold_ms")) {
+                config.latency_slo.hold = std::chrono::milliseconds(slo["hold_ms"].asInt());
+            }
+            if (slo.isMember("widen_factor")) {
+                config.latency_slo.widen_factor = slo["widen_factor"].asDouble();
+            }
+            if (slo.isMember("shrink_factor")) {
+                config.latency_slo.shrink_factor = slo["shrink_factor"].asDouble();
+            }
         }
 
         // Logging settings
         if (root.isMember("logging")) {
             config.enable_verbose_logging = root["logging"]["verbose"].asBool();
             config.log_file = root["logging"]["file"].asString();
+            if (root["logging"].isMember("decision_journal")) {
+                config.decision_journal = root["logging"]["decision_journal"].asString();
+            }
         }
 
         // Merge with environment variables (env vars take priority)
@@ -123,11 +392,26 @@ bool ConfigLoader::save_to_file(const Config& config, const std::string& filenam
     // API section (mask the secret for security)
     root["api"]["key"] = config.api_key.empty() ? "YOUR_API_KEY_HERE" : mask_secret(config.api_key);
     root["api"]["secret"] = config.api_secret.empty() ? "YOUR_API_SECRET_HERE" : mask_secret(config.api_secret);
+    for (const auto& sub : config.sub_accounts) {
+        Json::Value account;
+        account["name"] = sub.name;
+        account["key"] = mask_secret(sub.api_key);
+        account["secret"] = mask_secret(sub.api_secret);
+        root["api"]["sub_accounts"].append(account);
+    }
 
     // Trading section
     root["trading"]["symbol"] = config.symbol;
     root["trading"]["order_size"] = config.order_size;
     root["trading"]["spread_percentage"] = config.spread_percentage;
+    root["trading"]["quote_placement"]["mode"] = config.quote_placement;
+    root["trading"]["quote_placement"]["depth"] = config.placement_depth;
+    root["trading"]["quote_placement"]["improve_min_spread_ticks"] = config.improve_min_spread_ticks;
+    root["trading"]["quote_placement"]["wall_size"] = config.placement_wall_size;
+    root["trading"]["post_only"] = config.post_only;
+    root["trading"]["inventory_skew"] = config.inventory_skew;
+    root["trading"]["queue_keep_max_ahead"] = config.queue_keep_max_ahead;
+    root["trading"]["queue_keep_max_drift"] = config.queue_keep_max_drift;
 
     // Exchange section
     root["exchange"]["name"] = config.exchange_type;
@@ -135,19 +419,104 @@ bool ConfigLoader::save_to_file(const Config& config, const std::string& filenam
     root["exchange"]["rest_url"] = config.rest_base_url;
     root["exchange"]["ws_trading_url"] = config.ws_trading_url;
     root["exchange"]["use_websocket_trading"] = config.use_websocket_trading;
+    root["exchange"]["user_data_stream"] = config.use_user_data_stream;
+    root["exchange"]["order_response_type"] = config.order_response_type;
+    root["exchange"]["shard_by"] = config.shard_by;
+    root["exchange"]["replay_file"] = config.replay_file;
+    root["exchange"]["replay_speed"] = config.replay_speed;
     root["exchange"]["testnet"] = config.use_testnet;
 
     // Performance section
     root["performance"]["order_update_cooldown_ms"] = static_cast<int>(config.order_update_cooldown.count());
+    root["performance"]["quote_cache_ticks"] = config.quote_cache_ticks;
+    root["performance"]["inline_strategy"] = config.inline_strategy;
+    root["performance"]["strategy_cpu"] = config.strategy_cpu;
+    root["performance"]["hot_reload"] = config.hot_reload;
+    root["performance"]["fill_requote_cooldown_ms"] = static_cast<int>(config.fill_requote_cooldown.count());
     root["performance"]["reconnect_delay_ms"] = static_cast<int>(config.reconnect_delay.count());
     root["performance"]["max_reconnect_attempts"] = config.max_reconnect_attempts;
     root["performance"]["max_orders_per_second"] = config.max_orders_per_second;
+    root["performance"]["max_cancels_per_second"] = config.max_cancels_per_second;
+    root["performance"]["shared_rate_limit"] = config.shared_rate_limit;
+    root["performance"]["order_scheduler_workers"] = config.order_scheduler_workers;
+
+    // Network section
+    root["network"]["ktls"] = config.use_ktls;
+    root["network"]["tcp_nodelay"] = config.socket_profile.tcp_nodelay;
+    root["network"]["tcp_quickack"] = config.socket_profile.tcp_quickack;
+    root["network"]["busy_poll_us"] = config.socket_profile.busy_poll_us;
+    root["network"]["rcvbuf_bytes"] = config.socket_profile.rcvbuf_bytes;
+    root["network"]["sndbuf_bytes"] = config.socket_profile.sndbuf_bytes;
+    root["network"]["ip_tos"] = config.socket_profile.ip_tos;
+    root["network"]["io_timeout_ms"] = config.socket_profile.io_timeout_ms;
+
+    // Errors section
+    root["errors"]["pause_ms"] = config.error_pause_ms;
+    root["errors"]["side_disable_ms"] = config.side_disable_ms;
+    for (const auto& [code, policy] : config.error_policies) {
+        Json::Value entry;
+        entry["action"] = OrderErrorTracker::action_name(policy.action);
+        entry["match"] = policy.match;
+        root["errors"]["policies"][std::to_string(code)] = entry;
+    }
+
+    // Latency probe section
+    root["latency_probe"]["enabled"] = config.latency_probe.enabled;
+    root["latency_probe"]["interval_ms"] = static_cast<int>(config.latency_probe.interval.count());
+    root["latency_probe"]["order_test_every"] = config.latency_probe.order_test_every;
+    root["latency_probe"]["weight_per_minute"] = config.latency_probe.weight_per_minute;
+
+    // Fair value section
+    root["fair_value"]["enabled"] = config.fair_value.enabled;
+    root["fair_value"]["venues"] = Json::Value(Json::arrayValue);
+    for (const auto& venue : config.fair_value.venues) {
+        root["fair_value"]["venues"].append(venue);
+    }
+    root["fair_value"]["half_life_ms"] = static_cast<int>(config.fair_value.half_life.count());
+    root["fair_value"]["max_age_ms"] = static_cast<int>(config.fair_value.max_age.count());
+    root["fair_value"]["basis_alpha"] = config.fair_value.basis_alpha;
+
+    // Flight recorder section
+    const auto& flight = config.flight_recorder;
+    root["flight_recorder"]["enabled"] = flight.enabled;
+    root["flight_recorder"]["capacity"] = static_cast<Json::UInt64>(flight.capacity);
+    root["flight_recorder"]["window_ms"] = static_cast<int>(flight.window.count());
+    root["flight_recorder"]["dump_dir"] = flight.dump_dir;
+    root["flight_recorder"]["ack_timeout_ms"] = static_cast<Json::Int64>(flight.ack_timeout_us / 1000);
+    root["flight_recorder"]["reject_storm_count"] = flight.reject_storm_count;
+    root["flight_recorder"]["reject_storm_window_ms"] = static_cast<int>(flight.reject_storm_window.count());
+    root["flight_recorder"]["dump_on_disconnect"] = flight.dump_on_disconnect;
+    root["flight_recorder"]["dump_on_pull"] = flight.dump_on_pull;
+    root["flight_recorder"]["post_trigger_ms"] = static_cast<int>(flight.post_trigger.count());
+    root["flight_recorder"]["min_dump_interval_ms"] = static_cast<int>(flight.min_dump_interval.count());
+
+    // Lead-lag section
+    root["lead_lag"]["enabled"] = config.lead_lag.enabled;
+    root["lead_lag"]["leaders"] = Json::Value(Json::arrayValue);
+    for (const auto& leader : config.lead_lag.leaders) {
+        root["lead_lag"]["leaders"].append(leader);
+    }
+    root["lead_lag"]["alpha"] = config.lead_lag.alpha;
+    root["lead_lag"]["min_samples"] = config.lead_lag.min_samples;
+    root["lead_lag"]["max_beta"] = config.lead_lag.max_beta;
+    root["lead_lag"]["max_shift_bps"] = config.lead_lag.max_shift_bps;
+
+    // Latency SLO section
+    root["latency_slo"]["enabled"] = config.latency_slo.enabled;
+    root["latency_slo"]["percentile"] = config.latency_slo.percentile;
+    root["latency_slo"]["feed_ms"] = config.latency_slo.feed_slo_us / 1000.0;
+    root["latency_slo"]["ack_ms"] = config.latency_slo.ack_slo_us / 1000.0;
+    root["latency_slo"]["window_ms"] = static_cast<int>(config.latency_slo.window.count());
+    root["latency_slo"]["hold_ms"] = static_cast<int>(config.latency_slo.hold.count());
+    root["latency_slo"]["widen_factor"] = config.latency_slo.widen_factor;
+    root["latency_slo"]["shrink_factor"] = config.latency_slo.shrink_factor;
 
     // Logging section
     root["logging"]["enabled"] = true;
     root["logging"]["verbose"] = config.enable_verbose_logging;
     root["logging"]["file"] = config.log_file;
     root["logging"]["level"] = "INFO";
+    root["logging"]["decision_journal"] = config.decision_journal;
 
     // Write to file
     std::ofstream file(filename);
@@ -166,17 +535,18 @@ bool ConfigLoader::save_to_file(const Config& config, const std::string& filenam
 
 bool ConfigLoader::validate(const Config& config) {
     bool valid = true;
+    const bool offline = config.exchange_type == "mock";  // No credentials or URLs
 
     // Check API credentials
-    if (config.api_key.empty() || config.api_key == "YOUR_BINANCE_API_KEY_HERE" ||
-        config.api_key == "YOUR_TESTNET_API_KEY_HERE") {
+    if (!offline && (config.api_key.empty() || config.api_key == "YOUR_BINANCE_API_KEY_HERE" ||
+                     config.api_key == "YOUR_TESTNET_API_KEY_HERE")) {
         std::cerr << "Error: API key is not configured" << std::endl;
         std::cerr << "Please edit the config file and add your Binance API key" << std::endl;
         valid = false;
     }
 
-    if (config.api_secret.empty() || config.api_secret == "YOUR_BINANCE_API_SECRET_HERE" ||
-        config.api_secret == "YOUR_TESTNET_API_SECRET_HERE") {
+    if (!offline && (config.api_secret.empty() || config.api_secret == "YOUR_BINANCE_API_SECRET_HERE" ||
+                     config.api_secret == "YOUR_TESTNET_API_SECRET_HERE")) {
         std::cerr << "Error: API secret is not configured" << std::endl;
         std::cerr << "Please edit the config file and add your Binance API secret" << std::endl;
         valid = false;
@@ -199,8 +569,25 @@ bool ConfigLoader::validate(const Config& config) {
         valid = false;
     }
 
+    if (config.order_response_type != "ACK" && config.order_response_type != "RESULT" &&
+        config.order_response_type != "FULL") {
+        std::cerr << "Error: Invalid order_response_type: " << config.order_response_type << std::endl;
+        std::cerr << "Use ACK, RESULT or FULL" << std::endl;
+        valid = false;
+    }
+
+    if (offline && config.replay_file.empty()) {
+        std::cerr << "Error: The mock exchange needs exchange.replay_file for market data" << std::endl;
+        valid = false;
+    }
+
+    if (config.replay_speed < 0) {
+        std::cerr << "Error: Invalid replay_speed: " << config.replay_speed << std::endl;
+        valid = false;
+    }
+
     // Check URLs
-    if (config.ws_base_url.empty() || config.rest_base_url.empty()) {
+    if (!offline && (config.ws_base_url.empty() || config.rest_base_url.empty())) {
         std::cerr << "Error: Exchange URLs are not configured" << std::endl;
         valid = false;
     }
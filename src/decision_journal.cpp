@@ -0,0 +1,132 @@
+#include "decision_journal.h"
+#include <cstring>
+#include <iostream>
+
+namespace MarketMaker {
+
+namespace {
+
+constexpr size_t WRITE_BUFFER = 1 << 20;
+
+struct JournalHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entry_size;
+    uint32_t reserved;
+};
+
+} // namespace
+
+DecisionJournal::~DecisionJournal() {
+    close();
+}
+
+bool DecisionJournal::open(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) {
+        std::cerr << "[JOURNAL] Cannot open " << path << std::endl;
+        return false;
+    }
+    std::setvbuf(file_, nullptr, _IOFBF, WRITE_BUFFER);
+
+    JournalHeader header{MAGIC, VERSION, static_cast<uint32_t>(sizeof(JournalEntry)), 0};
+    std::fwrite(&header, sizeof(header), 1, file_);
+    next_seq_ = 0;
+
+    std::cout << "[JOURNAL] Recording decisions to " << path << std::endl;
+    return true;
+}
+
+void DecisionJournal::close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (file_) {
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+}
+
+void DecisionJournal::record(JournalEntry entry) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!file_) {
+        return;
+    }
+    entry.seq = next_seq_++;
+    std::fwrite(&entry, sizeof(entry), 1, file_);
+}
+
+std::optional<std::vector<JournalEntry>> DecisionJournal::read(const std::string& path, std::string* error) {
+    auto fail = [error](const std::string& message) -> std::optional<std::vector<JournalEntry>> {
+        if (error) {
+            *error = message;
+        }
+        return std::nullopt;
+    };
+
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        return fail("cannot open " + path);
+    }
+
+    JournalHeader header{};
+    if (std::fread(&header, sizeof(header), 1, file) != 1 || header.magic != MAGIC) {
+        std::fclose(file);
+        return fail(path + " is not a decision journal");
+    }
+    if (header.version != VERSION || header.entry_size != sizeof(JournalEntry)) {
+        std::fclose(file);
+        return fail(path + ": unsupported journal version " + std::to_string(header.version));
+    }
+
+    std::vector<JournalEntry> entries;
+    JournalEntry entry;
+    while (std::fread(&entry, sizeof(entry), 1, file) == 1) {
+        entries.push_back(entry);
+    }
+    std::fclose(file);
+    return entries;
+}
+
+uint64_t DecisionJournal::hash(uint64_t seed, double value) {
+    unsigned char bytes[sizeof(double)];
+    std::memcpy(bytes, &value, sizeof(value));
+    for (unsigned char byte : bytes) {
+        seed ^= byte;
+        seed *= 1099511628211ULL;
+    }
+    return seed;
+}
+
+const char* DecisionJournal::action_name(uint8_t action) {
+    switch (static_cast<JournalAction>(action)) {
+        case JournalAction::INVALID_INPUT: return "invalid_input";
+        case JournalAction::PULLED: return "pulled";
+        case JournalAction::SKIP: return "skip";
+        case JournalAction::KEEP: return "keep";
+        case JournalAction::REPLACE_BID: return "replace_bid";
+        case JournalAction::REPLACE_ASK: return "replace_ask";
+        case JournalAction::REPLACE_BOTH: return "replace_both";
+        case JournalAction::FILL_REQUOTE: return "fill_requote";
+        case JournalAction::FILL_SKIP: return "fill_skip";
+    }
+    return "unknown";
+}
+
+std::string DecisionJournal::reason_names(uint16_t reasons) {
+    static const char* const NAMES[] = {
+        "no_active_orders", "price_moved", "below_threshold", "keep_bid_queue", "keep_ask_queue",
+        "slo_pulled", "slo_scaled", "quote_cache", "inventory_skew", "placement", "fill",
+        "fill_cooldown", "bid", "ask"
+    };
+
+    std::string names;
+    for (size_t bit = 0; bit < sizeof(NAMES) / sizeof(NAMES[0]); ++bit) {
+        if (reasons & (1u << bit)) {
+            names += names.empty() ? "" : "|";
+            names += NAMES[bit];
+        }
+    }
+    return names.empty() ? "-" : names;
+}
+
+} // namespace MarketMaker
@@ -0,0 +1,25 @@
+#include "exchange_clock.h"
+#include <iostream>
+
+namespace MarketMaker {
+
+int64_t ExchangeClock::local_ms() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+void ExchangeClock::update(int64_t server_time_ms, int64_t sent_ms, int64_t received_ms) {
+    int64_t midpoint = sent_ms + (received_ms - sent_ms) / 2;
+    int64_t offset = server_time_ms - midpoint;
+    int64_t previous = offset_ms_.exchange(offset, std::memory_order_relaxed);
+
+    std::cout << "[CLOCK] Exchange offset " << offset << " ms (was " << previous
+              << " ms, RTT " << (received_ms - sent_ms) << " ms)" << std::endl;
+}
+
+std::chrono::steady_clock::time_point ExchangeClock::to_steady(int64_t exchange_ms) const {
+    auto remaining = std::chrono::milliseconds(exchange_ms - now_ms());
+    return std::chrono::steady_clock::now() + remaining;
+}
+
+} // namespace MarketMaker
@@ -1,6 +1,9 @@
 #include "exchange_factory.h"
 #include "binance_exchange.h"
 #include "websocket_trading_adapter.h"
+#include "sharded_exchange.h"
+#include "okx_exchange.h"
+#include "mock_exchange.h"
 // Include other exchange implementations here as they're created
 // #include "coinbase_exchange.h"
 // #include "kraken_exchange.h"
@@ -21,6 +24,18 @@ namespace {
                 []() { return std::make_shared<BinanceExchange>(); }
             );
 
+            // OKX: public market data only (reference venue for fair value)
+            ExchangeFactory::instance().register_exchange(
+                "okx",
+                []() { return std::make_shared<OkxExchange>(); }
+            );
+
+            // In-memory exchange fed by push_orderbook(), for offline runs
+            ExchangeFactory::instance().register_exchange(
+                "mock",
+                []() { return std::make_shared<MockExchange>(); }
+            );
+
             // Register other exchanges as they're implemented
             // ExchangeFactory::instance().register_exchange(
             //     "coinbase",
@@ -36,7 +51,6 @@ namespace {
             ExchangeFactory::instance().register_exchange("coinbase", placeholder_creator);
             ExchangeFactory::instance().register_exchange("kraken", placeholder_creator);
             ExchangeFactory::instance().register_exchange("bybit", placeholder_creator);
-            ExchangeFactory::instance().register_exchange("okx", placeholder_creator);
             ExchangeFactory::instance().register_exchange("bitget", placeholder_creator);
             ExchangeFactory::instance().register_exchange("kucoin", placeholder_creator);
         }
@@ -47,6 +61,40 @@ namespace {
 }
 
 std::shared_ptr<IExchange> ExchangeFactory::create(const ExchangeConfig& config) {
+    // One exchange instance per credential set, behind a router
+    if (!config.sub_accounts.empty()) {
+        ExchangeConfig account_config = config;
+        account_config.sub_accounts.clear();
+
+        std::vector<ShardedExchange::Shard> shards;
+        std::vector<std::string> api_keys{config.api_key};
+        auto main_exchange = create(account_config);
+        if (!main_exchange) {
+            return nullptr;
+        }
+        shards.push_back({"main", main_exchange});
+
+        for (const auto& account : config.sub_accounts) {
+            account_config.api_key = account.api_key;
+            account_config.api_secret = account.api_secret;
+            auto exchange = create(account_config);
+            if (!exchange) {
+                std::cerr << "Failed to create sub-account " << account.name << std::endl;
+                return nullptr;
+            }
+            shards.push_back({account.name, exchange});
+            api_keys.push_back(account.api_key);
+        }
+
+        std::cout << "Sharding order entry over " << shards.size() << " accounts by "
+                  << config.shard_by << std::endl;
+        auto sharded = std::make_shared<ShardedExchange>(
+            std::move(shards), ShardedExchange::parse_policy(config.shard_by), config.max_orders_per_second,
+            api_keys, config.shared_rate_label);
+        sharded->initialize(config);
+        return sharded;
+    }
+
     std::string normalized_name = normalize_exchange_name(config.exchange_type);
 
     // Check if WebSocket trading is requested for Binance
@@ -60,7 +108,8 @@ std::shared_ptr<IExchange> ExchangeFactory::create(const ExchangeConfig& config)
             config.ws_trading_url
         );
 
-        // The adapter doesn't need initialize() call as it initializes in constructor
+        // Clients are created in the constructor; initialize() applies transport options
+        ws_adapter->initialize(config);
         std::cout << "Successfully created Binance WebSocket Trading instance" << std::endl;
         return ws_adapter;
     }
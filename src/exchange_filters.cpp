@@ -0,0 +1,240 @@
+#include "exchange_filters.h"
+#include <json/json.h>
+#include <cmath>
+#include <iostream>
+
+namespace MarketMaker {
+
+namespace {
+
+// exchangeInfo sends decimals as strings and counts as numbers
+double to_double(const Json::Value& value) {
+    if (value.isString()) {
+        try {
+            return std::stod(value.asString());
+        } catch (const std::exception&) {
+            return 0.0;
+        }
+    }
+    return value.isNumeric() ? value.asDouble() : 0.0;
+}
+
+int to_int(const Json::Value& value) {
+    if (value.isString()) {
+        try {
+            return std::stoi(value.asString());
+        } catch (const std::exception&) {
+            return 0;
+        }
+    }
+    return value.isNumeric() ? value.asInt() : 0;
+}
+
+// Decimal places of a step like "0.01000000" (trailing zeros don't count)
+int precision_from_step(const std::string& step) {
+    size_t decimal_pos = step.find('.');
+    if (decimal_pos == std::string::npos) {
+        return 0;
+    }
+    size_t last = step.find_last_not_of('0');
+    if (last == std::string::npos || last <= decimal_pos) {
+        return 0;
+    }
+    return static_cast<int>(last - decimal_pos);
+}
+
+// Relative epsilon: values within a millionth of a step count as on the grid
+constexpr double GRID_EPSILON = 1e-6;
+
+double floor_to_step(double value, double step) {
+    return std::floor(value / step + GRID_EPSILON) * step;
+}
+
+double ceil_to_step(double value, double step) {
+    return std::ceil(value / step - GRID_EPSILON) * step;
+}
+
+bool differs(double a, double b, double step) {
+    return std::abs(a - b) > (step > 0 ? step * GRID_EPSILON : 1e-12);
+}
+
+FilterCheckResult reject(FilterCheckResult result, const char* reason) {
+    result.status = FilterCheckResult::Status::REJECTED;
+    result.reason = reason;
+    return result;
+}
+
+} // namespace
+
+ExchangeFilters ExchangeFilterParser::parse_symbol(const Json::Value& symbol) {
+    ExchangeFilters filters;
+    filters.symbol = symbol["symbol"].asString();
+    filters.status = symbol["status"].asString();
+
+    for (const auto& filter : symbol["filters"]) {
+        std::string type = filter["filterType"].asString();
+
+        if (type == "PRICE_FILTER") {
+            filters.min_price = to_double(filter["minPrice"]);
+            filters.max_price = to_double(filter["maxPrice"]);
+            filters.tick_size = to_double(filter["tickSize"]);
+            filters.price_precision = precision_from_step(filter["tickSize"].asString());
+        } else if (type == "LOT_SIZE") {
+            filters.min_qty = to_double(filter["minQty"]);
+            filters.max_qty = to_double(filter["maxQty"]);
+            filters.step_size = to_double(filter["stepSize"]);
+            filters.quantity_precision = precision_from_step(filter["stepSize"].asString());
+        } else if (type == "MARKET_LOT_SIZE") {
+            filters.market_min_qty = to_double(filter["minQty"]);
+            filters.market_max_qty = to_double(filter["maxQty"]);
+            filters.market_step_size = to_double(filter["stepSize"]);
+        } else if (type == "NOTIONAL") {
+            filters.min_notional = to_double(filter["minNotional"]);
+            filters.max_notional = to_double(filter["maxNotional"]);
+            filters.apply_min_to_market = filter["applyMinToMarket"].asBool();
+            filters.apply_max_to_market = filter["applyMaxToMarket"].asBool();
+            filters.avg_price_mins = to_int(filter["avgPriceMins"]);
+        } else if (type == "MIN_NOTIONAL") {
+            filters.min_notional = to_double(filter["minNotional"]);
+            filters.apply_min_to_market = filter["applyToMarket"].asBool();
+            filters.avg_price_mins = to_int(filter["avgPriceMins"]);
+        } else if (type == "PERCENT_PRICE") {
+            filters.multiplier_up = to_double(filter["multiplierUp"]);
+            filters.multiplier_down = to_double(filter["multiplierDown"]);
+            filters.avg_price_mins = to_int(filter["avgPriceMins"]);
+        } else if (type == "PERCENT_PRICE_BY_SIDE") {
+            filters.bid_multiplier_up = to_double(filter["bidMultiplierUp"]);
+            filters.bid_multiplier_down = to_double(filter["bidMultiplierDown"]);
+            filters.ask_multiplier_up = to_double(filter["askMultiplierUp"]);
+            filters.ask_multiplier_down = to_double(filter["askMultiplierDown"]);
+            filters.avg_price_mins = to_int(filter["avgPriceMins"]);
+        } else if (type == "MAX_NUM_ORDERS") {
+            filters.max_num_orders = to_int(filter["maxNumOrders"]);
+        } else if (type == "MAX_NUM_ALGO_ORDERS") {
+            filters.max_num_algo_orders = to_int(filter["maxNumAlgoOrders"]);
+        } else if (type == "MAX_NUM_ICEBERG_ORDERS") {
+            filters.max_num_iceberg_orders = to_int(filter["maxNumIcebergOrders"]);
+        } else if (type == "ICEBERG_PARTS") {
+            filters.iceberg_parts = to_int(filter["limit"]);
+        } else if (type == "MAX_POSITION") {
+            filters.max_position = to_double(filter["maxPosition"]);
+        }
+        // TRAILING_DELTA only applies to stop orders
+    }
+
+    return filters;
+}
+
+std::map<std::string, ExchangeFilters> ExchangeFilterParser::parse_exchange_info(const Json::Value& root) {
+    std::map<std::string, ExchangeFilters> result;
+
+    if (!root.isMember("symbols")) {
+        std::cerr << "No symbols in exchange info" << std::endl;
+        return result;
+    }
+
+    for (const auto& symbol : root["symbols"]) {
+        ExchangeFilters filters = parse_symbol(symbol);
+        if (!filters.symbol.empty()) {
+            result[filters.symbol] = filters;
+        }
+    }
+
+    return result;
+}
+
+FilterCheckResult ExchangeFilterCheck::check_limit_order(
+    const ExchangeFilters& filters,
+    OrderSide side,
+    double price,
+    double quantity,
+    double reference_price,
+    int open_orders) {
+
+    FilterCheckResult result;
+    result.price = price;
+    result.quantity = quantity;
+
+    if (!filters.is_trading()) {
+        return reject(result, "symbol is not trading");
+    }
+    if (price <= 0 || quantity <= 0) {
+        return reject(result, "non-positive price or quantity");
+    }
+
+    const bool is_buy = side == OrderSide::BUY;
+    const double tick = filters.tick_size;
+    const double step = filters.step_size;
+
+    // PRICE_FILTER tick: round toward the passive side
+    double p = price;
+    if (tick > 0) {
+        p = is_buy ? floor_to_step(p, tick) : ceil_to_step(p, tick);
+    }
+
+    // PERCENT_PRICE(_BY_SIDE): clamp toward the passive side, reject otherwise
+    if (reference_price > 0) {
+        double up = is_buy ? filters.bid_multiplier_up : filters.ask_multiplier_up;
+        double down = is_buy ? filters.bid_multiplier_down : filters.ask_multiplier_down;
+        if (up <= 0) up = filters.multiplier_up;
+        if (down <= 0) down = filters.multiplier_down;
+
+        if (up > 0 && p > reference_price * up) {
+            if (!is_buy) {
+                return reject(result, "SELL price above PERCENT_PRICE limit");
+            }
+            p = tick > 0 ? floor_to_step(reference_price * up, tick) : reference_price * up;
+        }
+        if (down > 0 && p < reference_price * down) {
+            if (is_buy) {
+                return reject(result, "BUY price below PERCENT_PRICE limit");
+            }
+            p = tick > 0 ? ceil_to_step(reference_price * down, tick) : reference_price * down;
+        }
+    }
+
+    // PRICE_FILTER range
+    if ((filters.min_price > 0 && p < filters.min_price) ||
+        (filters.max_price > 0 && p > filters.max_price) || p <= 0) {
+        return reject(result, "price outside PRICE_FILTER range");
+    }
+
+    // LOT_SIZE: only ever shrink the quantity
+    double q = quantity;
+    if (step > 0) {
+        q = floor_to_step(q, step);
+    }
+    if (filters.max_qty > 0 && q > filters.max_qty) {
+        q = step > 0 ? floor_to_step(filters.max_qty, step) : filters.max_qty;
+    }
+
+    // NOTIONAL upper bound: shrink
+    if (filters.max_notional > 0 && p * q > filters.max_notional) {
+        double capped = filters.max_notional / p;
+        q = step > 0 ? floor_to_step(capped, step) : capped;
+    }
+
+    if ((filters.min_qty > 0 && q < filters.min_qty) || q <= 0) {
+        return reject(result, "quantity below LOT_SIZE minimum");
+    }
+
+    // NOTIONAL lower bound: growing the order would add risk, so reject
+    if (filters.min_notional > 0 && p * q < filters.min_notional) {
+        return reject(result, "notional below NOTIONAL minimum");
+    }
+
+    // MAX_NUM_ORDERS
+    if (filters.max_num_orders > 0 && open_orders >= 0 && open_orders >= filters.max_num_orders) {
+        return reject(result, "MAX_NUM_ORDERS reached");
+    }
+
+    result.price = p;
+    result.quantity = q;
+    if (differs(p, price, tick) || differs(q, quantity, step)) {
+        result.status = FilterCheckResult::Status::ADJUSTED;
+        result.reason = "adjusted to exchange filters";
+    }
+    return result;
+}
+
+} // namespace MarketMaker
@@ -0,0 +1,126 @@
+#include "fair_value.h"
+#include <algorithm>
+#include <cmath>
+
+namespace MarketMaker {
+
+FairValueAggregator::FairValueAggregator(const std::vector<std::string>& venues, const FairValueConfig& config)
+    : config_(config) {
+    for (const auto& name : venues) {
+        Venue venue;
+        venue.name = name;
+        venues_.push_back(venue);
+    }
+    if (venues_.empty()) {
+        Venue home;
+        home.name = "home";
+        venues_.push_back(home);
+    }
+    // The home venue is the reference for every basis
+    venues_[0].has_basis = true;
+}
+
+void FairValueAggregator::on_book(size_t venue, const OrderBook& book) {
+    if (book.bids.empty() || book.asks.empty()) {
+        return;
+    }
+
+    auto received = book.timestamp.time_since_epoch().count() != 0 ? book.timestamp
+                                                                     : std::chrono::steady_clock::now();
+    double mid = book.get_mid_price();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (venue >= venues_.size()) {
+        return;
+    }
+    auto& state = venues_[venue];
+    state.mid = mid;
+    state.received = received;
+    state.has_quote = true;
+
+    if (book.exchange_time_ms > 0) {
+        // Includes the offset between our clock and the venue's; NTP keeps
+        // that well under the latencies that matter here
+        int64_t now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        double sample_us = std::max<int64_t>(now_ms - book.exchange_time_ms, 0) * 1000.0;
+        state.latency_us = state.has_latency ? state.latency_us + LATENCY_ALPHA * (sample_us - state.latency_us)
+                                             : sample_us;
+        state.has_latency = true;
+    }
+
+    // Sample the basis of every venue against home whenever either side moves
+    const auto& home = venues_[0];
+    if (!home.has_quote) {
+        return;
+    }
+    if (venue == 0) {
+        for (size_t i = 1; i < venues_.size(); ++i) {
+            if (venues_[i].has_quote) {
+                update_basis(venues_[i], home.mid);
+            }
+        }
+    } else {
+        update_basis(state, home.mid);
+    }
+}
+
+void FairValueAggregator::update_basis(Venue& venue, double home_mid) {
+    double sample = venue.mid - home_mid;
+    venue.basis = venue.has_basis ? venue.basis + config_.basis_alpha * (sample - venue.basis) : sample;
+    venue.has_basis = true;
+}
+
+double FairValueAggregator::weight(const Venue& venue, std::chrono::steady_clock::time_point now) const {
+    if (!venue.has_quote || !venue.has_basis) {
+        return 0.0;
+    }
+
+    double age_us = std::chrono::duration<double, std::micro>(now - venue.received).count();
+    if (age_us > std::chrono::duration<double, std::micro>(config_.max_age).count()) {
+        return 0.0;
+    }
+
+    double effective_us = std::max(age_us, 0.0) + venue.latency_us;
+    double half_life_us = std::max<double>(
+        std::chrono::duration<double, std::micro>(config_.half_life).count(), 1.0);
+    return std::exp2(-effective_us / half_life_us);
+}
+
+std::optional<double> FairValueAggregator::fair_value(std::chrono::steady_clock::time_point now) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    double weighted = 0.0;
+    double total = 0.0;
+    for (const auto& venue : venues_) {
+        double w = weight(venue, now);
+        weighted += w * (venue.mid - venue.basis);
+        total += w;
+    }
+
+    if (total <= 0.0) {
+        return std::nullopt;
+    }
+    return weighted / total;
+}
+
+std::vector<VenueQuote> FairValueAggregator::get_quotes(std::chrono::steady_clock::time_point now) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::vector<VenueQuote> quotes;
+    for (const auto& venue : venues_) {
+        VenueQuote quote;
+        quote.venue = venue.name;
+        quote.mid = venue.mid;
+        quote.basis = venue.basis;
+        quote.latency_us = static_cast<int64_t>(venue.latency_us);
+        if (venue.has_quote) {
+            quote.age_us = std::chrono::duration_cast<std::chrono::microseconds>(now - venue.received).count();
+        }
+        quote.weight = weight(venue, now);
+        quotes.push_back(quote);
+    }
+    return quotes;
+}
+
+} // namespace MarketMaker
@@ -0,0 +1,277 @@
+#include "flight_recorder.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace MarketMaker {
+
+namespace {
+
+int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+const char* type_name(FlightEventType type) {
+    switch (type) {
+        case FlightEventType::BOOK_TOP: return "book_top";
+        case FlightEventType::DECISION: return "decision";
+        case FlightEventType::ORDER_SENT: return "order_sent";
+        case FlightEventType::ORDER_ACK: return "order_ack";
+        case FlightEventType::ORDER_FAILED: return "order_failed";
+        case FlightEventType::CANCEL_SENT: return "cancel_sent";
+        case FlightEventType::CANCEL_ACK: return "cancel_ack";
+        case FlightEventType::CANCEL_FAILED: return "cancel_failed";
+        case FlightEventType::FILL: return "fill";
+        case FlightEventType::REJECT: return "reject";
+        case FlightEventType::LATENCY: return "latency";
+        case FlightEventType::CONNECTION: return "connection";
+        case FlightEventType::SLO_LEVEL: return "slo_level";
+        case FlightEventType::TRIGGER: break;
+    }
+    return "trigger";
+}
+
+// Text fields come from order ids and exchange messages: keep the JSON valid
+void write_json_string(std::ostream& out, const char* text) {
+    out << '"';
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') {
+            out << '\\' << *c;
+        } else if (static_cast<unsigned char>(*c) >= 0x20) {
+            out << *c;
+        }
+    }
+    out << '"';
+}
+
+} // namespace
+
+FlightRecorder::~FlightRecorder() {
+    stop();
+}
+
+void FlightRecorder::configure(const FlightRecorderConfig& config) {
+    if (slots_ || !config.enabled) {
+        return;  // The ring is sized once; writers may already be using it
+    }
+    config_ = config;
+
+    size_t capacity = 1;
+    while (capacity < std::max<size_t>(config.capacity, 1024)) {
+        capacity <<= 1;
+    }
+    slots_ = std::make_unique<Slot[]>(capacity);
+    mask_ = capacity - 1;
+
+    size_t storm = static_cast<size_t>(std::max(config.reject_storm_count, 1));
+    reject_times_ = std::make_unique<std::atomic<int64_t>[]>(storm);
+    for (size_t i = 0; i < storm; ++i) {
+        reject_times_[i].store(0, std::memory_order_relaxed);
+    }
+
+    running_ = true;
+    dumper_ = std::thread(&FlightRecorder::run_dumper, this);
+    enabled_.store(true, std::memory_order_release);
+
+    std::cout << "[FLIGHT] Recording the last " << capacity << " events, dumps to "
+              << config_.dump_dir << std::endl;
+}
+
+void FlightRecorder::stop() {
+    running_ = false;
+    if (dumper_.joinable()) {
+        dumper_.join();
+    }
+
+    // Later triggers are ignored; one still waiting is written now
+    enabled_.store(false, std::memory_order_release);
+    if (const char* reason = pending_.exchange(nullptr, std::memory_order_acq_rel)) {
+        dump(reason);
+    }
+}
+
+void FlightRecorder::record(FlightEventType type, FlightSide side, double price, double quantity,
+                            int64_t value, const std::string& text) {
+    if (!enabled_.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    FlightEvent event;
+    event.time_ns = now_ns();
+    event.type = type;
+    event.side = side;
+    event.price = price;
+    event.quantity = quantity;
+    event.value = value;
+    size_t length = std::min(text.size(), sizeof(event.text) - 1);
+    std::memcpy(event.text, text.data(), length);
+    event.text[length] = '\0';
+
+    uint64_t seq = head_.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = slots_[seq & mask_];
+    slot.version.store(2 * seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.event = event;
+    slot.version.store(2 * seq + 2, std::memory_order_release);
+
+    check_triggers(event);
+}
+
+void FlightRecorder::check_triggers(const FlightEvent& event) {
+    switch (event.type) {
+        case FlightEventType::ORDER_ACK:
+        case FlightEventType::ORDER_FAILED:
+        case FlightEventType::CANCEL_ACK:
+        case FlightEventType::CANCEL_FAILED:
+            if (event.value > config_.ack_timeout_us) {
+                trigger("ack_timeout");
+            }
+            break;
+
+        case FlightEventType::REJECT: {
+            // Storm if the reject_storm_count-th most recent reject is within the window
+            size_t count = static_cast<size_t>(std::max(config_.reject_storm_count, 1));
+            uint64_t n = reject_count_.fetch_add(1, std::memory_order_relaxed);
+            reject_times_[n % count].store(event.time_ns, std::memory_order_relaxed);
+            int64_t oldest = reject_times_[(n + 1) % count].load(std::memory_order_relaxed);
+            int64_t window_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                config_.reject_storm_window).count();
+            if (n + 1 >= count && event.time_ns - oldest <= window_ns) {
+                trigger("reject_storm");
+            }
+            break;
+        }
+
+        case FlightEventType::CONNECTION:
+            if (event.value == 0 && config_.dump_on_disconnect) {
+                trigger("disconnect");
+            }
+            break;
+
+        case FlightEventType::SLO_LEVEL:
+            if (event.value == 3 && config_.dump_on_pull) {  // SloLevel::PULL
+                trigger("slo_pull");
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+void FlightRecorder::trigger(const char* reason) {
+    if (!enabled_.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    // First trigger wins until the dump is written
+    const char* expected = nullptr;
+    if (pending_.compare_exchange_strong(expected, reason, std::memory_order_acq_rel)) {
+        pending_since_ns_.store(now_ns(), std::memory_order_release);
+        record(FlightEventType::TRIGGER, 0, reason);
+    }
+}
+
+void FlightRecorder::run_dumper() {
+    int64_t last_dump_ns = 0;
+    const int64_t post_trigger_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(config_.post_trigger).count();
+    const int64_t interval_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(config_.min_dump_interval).count();
+
+    while (running_) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+        const char* reason = pending_.load(std::memory_order_acquire);
+        if (!reason) {
+            continue;
+        }
+
+        int64_t now = now_ns();
+        if (now - pending_since_ns_.load(std::memory_order_acquire) < post_trigger_ns) {
+            continue;  // Let the aftermath land in the ring
+        }
+
+        if (last_dump_ns == 0 || now - last_dump_ns >= interval_ns) {
+            dump(reason);
+            last_dump_ns = now;
+        } else {
+            std::cout << "[FLIGHT] " << reason << " within " << config_.min_dump_interval.count()
+                      << " ms of the last dump, not dumping" << std::endl;
+        }
+        pending_.store(nullptr, std::memory_order_release);
+    }
+}
+
+std::string FlightRecorder::dump(const char* reason) {
+    if (!slots_) {
+        return "";
+    }
+
+    // Snapshot the ring, oldest first, skipping slots being rewritten
+    int64_t now = now_ns();
+    int64_t window_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(config_.window).count();
+    uint64_t head = head_.load(std::memory_order_acquire);
+    uint64_t capacity = mask_ + 1;
+    uint64_t first = head > capacity ? head - capacity : 0;
+
+    std::vector<FlightEvent> events;
+    events.reserve(head - first);
+    for (uint64_t seq = first; seq < head; ++seq) {
+        const Slot& slot = slots_[seq & mask_];
+        uint64_t before = slot.version.load(std::memory_order_acquire);
+        if (before != 2 * seq + 2) {
+            continue;
+        }
+        FlightEvent event = slot.event;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.version.load(std::memory_order_relaxed) != before) {
+            continue;
+        }
+        if (now - event.time_ns <= window_ns) {
+            events.push_back(event);
+        }
+    }
+
+    int64_t wall_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    std::filesystem::path path = std::filesystem::path(config_.dump_dir) /
+        ("flight_" + std::to_string(wall_ms) + "_" + reason + ".jsonl");
+
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "[FLIGHT] Cannot write " << path << std::endl;
+        return "";
+    }
+
+    // Times are microseconds relative to the dump
+    out << "{\"reason\":\"" << reason << "\",\"wall_time_ms\":" << wall_ms
+        << ",\"events\":" << events.size() << ",\"recorded\":" << head << "}\n";
+    out << std::setprecision(10);
+    for (const auto& event : events) {
+        out << "{\"t_us\":" << (event.time_ns - now) / 1000 << ",\"type\":\"" << type_name(event.type) << "\"";
+        if (event.side != FlightSide::NONE) {
+            out << ",\"side\":\"" << (event.side == FlightSide::BID ? "BID" : "ASK") << "\"";
+        }
+        if (event.price != 0.0 || event.quantity != 0.0) {
+            out << ",\"price\":" << event.price << ",\"quantity\":" << event.quantity;
+        }
+        out << ",\"value\":" << event.value;
+        if (event.text[0]) {
+            out << ",\"text\":";
+            write_json_string(out, event.text);
+        }
+        out << "}\n";
+    }
+
+    dumps_.fetch_add(1, std::memory_order_relaxed);
+    std::cout << "[FLIGHT] " << reason << ": " << events.size() << " events written to " << path.string() << std::endl;
+    return path.string();
+}
+
+} // namespace MarketMaker
@@ -0,0 +1,84 @@
+#include "latency_histogram.h"
+#include <sstream>
+
+namespace MarketMaker {
+
+int LatencyHistogram::bucket_index(int64_t value_us) {
+    if (value_us < LINEAR_BUCKETS) {
+        return value_us < 0 ? 0 : static_cast<int>(value_us);
+    }
+
+    int exponent = 63 - __builtin_clzll(static_cast<uint64_t>(value_us));
+    if (exponent > MAX_EXPONENT) {
+        return BUCKET_COUNT - 1;
+    }
+
+    // Top SUB_BUCKET_BITS bits below the leading one pick the sub-bucket
+    int sub = static_cast<int>((value_us >> (exponent - SUB_BUCKET_BITS)) & ((1 << SUB_BUCKET_BITS) - 1));
+    return LINEAR_BUCKETS + (exponent - 4) * (1 << SUB_BUCKET_BITS) + sub;
+}
+
+int64_t LatencyHistogram::bucket_upper_bound(int index) {
+    if (index < LINEAR_BUCKETS) {
+        return index;
+    }
+
+    int offset = index - LINEAR_BUCKETS;
+    int exponent = offset / (1 << SUB_BUCKET_BITS) + 4;
+    int sub = offset % (1 << SUB_BUCKET_BITS);
+    int64_t width = int64_t(1) << (exponent - SUB_BUCKET_BITS);
+    int64_t lower = (int64_t((1 << SUB_BUCKET_BITS) + sub)) << (exponent - SUB_BUCKET_BITS);
+    return lower + width - 1;
+}
+
+void LatencyHistogram::record(int64_t value_us) {
+    buckets_[bucket_index(value_us)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+
+    int64_t current = max_.load(std::memory_order_relaxed);
+    while (value_us > current && !max_.compare_exchange_weak(current, value_us, std::memory_order_relaxed)) {
+    }
+}
+
+int64_t LatencyHistogram::percentile(double p) const {
+    uint64_t total = count();
+    if (total == 0) {
+        return 0;
+    }
+
+    uint64_t target = static_cast<uint64_t>(p / 100.0 * total + 0.5);
+    if (target == 0) {
+        target = 1;
+    }
+
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        seen += buckets_[i].load(std::memory_order_relaxed);
+        if (seen >= target) {
+            // Never report more than the largest value actually seen
+            int64_t bound = bucket_upper_bound(i);
+            return bound < max() ? bound : max();
+        }
+    }
+    return max();
+}
+
+void LatencyHistogram::reset() {
+    for (auto& bucket : buckets_) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+    max_.store(0, std::memory_order_relaxed);
+}
+
+std::string LatencyHistogram::summary() const {
+    std::ostringstream ss;
+    ss << "n=" << count()
+       << " p50=" << percentile(50)
+       << " p90=" << percentile(90)
+       << " p99=" << percentile(99)
+       << " max=" << max() << " us";
+    return ss.str();
+}
+
+} // namespace MarketMaker
@@ -0,0 +1,141 @@
+#include "latency_prober.h"
+#include <iostream>
+
+namespace MarketMaker {
+
+LatencyProber::LatencyProber(std::shared_ptr<IExchange> exchange, const ProbeConfig& config)
+    : exchange_(std::move(exchange)), config_(config) {}
+
+LatencyProber::~LatencyProber() {
+    stop();
+}
+
+void LatencyProber::start() {
+    std::lock_guard<std::mutex> lock(run_mutex_);
+    if (running_ || !config_.enabled) {
+        return;
+    }
+    running_ = true;
+    thread_ = std::thread(&LatencyProber::run, this);
+    std::cout << "[PROBE] Probing every " << config_.interval.count() << " ms, budget "
+              << config_.weight_per_minute << " weight/min" << std::endl;
+}
+
+void LatencyProber::stop() {
+    {
+        std::lock_guard<std::mutex> lock(run_mutex_);
+        running_ = false;
+    }
+    run_cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void LatencyProber::run() {
+    uint64_t round = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(run_mutex_);
+            run_cv_.wait_for(lock, config_.interval, [this]() { return !running_; });
+            if (!running_) {
+                return;
+            }
+        }
+
+        round++;
+        bool order_test = config_.order_test_every > 0 && round % config_.order_test_every == 0;
+        probe_round(order_test);
+    }
+}
+
+void LatencyProber::probe_round(bool order_test) {
+    auto now = std::chrono::steady_clock::now();
+
+    // Sized from the previous round: connections rarely change between rounds
+    int expected = last_round_weight_ * (order_test ? 2 : 1);
+    if (!within_budget(expected, now)) {
+        skipped_rounds_++;
+        return;
+    }
+
+    std::optional<ProbeOrder> order;
+    if (order_test && order_source_) {
+        order = order_source_();
+    }
+
+    auto probes = exchange_->probe_latency(order);
+
+    int weight = 0;
+    int ping_weight = 0;
+    for (const auto& probe : probes) {
+        weight += probe.weight;
+        ping_weight += probe.method == "ping" ? probe.weight : 0;
+
+        {
+            std::lock_guard<std::mutex> lock(stats_mutex_);
+            auto& series = series_[{probe.connection, probe.method}];
+            if (!series) {
+                series = std::make_unique<Series>();
+            }
+            if (probe.ok()) {
+                series->rtt.record(probe.rtt_us);
+            } else {
+                series->failures++;
+            }
+        }
+
+        if (probe.ok() && sample_handler_) {
+            sample_handler_(probe);
+        }
+    }
+
+    if (weight > 0) {
+        spent_.emplace_back(now, weight);
+        spent_total_ += weight;
+    }
+    last_round_weight_ = std::max(ping_weight, 1);
+}
+
+bool LatencyProber::within_budget(int weight, std::chrono::steady_clock::time_point now) {
+    while (!spent_.empty() && now - spent_.front().first >= std::chrono::minutes(1)) {
+        spent_total_ -= spent_.front().second;
+        spent_.pop_front();
+    }
+    return spent_total_ + weight <= config_.weight_per_minute;
+}
+
+std::vector<LatencyProber::ConnectionStats> LatencyProber::get_stats() const {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    std::vector<ConnectionStats> stats;
+    for (const auto& [key, series] : series_) {
+        ConnectionStats entry;
+        entry.connection = key.first;
+        entry.method = key.second;
+        entry.p50_us = series->rtt.percentile(50);
+        entry.p99_us = series->rtt.percentile(99);
+        entry.failures = series->failures;
+        entry.summary = series->rtt.summary();
+        stats.push_back(entry);
+    }
+    return stats;
+}
+
+std::optional<std::string> LatencyProber::fastest_connection() const {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    std::optional<std::string> fastest;
+    int64_t best = 0;
+    for (const auto& [key, series] : series_) {
+        if (key.second != "ping" || series->rtt.count() == 0) {
+            continue;
+        }
+        int64_t p50 = series->rtt.percentile(50);
+        if (!fastest || p50 < best) {
+            fastest = key.first;
+            best = p50;
+        }
+    }
+    return fastest;
+}
+
+} // namespace MarketMaker
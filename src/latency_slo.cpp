@@ -0,0 +1,131 @@
+#include "latency_slo.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace MarketMaker {
+
+void LatencySloController::Window::add(std::chrono::steady_clock::time_point time, int64_t value) {
+    if (samples_.size() < CAPACITY) {
+        samples_.push_back({time, value});
+        return;
+    }
+    samples_[next_] = {time, value};
+    next_ = (next_ + 1) % CAPACITY;
+}
+
+int64_t LatencySloController::Window::percentile(double p, std::chrono::steady_clock::time_point since) const {
+    std::vector<int64_t> values;
+    values.reserve(samples_.size());
+    for (const auto& sample : samples_) {
+        if (sample.time >= since) {
+            values.push_back(sample.value);
+        }
+    }
+    if (values.size() < MIN_SAMPLES) {
+        return -1;
+    }
+
+    size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * values.size()));
+    rank = std::clamp<size_t>(rank, 1, values.size()) - 1;
+    std::nth_element(values.begin(), values.begin() + rank, values.end());
+    return values[rank];
+}
+
+LatencySloController::LatencySloController(const SloConfig& config)
+    : config_(config), level_since_(std::chrono::steady_clock::now()) {}
+
+void LatencySloController::record_feed(int64_t latency_us) {
+    if (config_.enabled && latency_us >= 0) {
+        feed_.add(std::chrono::steady_clock::now(), latency_us);
+    }
+}
+
+void LatencySloController::record_ack(int64_t latency_us) {
+    if (config_.enabled && latency_us >= 0) {
+        ack_.add(std::chrono::steady_clock::now(), latency_us);
+    }
+}
+
+bool LatencySloController::evaluate(std::chrono::steady_clock::time_point now) {
+    if (!config_.enabled || now - last_eval_ < EVAL_INTERVAL) {
+        return false;
+    }
+    last_eval_ = now;
+
+    auto since = now - config_.window;
+    int64_t feed_p = feed_.percentile(config_.percentile, since);
+    int64_t ack_p = ack_.percentile(config_.percentile, since);
+    feed_p_us_ = std::max<int64_t>(feed_p, 0);
+    ack_p_us_ = std::max<int64_t>(ack_p, 0);
+
+    double ratio = 0.0;
+    if (feed_p >= 0 && config_.feed_slo_us > 0) {
+        ratio = std::max(ratio, static_cast<double>(feed_p) / config_.feed_slo_us);
+    }
+    if (ack_p >= 0 && config_.ack_slo_us > 0) {
+        ratio = std::max(ratio, static_cast<double>(ack_p) / config_.ack_slo_us);
+    }
+
+    SloLevel target = SloLevel::NORMAL;
+    for (SloLevel candidate : {SloLevel::WIDEN, SloLevel::SHRINK, SloLevel::PULL}) {
+        if (ratio >= threshold(candidate)) {
+            target = candidate;
+        }
+    }
+
+    SloLevel next = level_;
+    if (target > level_) {
+        next = target;  // React to degradation at once
+    } else if (target < level_ && now - level_since_ >= config_.hold &&
+               ratio < threshold(level_) * RECOVER_RATIO) {
+        next = static_cast<SloLevel>(static_cast<int>(level_) - 1);
+    }
+
+    if (next == level_) {
+        return false;
+    }
+
+    std::cout << "[SLO] {\"event\":\"slo_level\",\"from\":\"" << level_name(level_)
+              << "\",\"to\":\"" << level_name(next)
+              << "\",\"ratio\":" << ratio
+              << ",\"percentile\":" << config_.percentile
+              << ",\"feed_us\":" << feed_p_us_
+              << ",\"ack_us\":" << ack_p_us_
+              << ",\"feed_slo_us\":" << config_.feed_slo_us
+              << ",\"ack_slo_us\":" << config_.ack_slo_us << "}" << std::endl;
+
+    level_ = next;
+    level_since_ = now;
+    return true;
+}
+
+double LatencySloController::spread_factor() const {
+    return level_ >= SloLevel::WIDEN ? config_.widen_factor : 1.0;
+}
+
+double LatencySloController::size_factor() const {
+    return level_ >= SloLevel::SHRINK ? config_.shrink_factor : 1.0;
+}
+
+double LatencySloController::threshold(SloLevel level) {
+    switch (level) {
+        case SloLevel::WIDEN: return 1.0;
+        case SloLevel::SHRINK: return 2.0;
+        case SloLevel::PULL: return 4.0;
+        case SloLevel::NORMAL: break;
+    }
+    return 0.0;
+}
+
+const char* LatencySloController::level_name(SloLevel level) {
+    switch (level) {
+        case SloLevel::WIDEN: return "WIDEN";
+        case SloLevel::SHRINK: return "SHRINK";
+        case SloLevel::PULL: return "PULL";
+        case SloLevel::NORMAL: break;
+    }
+    return "NORMAL";
+}
+
+} // namespace MarketMaker
@@ -0,0 +1,104 @@
+#include "lead_lag.h"
+#include <algorithm>
+#include <cmath>
+
+namespace MarketMaker {
+
+namespace {
+
+constexpr double MIN_VARIANCE = 1e-14;  // (0.01 bps)^2: keeps weights finite
+
+} // namespace
+
+LeadLagEngine::LeadLagEngine(const LeadLagConfig& config)
+    : config_(config), leaders_(config.leaders.size()), max_shift_(config.max_shift_bps * 1e-4) {
+    for (size_t i = 0; i < leaders_.size(); ++i) {
+        leaders_[i].symbol = config.leaders[i];
+    }
+}
+
+void LeadLagEngine::on_leader(size_t leader, double mid) {
+    if (leader >= leaders_.size() || mid <= 0) {
+        return;
+    }
+    leaders_[leader].log_price.store(std::log(mid), std::memory_order_release);
+}
+
+void LeadLagEngine::on_follower(double mid) {
+    if (mid <= 0) {
+        return;
+    }
+    double log_mid = std::log(mid);
+    if (log_mid == last_log_mid_) {
+        return;
+    }
+
+    bool first = last_log_mid_ == 0.0;
+    double y = log_mid - last_log_mid_;
+    last_log_mid_ = log_mid;
+
+    const double alpha = config_.alpha;
+    for (auto& leader : leaders_) {
+        double log_price = leader.log_price.load(std::memory_order_acquire);
+        double anchor = leader.anchor.exchange(log_price, std::memory_order_acq_rel);
+        if (first || log_price == 0.0 || anchor == 0.0) {
+            continue;  // Nothing to pair this move with yet
+        }
+
+        double x = log_price - anchor;
+        leader.sxy += alpha * (x * y - leader.sxy);
+        leader.sxx += alpha * (x * x - leader.sxx);
+        int64_t samples = leader.samples.load(std::memory_order_relaxed) + 1;
+        leader.samples.store(samples, std::memory_order_relaxed);
+
+        double beta = leader.sxx > MIN_VARIANCE ? leader.sxy / leader.sxx : 0.0;
+        beta = std::clamp(beta, 0.0, config_.max_beta);
+        double residual = y - beta * x;
+        double residual_var = leader.residual_var.load(std::memory_order_relaxed);
+        residual_var = samples == 1 ? residual * residual
+                                           : residual_var + alpha * (residual * residual - residual_var);
+
+        leader.beta.store(beta, std::memory_order_relaxed);
+        leader.residual_var.store(residual_var, std::memory_order_relaxed);
+        leader.weight.store(samples >= config_.min_samples ? 1.0 / std::max(residual_var, MIN_VARIANCE) : 0.0,
+                            std::memory_order_release);
+    }
+}
+
+double LeadLagEngine::shift() const {
+    double weighted = 0.0;
+    double total = 0.0;
+    for (const auto& leader : leaders_) {
+        double weight = leader.weight.load(std::memory_order_acquire);
+        if (weight <= 0.0) {
+            continue;
+        }
+        double pending = leader.log_price.load(std::memory_order_acquire) -
+                         leader.anchor.load(std::memory_order_acquire);
+        weighted += weight * leader.beta.load(std::memory_order_relaxed) * pending;
+        total += weight;
+    }
+
+    if (total <= 0.0) {
+        return 0.0;
+    }
+    return std::clamp(weighted / total, -max_shift_, max_shift_);
+}
+
+std::vector<LeaderStats> LeadLagEngine::get_stats() const {
+    std::vector<LeaderStats> stats;
+    for (const auto& leader : leaders_) {
+        LeaderStats s;
+        s.symbol = leader.symbol;
+        s.beta = leader.beta.load(std::memory_order_relaxed);
+        s.residual_bps = std::sqrt(leader.residual_var.load(std::memory_order_relaxed)) * 1e4;
+        double log_price = leader.log_price.load(std::memory_order_relaxed);
+        double anchor = leader.anchor.load(std::memory_order_relaxed);
+        s.pending_bps = log_price != 0.0 && anchor != 0.0 ? (log_price - anchor) * 1e4 : 0.0;
+        s.samples = leader.samples.load(std::memory_order_relaxed);
+        stats.push_back(s);
+    }
+    return stats;
+}
+
+} // namespace MarketMaker
@@ -124,6 +124,7 @@ int main(int argc, char* argv[]) {
         }
 
         Config config = *config_opt;
+        config.config_file = config_file;
 
         std::cout << "Configuration:\n"
                   << "  Symbol: " << config.symbol << "\n"
@@ -1,9 +1,14 @@
 #include "market_maker_v2.h"
 #include "exchange_factory.h"
 #include "exchange_interface.h"
+#include "sharded_exchange.h"
+#include "thread_affinity.h"
+#include "rate_limiter.h"
+#include "flight_recorder.h"
 #include <iostream>
 #include <iomanip>
 #include <chrono>
+#include <cmath>
 
 namespace MarketMaker {
 
@@ -27,6 +32,9 @@ bool MarketMakerBotV2::initialize() {
         return false;
     }
 
+    // Black box first, so startup and the first connects are in it
+    FlightRecorder::instance().configure(config_.flight_recorder);
+
     // Setup exchange using factory pattern
     if (!setup_exchange()) {
         logger_->log(LogLevel::ERROR,"Failed to setup exchange");
@@ -34,9 +42,38 @@ bool MarketMakerBotV2::initialize() {
     }
 
     // Initialize order manager with exchange interface
-    order_manager_ = std::make_shared<OrderManager>(exchange_, config_);
+    std::atomic_store(&order_manager_, std::make_shared<OrderManager>(exchange_, config_));
     logger_->log(LogLevel::INFO, "Order manager initialized successfully");
 
+    // Spread, size and cooldowns follow the config file without a restart
+    if (config_.hot_reload && !config_.config_file.empty() &&
+        !order_manager_->parameters().watch_file(config_.config_file)) {
+        logger_->log(LogLevel::WARNING, "Config hot reload unavailable, parameters are fixed until restart");
+    }
+
+    // Order-path round trips between quotes, for the latency SLO and metrics
+    if (config_.latency_probe.enabled) {
+        prober_ = std::make_unique<LatencyProber>(exchange_, config_.latency_probe);
+        std::weak_ptr<OrderManager> weak_manager = order_manager_;
+        prober_->set_order_source([weak_manager, this]() -> std::optional<ProbeOrder> {
+            // Test the quote we are resting, so the probe passes the same filters
+            auto order_manager = weak_manager.lock();
+            if (!order_manager) {
+                return std::nullopt;
+            }
+            auto bid = order_manager->get_active_orders().first;
+            if (!bid) {
+                return std::nullopt;
+            }
+            return ProbeOrder{config_.symbol, OrderSide::BUY, bid->price, bid->quantity, config_.post_only};
+        });
+        prober_->set_sample_handler([weak_manager](const LatencyProbe& probe) {
+            if (auto order_manager = weak_manager.lock()) {
+                order_manager->on_probe_rtt(probe.rtt_us);
+            }
+        });
+    }
+
     initialized_ = true;
     logger_->log(LogLevel::INFO, "Market Maker Bot V2 initialized successfully");
 
@@ -46,6 +83,16 @@ bool MarketMakerBotV2::initialize() {
 bool MarketMakerBotV2::setup_exchange() {
     logger_->log(LogLevel::INFO, "Setting up exchange: " + config_.exchange_type);
 
+    // Before the home feed starts: its first book already goes into the fair value
+    if (config_.fair_value.enabled) {
+        std::vector<std::string> venues{config_.exchange_type};
+        venues.insert(venues.end(), config_.fair_value.venues.begin(), config_.fair_value.venues.end());
+        fair_value_ = std::make_unique<FairValueAggregator>(venues, config_.fair_value);
+    }
+    if (config_.lead_lag.enabled && !config_.lead_lag.leaders.empty()) {
+        lead_lag_ = std::make_unique<LeadLagEngine>(config_.lead_lag);
+    }
+
     // Update config endpoints based on exchange type
     config_.update_endpoints_for_exchange();
 
@@ -56,13 +103,33 @@ bool MarketMakerBotV2::setup_exchange() {
     exchange_config.ws_url = config_.ws_base_url;
     exchange_config.ws_trading_url = config_.ws_trading_url;
     exchange_config.use_websocket_trading = config_.use_websocket_trading;
+    if (config_.order_response_type == "RESULT") {
+        exchange_config.order_response_type = OrderResponseType::RESULT;
+    } else if (config_.order_response_type == "FULL") {
+        exchange_config.order_response_type = OrderResponseType::FULL;
+    }
+    // ACK replies carry no order state: without a user data stream nothing
+    // would ever report fills or exchange cancels
+    if (!config_.use_user_data_stream && exchange_config.order_response_type == OrderResponseType::ACK) {
+        logger_->log(LogLevel::WARNING, "No user data stream, using RESULT order responses instead of ACK");
+        exchange_config.order_response_type = OrderResponseType::RESULT;
+    }
     exchange_config.api_key = config_.api_key;
     exchange_config.api_secret = config_.api_secret;
+    exchange_config.sub_accounts = config_.sub_accounts;
+    exchange_config.shard_by = config_.shard_by;
+    if (config_.shared_rate_limit) {
+        exchange_config.shared_rate_label = config_.symbol;
+    }
+    exchange_config.replay_file = config_.replay_file;
+    exchange_config.replay_speed = config_.replay_speed;
     exchange_config.use_testnet = config_.use_testnet;
     exchange_config.price_precision = config_.price_precision;
     exchange_config.quantity_precision = config_.quantity_precision;
     exchange_config.max_requests_per_second = config_.max_requests_per_second;
     exchange_config.max_orders_per_second = config_.max_orders_per_second;
+    exchange_config.use_ktls = config_.use_ktls;
+    exchange_config.socket_profile = config_.socket_profile;
     exchange_config.display_assets = config_.display_assets;
     exchange_config.supported_quote_currencies = config_.supported_quote_currencies;
 
@@ -75,14 +142,19 @@ bool MarketMakerBotV2::setup_exchange() {
     }
 
     // Set up event handlers
-    exchange_->set_orderbook_handler([this](const OrderBook& orderbook) {
-        handle_orderbook_update(orderbook);
+    // Only updates that change the book arrive, with what changed
+    exchange_->set_book_delta_handler([this](const OrderBook& orderbook, const BookDelta& delta) {
+        handle_orderbook_update(orderbook, delta);
     });
 
     exchange_->set_connection_handler([this](bool connected) {
         handle_connection_status(connected);
     });
 
+    exchange_->set_execution_handler([this](const ExecutionReport& report) {
+        handle_execution(report);
+    });
+
     // Connect to exchange
     if (!exchange_->connect()) {
         logger_->log(LogLevel::ERROR,"Failed to connect to exchange");
@@ -96,10 +168,92 @@ bool MarketMakerBotV2::setup_exchange() {
         return false;
     }
 
+    // Fills trigger immediate requotes; without them we requote on price moves only
+    if (config_.use_user_data_stream && !exchange_->subscribe_user_data()) {
+        if (exchange_config.order_response_type == OrderResponseType::ACK) {
+            // The exchange was built for ACK responses; fills would go unnoticed
+            logger_->log(LogLevel::ERROR, "User data stream unavailable with ACK order responses: "
+                         "set exchange.order_response_type to RESULT or exchange.user_data_stream to false");
+            return false;
+        }
+        logger_->log(LogLevel::WARNING, "User data stream unavailable, fill-triggered requotes disabled");
+    }
+
+    if (fair_value_) {
+        setup_reference_venues();
+    }
+    if (lead_lag_) {
+        setup_leaders(exchange_config);
+    }
+
     logger_->log(LogLevel::INFO, "Exchange setup completed successfully");
     return true;
 }
 
+void MarketMakerBotV2::setup_reference_venues() {
+    for (size_t i = 0; i < config_.fair_value.venues.size(); ++i) {
+        const std::string& venue = config_.fair_value.venues[i];
+
+        // Public books only: no credentials, the venue's default endpoints
+        ExchangeConfig venue_config;
+        venue_config.exchange_type = venue;
+        venue_config.use_ktls = config_.use_ktls;
+        venue_config.socket_profile = config_.socket_profile;
+        venue_config.supported_quote_currencies = config_.supported_quote_currencies;
+
+        auto exchange = ExchangeFactory::create(venue_config);
+        if (!exchange) {
+            logger_->log(LogLevel::WARNING, "Reference venue " + venue + " unavailable, fair value without it");
+            continue;
+        }
+
+        size_t index = i + 1;  // 0 is the home venue
+        exchange->set_orderbook_handler([this, index](const OrderBook& orderbook) {
+            handle_reference_book(index, orderbook);
+        });
+
+        // Top of book is all the fair value uses
+        if (!exchange->connect() || !exchange->subscribe_orderbook(config_.symbol, 1)) {
+            logger_->log(LogLevel::WARNING, "Failed to subscribe to " + venue + " for " + config_.symbol);
+            continue;
+        }
+
+        reference_exchanges_.push_back(exchange);
+        logger_->log(LogLevel::INFO, "Reference venue " + venue + " streaming " + config_.symbol);
+    }
+}
+
+void MarketMakerBotV2::setup_leaders(const ExchangeConfig& exchange_config) {
+    // Same exchange and endpoints as ours, market data only
+    ExchangeConfig leader_config = exchange_config;
+    leader_config.sub_accounts.clear();
+    leader_config.use_websocket_trading = false;
+
+    for (size_t i = 0; i < lead_lag_->leader_count(); ++i) {
+        const std::string& symbol = config_.lead_lag.leaders[i];
+
+        auto exchange = ExchangeFactory::create(leader_config);
+        if (!exchange) {
+            logger_->log(LogLevel::WARNING, "Leader " + symbol + " unavailable");
+            continue;
+        }
+
+        exchange->set_book_delta_handler([this, i](const OrderBook& orderbook, const BookDelta& delta) {
+            if (delta.touch_moved()) {
+                handle_leader_book(i, orderbook);
+            }
+        });
+
+        if (!exchange->connect() || !exchange->subscribe_orderbook(symbol, 5)) {
+            logger_->log(LogLevel::WARNING, "Failed to subscribe to leader " + symbol);
+            continue;
+        }
+
+        leader_exchanges_.push_back(exchange);
+        logger_->log(LogLevel::INFO, "Following leader " + symbol);
+    }
+}
+
 void MarketMakerBotV2::run() {
     if (!initialized_) {
         logger_->log(LogLevel::ERROR,"Bot not initialized. Call initialize() first.");
@@ -109,10 +263,23 @@ void MarketMakerBotV2::run() {
     running_ = true;
     logger_->log(LogLevel::INFO, "Starting Market Maker Bot V2...");
 
-    // Start main trading loop in separate thread
-    main_thread_ = std::thread([this]() {
-        main_loop();
-    });
+    if (config_.inline_strategy) {
+        // Strategy runs on the feed thread; this one only reports
+        inline_manager_.store(order_manager_.get());
+        main_thread_ = std::thread([this]() {
+            housekeeping_loop();
+        });
+        logger_->log(LogLevel::INFO, "Inline mode: strategy runs on the market data thread");
+    } else {
+        // Start main trading loop in separate thread
+        main_thread_ = std::thread([this]() {
+            main_loop();
+        });
+    }
+
+    if (prober_) {
+        prober_->start();
+    }
 
     logger_->log(LogLevel::INFO, "Market Maker Bot V2 is running on " + config_.exchange_type);
 }
@@ -120,10 +287,25 @@ void MarketMakerBotV2::run() {
 void MarketMakerBotV2::stop() {
     logger_->log(LogLevel::INFO, "Stopping Market Maker Bot V2...");
     running_ = false;
+    inline_manager_.store(nullptr);
 
     // Notify condition variable to wake up main loop
     price_change_cv_.notify_all();
 
+    if (prober_) {
+        prober_->stop();
+    }
+
+    for (auto& exchange : reference_exchanges_) {
+        exchange->disconnect();
+    }
+    for (auto& exchange : leader_exchanges_) {
+        exchange->disconnect();
+    }
+
+    // Before disconnecting: a deliberate disconnect is not an anomaly
+    FlightRecorder::instance().stop();
+
     // Disconnect from exchange
     if (exchange_) {
         exchange_->disconnect();
@@ -145,18 +327,29 @@ void MarketMakerBotV2::main_loop() {
         {
             std::unique_lock<std::mutex> lock(price_change_mutex_);
             price_change_cv_.wait_for(lock, std::chrono::milliseconds(10), [this]() {
-                return price_changed_.load() || !running_;
+                return price_changed_.load() || executions_pending_.load() || !running_;
             });
         }
 
         if (!running_) break;
 
+        // Fills first: an empty side costs more than a stale one
+        if (executions_pending_.exchange(false)) {
+            process_executions();
+        }
+
+        // Scale quoting back (or restore it) with our measured latency
+        order_manager_->check_latency_slo();
+
         // Get current mid price
         double mid_price = current_mid_price_.load();
 
         if (mid_price > 0 && price_changed_.exchange(false)) {
             // Check and update orders using exchange interface
             check_and_update_orders();
+        } else if (mid_price > 0 && !executions_pending_.load()) {
+            // Idle: get the quotes for the next likely mids ready
+            order_manager_->precompute_quotes(mid_price);
         }
 
         // Print status every 30 seconds
@@ -168,6 +361,59 @@ void MarketMakerBotV2::main_loop() {
     }
 }
 
+void MarketMakerBotV2::housekeeping_loop() {
+    // Slow work only: never competes with the feed thread for a CPU
+    lower_current_thread_priority();
+    auto last_status_print = std::chrono::steady_clock::now();
+
+    while (running_) {
+        {
+            std::unique_lock<std::mutex> lock(price_change_mutex_);
+            price_change_cv_.wait_for(lock, std::chrono::seconds(1), [this]() { return !running_; });
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (running_ && now - last_status_print >= std::chrono::seconds(30)) {
+            print_status();
+            last_status_print = now;
+        }
+    }
+}
+
+void MarketMakerBotV2::run_inline(const OrderBook& orderbook, const BookDelta& delta,
+                                  std::chrono::steady_clock::time_point received_time) {
+    // The feed thread may be replaced on reconnect; pin whichever one we are on
+    thread_local bool pinned = false;
+    if (!pinned) {
+        pinned = true;
+        if (config_.strategy_cpu >= 0) {
+            pin_current_thread(config_.strategy_cpu);
+        }
+    }
+
+    OrderManager* order_manager = inline_manager_.load(std::memory_order_acquire);
+    if (!order_manager) {
+        return;
+    }
+
+    order_manager->on_orderbook(orderbook);
+    if (orderbook.bids.empty() || orderbook.asks.empty()) {
+        return;
+    }
+
+    // Parse -> strategy -> risk -> send, start to finish on this thread
+    double mid_price = reference_mid(orderbook);
+    double old_mid_price = delta.touch_moved() ? current_mid_price_.exchange(mid_price) : mid_price;
+
+    std::lock_guard<std::mutex> lock(strategy_mutex_);
+    order_manager->check_latency_slo();
+    if (std::abs(old_mid_price - mid_price) > 0.00001) {
+        order_manager->update_orders_if_needed(mid_price, received_time);
+    } else {
+        order_manager->precompute_quotes(mid_price);
+    }
+}
+
 void MarketMakerBotV2::check_and_update_orders() {
     double mid_price = current_mid_price_.load();
 
@@ -186,28 +432,143 @@ void MarketMakerBotV2::check_and_update_orders() {
     order_manager_->update_orders_if_needed(mid_price, orderbook_time);
 }
 
-void MarketMakerBotV2::handle_orderbook_update(const OrderBook& orderbook) {
+void MarketMakerBotV2::process_executions() {
+    std::deque<ExecutionReport> executions;
+    {
+        std::lock_guard<std::mutex> lock(executions_mutex_);
+        executions.swap(pending_executions_);
+    }
+
+    for (const auto& report : executions) {
+        order_manager_->on_execution(report, current_mid_price_.load());
+    }
+}
+
+void MarketMakerBotV2::handle_execution(const ExecutionReport& report) {
+    if (config_.inline_strategy) {
+        // No strategy thread to hand to: requote right here
+        if (OrderManager* order_manager = inline_manager_.load(std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> lock(strategy_mutex_);
+            order_manager->on_execution(report, current_mid_price_.load());
+        }
+        return;
+    }
+
+    // Runs on the user data stream thread: queue and wake the strategy thread
+    {
+        std::lock_guard<std::mutex> lock(executions_mutex_);
+        pending_executions_.push_back(report);
+    }
+    executions_pending_.store(true);
+    price_change_cv_.notify_one();
+}
+
+void MarketMakerBotV2::handle_orderbook_update(const OrderBook& orderbook, const BookDelta& delta) {
     // Capture timestamp immediately when orderbook update is received
     auto orderbook_received_time = std::chrono::steady_clock::now();
 
-    // Update local orderbook
+    if (delta.touch_moved()) {
+        FlightRecorder::instance().record(FlightEventType::BOOK_TOP, FlightSide::NONE,
+                                          orderbook.get_best_bid(), orderbook.get_best_ask());
+    }
+
+    if (config_.inline_strategy) {
+        run_inline(orderbook, delta, orderbook_received_time);
+        return;
+    }
+
+    // Queue estimates follow every change, not just the ones that move the mid
+    if (auto order_manager = std::atomic_load(&order_manager_)) {
+        order_manager->on_orderbook(orderbook);
+    }
+
+    // Depth-only changes cannot move the mid
+    if (!delta.touch_moved()) {
+        return;
+    }
+
     {
         std::lock_guard<std::mutex> lock(orderbook_mutex_);
-        current_orderbook_ = orderbook;
         last_orderbook_time_ = orderbook_received_time;
     }
 
     // Calculate and update mid price
-    update_mid_price();
+    if (!orderbook.bids.empty() && !orderbook.asks.empty()) {
+        update_mid_price(reference_mid(orderbook));
+    }
 }
 
-void MarketMakerBotV2::update_mid_price() {
-    std::lock_guard<std::mutex> lock(orderbook_mutex_);
+void MarketMakerBotV2::handle_reference_book(size_t venue, const OrderBook& orderbook) {
+    // Runs on the reference venue's feed thread
+    fair_value_->on_book(venue, orderbook);
+    auto fair = fair_value_->fair_value();
+    if (!fair) {
+        return;
+    }
+
+    base_mid_.store(*fair);
+    requote_from_feed(with_lead_lag(*fair), orderbook.timestamp);
+}
+
+void MarketMakerBotV2::handle_leader_book(size_t leader, const OrderBook& orderbook) {
+    // Runs on the leader's feed thread, typically ahead of our own book
+    lead_lag_->on_leader(leader, orderbook.get_mid_price());
+    double base = base_mid_.load();
+    if (base > 0) {
+        requote_from_feed(with_lead_lag(base), orderbook.timestamp);
+    }
+}
+
+void MarketMakerBotV2::requote_from_feed(double mid_price, std::chrono::steady_clock::time_point received_time) {
+    if (config_.inline_strategy) {
+        // Requote from here, taking turns with the home feed
+        OrderManager* order_manager = inline_manager_.load(std::memory_order_acquire);
+        if (!order_manager) {
+            return;
+        }
+        double old_mid_price = current_mid_price_.exchange(mid_price);
+        if (std::abs(old_mid_price - mid_price) > 0.00001) {
+            // Never queue behind another feed: if one is requoting, the next
+            // update picks up this mid
+            std::unique_lock<std::mutex> lock(strategy_mutex_, std::try_to_lock);
+            if (lock.owns_lock()) {
+                order_manager->update_orders_if_needed(mid_price, received_time);
+            } else {
+                // Leave the move visible so the next update doesn't see it as done
+                current_mid_price_.compare_exchange_strong(mid_price, old_mid_price);
+            }
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(orderbook_mutex_);
+        last_orderbook_time_ = received_time;
+    }
+    update_mid_price(mid_price);
+}
 
-    if (!current_orderbook_.bids.empty() && !current_orderbook_.asks.empty()) {
-        double best_bid = current_orderbook_.bids[0].price;
-        double best_ask = current_orderbook_.asks[0].price;
-        double new_mid_price = (best_bid + best_ask) / 2.0;
+double MarketMakerBotV2::reference_mid(const OrderBook& orderbook) {
+    double mid = orderbook.get_mid_price();
+    double base = mid;
+    if (fair_value_) {
+        fair_value_->on_book(0, orderbook);
+        base = fair_value_->fair_value().value_or(mid);
+    }
+    if (lead_lag_) {
+        // Our own move catches up with the leaders: re-anchor before shifting
+        lead_lag_->on_follower(mid);
+        base_mid_.store(base);
+    }
+    return with_lead_lag(base);
+}
+
+double MarketMakerBotV2::with_lead_lag(double mid) const {
+    return lead_lag_ ? mid * std::exp(lead_lag_->shift()) : mid;
+}
+
+void MarketMakerBotV2::update_mid_price(double new_mid_price) {
+    if (new_mid_price > 0) {
         double old_mid_price = current_mid_price_.exchange(new_mid_price);
 
         if (std::abs(old_mid_price - new_mid_price) > 0.00001) {
@@ -229,6 +590,7 @@ void MarketMakerBotV2::update_mid_price() {
 }
 
 void MarketMakerBotV2::handle_connection_status(bool connected) {
+    FlightRecorder::instance().record(FlightEventType::CONNECTION, connected ? 1 : 0, config_.exchange_type);
     if (connected) {
         logger_->log(LogLevel::INFO, "Connected to " + config_.exchange_type + " exchange");
     } else {
@@ -251,8 +613,8 @@ bool MarketMakerBotV2::validate_config() {
         return false;
     }
 
-    // Validate API credentials
-    if (config_.api_key.empty() || config_.api_secret.empty()) {
+    // Validate API credentials (the mock exchange takes none)
+    if (config_.exchange_type != "mock" && (config_.api_key.empty() || config_.api_secret.empty())) {
         logger_->log(LogLevel::ERROR,"API credentials not set");
         return false;
     }
@@ -304,6 +666,53 @@ void MarketMakerBotV2::print_status() {
               << metrics.avg_reaction_latency_ms << " ms" << std::endl;
     std::cout << "    Min: " << metrics.min_reaction_latency_ms << " ms" << std::endl;
     std::cout << "    Max: " << metrics.max_reaction_latency_ms << " ms" << std::endl;
+    const auto& histograms = order_manager_->get_histograms();
+    std::cout << "\n  Latency Histograms:" << std::endl;
+    std::cout << "    Reaction:      " << histograms.reaction.summary() << std::endl;
+    std::cout << "    Fill -> Order: " << histograms.fill_to_order.summary() << std::endl;
+    for (OrderSide side : {OrderSide::BUY, OrderSide::SELL}) {
+        if (auto queue = order_manager_->get_queue_estimate(side)) {
+            std::cout << "  Queue " << (side == OrderSide::BUY ? "BID" : "ASK") << ": "
+                      << std::fixed << std::setprecision(5) << queue->ahead << " ahead of "
+                      << queue->level_qty << " at " << queue->price
+                      << (queue->at_touch ? " (touch)" : "") << std::endl;
+        }
+    }
+    if (prober_) {
+        for (const auto& stats : prober_->get_stats()) {
+            std::cout << "  Probe " << stats.connection << " " << stats.method << ": " << stats.summary
+                      << ", failures " << stats.failures << std::endl;
+        }
+        if (auto fastest = prober_->fastest_connection()) {
+            std::cout << "  Fastest connection: " << *fastest << " (skipped rounds "
+                      << prober_->skipped_rounds() << ")" << std::endl;
+        }
+    }
+    std::cout << "  Inventory: " << std::fixed << std::setprecision(5)
+              << order_manager_->get_inventory() << " " << config_.base_asset << std::endl;
+    OrderRateLimiter::instance().log_status();
+    if (fair_value_) {
+        for (const auto& quote : fair_value_->get_quotes()) {
+            std::cout << "  Venue " << quote.venue << ": mid " << std::fixed << std::setprecision(5) << quote.mid
+                      << ", basis " << quote.basis << ", latency " << quote.latency_us << "us, age "
+                      << quote.age_us << "us, weight " << std::setprecision(3) << quote.weight << std::endl;
+        }
+    }
+    if (lead_lag_) {
+        for (const auto& leader : lead_lag_->get_stats()) {
+            std::cout << "  Leader " << leader.symbol << ": beta " << std::fixed << std::setprecision(3)
+                      << leader.beta << ", residual " << std::setprecision(2) << leader.residual_bps
+                      << "bps, pending " << leader.pending_bps << "bps (" << leader.samples << " samples)"
+                      << std::endl;
+        }
+    }
+    if (auto sharded = std::dynamic_pointer_cast<ShardedExchange>(exchange_)) {
+        std::cout << "  Orders per account:";
+        for (const auto& [name, count] : sharded->get_shard_order_counts()) {
+            std::cout << " " << name << "=" << count;
+        }
+        std::cout << std::endl;
+    }
     std::cout << "\n  Reconnects: " << metrics.reconnect_count << std::endl;
     std::cout << "  Uptime: " << std::fixed << std::setprecision(2)
               << metrics.get_uptime_percentage() << "%" << std::endl;
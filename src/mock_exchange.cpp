@@ -0,0 +1,369 @@
+#include "mock_exchange.h"
+#include "book_store.h"
+#include "exchange_clock.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+
+namespace MarketMaker {
+
+MockExchange::MockExchange(std::string name) : name_(std::move(name)) {
+}
+
+MockExchange::~MockExchange() {
+    stop_replay();
+}
+
+// ========== Feeding the mock ==========
+
+void MockExchange::push_orderbook(const OrderBook& book) {
+    OrderBook stamped = book;
+    if (stamped.timestamp.time_since_epoch().count() == 0) {
+        stamped.timestamp = std::chrono::steady_clock::now();
+    }
+
+    std::vector<ExecutionReport> fills;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        book_ = stamped;
+
+        // Fills on arrival since the last book go first
+        fills.swap(pending_reports_);
+
+        for (auto it = orders_.begin(); it != orders_.end();) {
+            if (!crosses(it->second)) {
+                ++it;
+                continue;
+            }
+            fills.push_back(fill_report(it->second, touch_price(it->second.side), stamped.timestamp));
+            it = orders_.erase(it);
+        }
+    }
+
+    // Outside the lock: handlers may place orders right away
+    for (const auto& report : fills) {
+        if (execution_handler_) {
+            execution_handler_(report);
+        }
+    }
+    notify_orderbook(stamped);
+}
+
+void MockExchange::set_balance(const std::string& asset, double amount) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    balances_[asset] = amount;
+}
+
+std::vector<Order> MockExchange::get_resting_orders() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<Order> orders;
+    for (const auto& [id, order] : orders_) {
+        orders.push_back(order);
+    }
+    return orders;
+}
+
+bool MockExchange::crosses(const Order& order) const {
+    if (order.side == OrderSide::BUY) {
+        return !book_.asks.empty() && order.price >= book_.asks[0].price;
+    }
+    return !book_.bids.empty() && order.price <= book_.bids[0].price;
+}
+
+double MockExchange::touch_price(OrderSide side) const {
+    // What a crossing order trades at: the best price on the other side
+    return side == OrderSide::BUY ? book_.asks[0].price : book_.bids[0].price;
+}
+
+ExecutionReport MockExchange::fill_report(const Order& order, double price,
+                                          std::chrono::steady_clock::time_point received_time) {
+    ExecutionReport report;
+    report.symbol = order.symbol;
+    report.order_id = order.order_id;
+    report.client_order_id = order.client_order_id;
+    report.side = order.side;
+    report.status = OrderStatus::FILLED;
+    report.is_trade = true;
+    report.price = order.price;
+    report.quantity = order.quantity;
+    report.last_filled_price = price;
+    report.last_filled_quantity = order.quantity - order.executed_quantity;
+    report.cumulative_filled_quantity = order.quantity;
+    report.event_time_ms = ExchangeClock::local_ms();
+    report.received_time = received_time;
+    return report;
+}
+
+void MockExchange::run_replay(int depth) {
+    BookStoreReplay replay(*replay_reader_, 0, depth);
+    BookStoreReplay::Event event;
+    const double speed = config_.replay_speed;
+    int64_t first_us = -1;
+    auto started = std::chrono::steady_clock::now();
+    uint64_t books = 0;
+
+    while (replaying_.load() && replay.next(event)) {
+        if (event.kind != BookStoreReplay::Event::Kind::BOOK) {
+            continue;
+        }
+
+        if (first_us < 0) {
+            first_us = event.time_us;
+        }
+        if (speed > 0) {
+            auto due = started + std::chrono::microseconds(
+                static_cast<int64_t>(static_cast<double>(event.time_us - first_us) / speed));
+            // Short sleeps so disconnect() never waits out a quiet stretch
+            while (replaying_.load() && std::chrono::steady_clock::now() < due) {
+                std::this_thread::sleep_until(std::min(due, std::chrono::steady_clock::now() +
+                                                                std::chrono::milliseconds(100)));
+            }
+        }
+
+        // Recorded exchange stamps are hours old and would read as feed lag
+        OrderBook book = *event.book;
+        book.exchange_time_ms = ExchangeClock::local_ms();
+        push_orderbook(book);
+        ++books;
+    }
+
+    std::cout << "[MOCK] Replay of " << config_.replay_file << " finished after " << books << " books" << std::endl;
+}
+
+void MockExchange::stop_replay() {
+    replaying_ = false;
+    if (!replay_thread_.joinable()) {
+        return;
+    }
+    if (replay_thread_.get_id() == std::this_thread::get_id()) {
+        replay_thread_.detach();  // Disconnected from a handler: the loop ends on its own
+    } else {
+        replay_thread_.join();
+    }
+}
+
+// ========== Connection Management ==========
+
+bool MockExchange::initialize(const ExchangeConfig& config) {
+    config_ = config;
+    tick_size_ = std::pow(10.0, -config.price_precision);
+    step_size_ = std::pow(10.0, -config.quantity_precision);
+    return true;
+}
+
+bool MockExchange::connect() {
+    connected_ = true;
+    if (connection_handler_) {
+        connection_handler_(true);
+    }
+    return true;
+}
+
+void MockExchange::disconnect() {
+    stop_replay();
+    if (connected_.exchange(false) && connection_handler_) {
+        connection_handler_(false);
+    }
+}
+
+// ========== Market Data ==========
+
+bool MockExchange::subscribe_orderbook([[maybe_unused]] const std::string& symbol, int depth) {
+    if (!connected_.load()) {
+        return false;
+    }
+    if (config_.replay_file.empty() || replay_thread_.joinable()) {
+        // Books arrive through push_orderbook()
+        return true;
+    }
+
+    auto reader = std::make_unique<BookStoreReader>();
+    std::string error;
+    if (!reader->open(config_.replay_file, &error)) {
+        std::cerr << "[MOCK] Cannot replay " << config_.replay_file << ": " << error << std::endl;
+        return false;
+    }
+    std::cout << "[MOCK] Replaying " << reader->symbol() << " from " << config_.replay_file
+              << " at " << (config_.replay_speed > 0 ? std::to_string(config_.replay_speed) + "x" : "full speed")
+              << std::endl;
+
+    replay_reader_ = std::move(reader);
+    replaying_ = true;
+    replay_thread_ = std::thread([this, depth]() { run_replay(depth); });
+    return true;
+}
+
+bool MockExchange::subscribe_trades([[maybe_unused]] const std::string& symbol) {
+    return false;
+}
+
+bool MockExchange::unsubscribe([[maybe_unused]] const std::string& symbol) {
+    return true;
+}
+
+std::optional<OrderBook> MockExchange::get_orderbook([[maybe_unused]] const std::string& symbol, int limit) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    OrderBook book = book_;
+    if (static_cast<int>(book.bids.size()) > limit) book.bids.resize(limit);
+    if (static_cast<int>(book.asks.size()) > limit) book.asks.resize(limit);
+    return book;
+}
+
+std::optional<double> MockExchange::get_current_price([[maybe_unused]] const std::string& symbol) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    double mid = book_.get_mid_price();
+    if (mid <= 0) {
+        return std::nullopt;
+    }
+    return mid;
+}
+
+std::optional<std::string> MockExchange::get_exchange_info() {
+    return std::string("{}");
+}
+
+// ========== Order Management ==========
+
+std::optional<Order> MockExchange::place_limit_order(
+    const std::string& symbol,
+    OrderSide side,
+    double price,
+    double quantity,
+    const std::string& client_order_id,
+    bool post_only) {
+
+    Order order;
+    order.symbol = symbol;
+    order.side = side;
+    order.price = price;
+    order.quantity = quantity;
+    order.executed_quantity = 0.0;
+    order.client_order_id = client_order_id;
+    order.status = OrderStatus::NEW;
+    order.created_time = order.updated_time = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (crosses(order)) {
+        if (post_only) {
+            return std::nullopt;  // LIMIT_MAKER would be rejected
+        }
+        // Takes liquidity at once; reported like an exchange FULL response
+        order.order_id = std::to_string(next_order_id_++);
+        pending_reports_.push_back(fill_report(order, touch_price(side), order.created_time));
+        order.executed_quantity = quantity;
+        order.status = OrderStatus::FILLED;
+        return order;
+    }
+
+    order.order_id = std::to_string(next_order_id_++);
+    orders_[order.order_id] = order;
+    return order;
+}
+
+std::optional<Order> MockExchange::place_market_order(
+    const std::string& symbol,
+    OrderSide side,
+    double quantity,
+    const std::string& client_order_id) {
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto& levels = side == OrderSide::BUY ? book_.asks : book_.bids;
+    if (levels.empty()) {
+        return std::nullopt;
+    }
+
+    Order order;
+    order.order_id = std::to_string(next_order_id_++);
+    order.client_order_id = client_order_id;
+    order.symbol = symbol;
+    order.side = side;
+    order.price = levels[0].price;
+    order.quantity = quantity;
+    order.executed_quantity = 0.0;
+    order.created_time = order.updated_time = std::chrono::steady_clock::now();
+    pending_reports_.push_back(fill_report(order, order.price, order.created_time));
+    order.executed_quantity = quantity;
+    order.status = OrderStatus::FILLED;
+    return order;
+}
+
+std::optional<bool> MockExchange::cancel_order([[maybe_unused]] const std::string& symbol, const std::string& order_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return orders_.erase(order_id) > 0;
+}
+
+std::optional<bool> MockExchange::cancel_all_orders([[maybe_unused]] const std::string& symbol) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    orders_.clear();
+    return true;
+}
+
+std::optional<Order> MockExchange::modify_order(
+    const std::string& symbol,
+    const std::string& order_id,
+    double new_price,
+    double new_quantity) {
+
+    Order old;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = orders_.find(order_id);
+        if (it == orders_.end()) {
+            return std::nullopt;
+        }
+        old = it->second;
+        orders_.erase(it);
+    }
+    // Cancel-replace, like Binance
+    return place_limit_order(symbol, old.side, new_price, new_quantity, old.client_order_id, false);
+}
+
+std::optional<std::vector<Order>> MockExchange::get_open_orders([[maybe_unused]] const std::string& symbol) {
+    return get_resting_orders();
+}
+
+std::optional<Order> MockExchange::get_order_status([[maybe_unused]] const std::string& symbol, const std::string& order_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = orders_.find(order_id);
+    if (it == orders_.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+// ========== Account Information ==========
+
+std::optional<std::string> MockExchange::get_account_info() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ostringstream info;
+    for (const auto& [asset, amount] : balances_) {
+        info << asset << ": " << amount << "\n";
+    }
+    return info.str();
+}
+
+std::optional<double> MockExchange::get_balance(const std::string& asset) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = balances_.find(asset);
+    return it == balances_.end() ? 0.0 : it->second;
+}
+
+// ========== Utility Methods ==========
+
+bool MockExchange::get_symbol_info([[maybe_unused]] const std::string& symbol,
+                                   int& price_precision, int& quantity_precision) {
+    price_precision = static_cast<int>(std::lround(-std::log10(tick_size_)));
+    quantity_precision = static_cast<int>(std::lround(-std::log10(step_size_)));
+    return true;
+}
+
+double MockExchange::format_price(double price, [[maybe_unused]] const std::string& symbol) {
+    return std::round(price / tick_size_) * tick_size_;
+}
+
+double MockExchange::format_quantity(double quantity, [[maybe_unused]] const std::string& symbol) {
+    return std::floor(quantity / step_size_ + 1e-9) * step_size_;
+}
+
+} // namespace MarketMaker
@@ -0,0 +1,68 @@
+#include "okx_book_parser.h"
+#include <json/json.h>
+
+namespace MarketMaker {
+
+namespace {
+
+void parse_levels(const Json::Value& levels, std::vector<PriceLevel>& out) {
+    for (const auto& level : levels) {
+        if (level.isArray() && level.size() >= 2) {
+            out.emplace_back(std::stod(level[0].asString()), std::stod(level[1].asString()));
+        }
+    }
+}
+
+} // namespace
+
+bool OkxBookParser::parse_book(const Json::Value& data, OrderBook& book) {
+    parse_levels(data["bids"], book.bids);
+    parse_levels(data["asks"], book.asks);
+    if (data.isMember("ts")) {
+        book.exchange_time_ms = std::stoll(data["ts"].asString());
+    }
+    return !book.bids.empty() || !book.asks.empty();
+}
+
+std::optional<OrderBook> OkxBookParser::parse_push(const std::string& message, std::string* error) {
+    Json::Value root;
+    Json::Reader reader;
+    if (!reader.parse(message, root) || !root.isObject()) {
+        return std::nullopt;
+    }
+
+    if (root.isMember("event")) {
+        if (root["event"].asString() == "error" && error) {
+            *error = root["code"].asString() + ": " + root["msg"].asString();
+        }
+        return std::nullopt;
+    }
+
+    const Json::Value& data = root["data"];
+    if (!data.isArray() || data.empty()) {
+        return std::nullopt;
+    }
+
+    OrderBook orderbook;
+    orderbook.timestamp = std::chrono::steady_clock::now();
+    if (!parse_book(data[0], orderbook)) {
+        return std::nullopt;
+    }
+    return orderbook;
+}
+
+std::optional<OrderBook> OkxBookParser::parse_rest(const std::string& response) {
+    Json::Value root;
+    Json::Reader reader;
+    if (!reader.parse(response, root) || !root.isObject() || root["code"].asString() != "0" ||
+        !root["data"].isArray() || root["data"].empty()) {
+        return std::nullopt;
+    }
+
+    OrderBook orderbook;
+    orderbook.timestamp = std::chrono::steady_clock::now();
+    parse_book(root["data"][0], orderbook);
+    return orderbook;
+}
+
+} // namespace MarketMaker
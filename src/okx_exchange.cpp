@@ -0,0 +1,359 @@
+#include "okx_exchange.h"
+#include "okx_book_parser.h"
+#include <json/json.h>
+#include <curl/curl.h>
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+namespace MarketMaker {
+
+namespace {
+
+constexpr const char* DEFAULT_REST_URL = "https://www.okx.com";
+constexpr const char* DEFAULT_WS_URL = "wss://ws.okx.com:8443/ws/v5/public";
+
+size_t write_callback(void* contents, size_t size, size_t nmemb, std::string* out) {
+    out->append(static_cast<char*>(contents), size * nmemb);
+    return size * nmemb;
+}
+
+// "0.001" -> 3
+int decimals_of(double step) {
+    if (step <= 0) {
+        return 8;
+    }
+    return std::max(0, static_cast<int>(std::lround(-std::log10(step))));
+}
+
+} // namespace
+
+OkxExchange::OkxExchange() {
+    // Constructor
+}
+
+OkxExchange::~OkxExchange() {
+    disconnect();
+}
+
+bool OkxExchange::initialize(const ExchangeConfig& config) {
+    config_ = config;
+    if (config_.api_url.empty() || config_.api_url.find("okx") == std::string::npos) {
+        config_.api_url = DEFAULT_REST_URL;
+    }
+    if (config_.ws_url.empty() || config_.ws_url.find("okx") == std::string::npos) {
+        config_.ws_url = DEFAULT_WS_URL;
+    }
+    if (!config.supported_quote_currencies.empty()) {
+        quote_currencies_ = config.supported_quote_currencies;
+    }
+
+    ws_client_ = std::make_shared<WebSocketClient>();
+
+    ws_client_->set_message_handler([this](const std::string& msg) {
+        handle_websocket_message(msg);
+    });
+
+    ws_client_->set_connection_handler([this](bool connected) {
+        ws_connected_ = connected;
+
+        // OKX subscriptions are per connection: resend after every connect
+        if (connected && !subscribed_inst_.empty()) {
+            Json::Value request;
+            request["op"] = "subscribe";
+            Json::Value arg;
+            arg["channel"] = subscribed_channel_;
+            arg["instId"] = subscribed_inst_;
+            request["args"].append(arg);
+
+            Json::StreamWriterBuilder writer;
+            writer["indentation"] = "";
+            ws_client_->send_text(Json::writeString(writer, request));
+        }
+
+        if (connection_handler_) {
+            connection_handler_(connected);
+        }
+    });
+
+    ws_client_->enable_auto_reconnect(true);
+    ws_client_->enable_ktls(config.use_ktls);
+    ws_client_->set_socket_profile(config.socket_profile);
+
+    std::cout << "OkxExchange initialized (public market data)" << std::endl;
+    return true;
+}
+
+bool OkxExchange::connect() {
+    // The connection is opened by subscribe_orderbook, like Binance
+    return ws_client_ != nullptr;
+}
+
+void OkxExchange::disconnect() {
+    if (ws_client_) {
+        ws_client_->disconnect();
+    }
+    ws_connected_ = false;
+}
+
+bool OkxExchange::is_connected() const {
+    return ws_connected_.load();
+}
+
+// ========== Market Data ==========
+
+bool OkxExchange::subscribe_orderbook(const std::string& symbol, int depth) {
+    if (!ws_client_) {
+        return false;
+    }
+
+    subscribed_inst_ = convert_symbol_to_okx(symbol);
+    subscribed_channel_ = depth <= 1 ? "bbo-tbt" : "books5";
+
+    std::cout << "Connecting to OKX stream: " << config_.ws_url << " (" << subscribed_channel_
+              << " " << subscribed_inst_ << ")" << std::endl;
+
+    // The connection handler sends the subscription
+    if (!ws_client_->connect(config_.ws_url)) {
+        std::cerr << "Failed to connect to OKX WebSocket" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool OkxExchange::subscribe_trades([[maybe_unused]] const std::string& symbol) {
+    return false;
+}
+
+bool OkxExchange::unsubscribe([[maybe_unused]] const std::string& symbol) {
+    return true;
+}
+
+void OkxExchange::handle_websocket_message(const std::string& message) {
+    if (message_handler_) {
+        message_handler_(message);
+    }
+
+    try {
+        std::string error;
+        if (auto orderbook = OkxBookParser::parse_push(message, &error)) {
+            notify_orderbook(*orderbook);
+        } else if (!error.empty()) {
+            std::cerr << "[OKX] " << error << std::endl;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error processing OKX orderbook: " << e.what() << std::endl;
+    }
+}
+
+std::optional<OrderBook> OkxExchange::get_orderbook(const std::string& symbol, int limit) {
+    auto response = http_get("/api/v5/market/books?instId=" + convert_symbol_to_okx(symbol) +
+                             "&sz=" + std::to_string(limit));
+    if (!response) {
+        return std::nullopt;
+    }
+
+    auto orderbook = OkxBookParser::parse_rest(*response);
+    if (!orderbook) {
+        std::cerr << "Failed to parse OKX orderbook response" << std::endl;
+    }
+    return orderbook;
+}
+
+std::optional<double> OkxExchange::get_current_price(const std::string& symbol) {
+    auto response = http_get("/api/v5/market/ticker?instId=" + convert_symbol_to_okx(symbol));
+    if (!response) {
+        return std::nullopt;
+    }
+
+    Json::Value root;
+    Json::Reader reader;
+    if (!reader.parse(*response, root) || root["code"].asString() != "0" || root["data"].empty()) {
+        return std::nullopt;
+    }
+    return std::stod(root["data"][0]["last"].asString());
+}
+
+std::optional<std::string> OkxExchange::get_exchange_info() {
+    return http_get("/api/v5/public/instruments?instType=SPOT");
+}
+
+std::optional<OkxExchange::InstrumentInfo> OkxExchange::get_instrument(const std::string& inst_id) {
+    {
+        std::lock_guard<std::mutex> lock(instruments_mutex_);
+        auto it = instruments_.find(inst_id);
+        if (it != instruments_.end()) {
+            return it->second;
+        }
+    }
+
+    auto response = http_get("/api/v5/public/instruments?instType=SPOT&instId=" + inst_id);
+    if (!response) {
+        return std::nullopt;
+    }
+
+    Json::Value root;
+    Json::Reader reader;
+    if (!reader.parse(*response, root) || root["code"].asString() != "0" || root["data"].empty()) {
+        std::cerr << "Unknown OKX instrument: " << inst_id << std::endl;
+        return std::nullopt;
+    }
+
+    try {
+        const Json::Value& data = root["data"][0];
+        InstrumentInfo info;
+        info.tick_size = std::stod(data["tickSz"].asString());
+        info.lot_size = std::stod(data["lotSz"].asString());
+        info.min_size = std::stod(data["minSz"].asString());
+        info.max_size = data.isMember("maxLmtSz") ? std::stod(data["maxLmtSz"].asString()) : 0.0;
+
+        std::lock_guard<std::mutex> lock(instruments_mutex_);
+        instruments_[inst_id] = info;
+        return info;
+    } catch (const std::exception& e) {
+        std::cerr << "Error parsing OKX instrument " << inst_id << ": " << e.what() << std::endl;
+        return std::nullopt;
+    }
+}
+
+std::optional<std::string> OkxExchange::http_get(const std::string& path) {
+    CURL* curl = curl_easy_init();
+    if (!curl) {
+        return std::nullopt;
+    }
+
+    std::string url = config_.api_url + path;
+    std::string response;
+    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_callback);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, static_cast<long>(config_.request_timeout_ms));
+
+    CURLcode res = curl_easy_perform(curl);
+    curl_easy_cleanup(curl);
+    if (res != CURLE_OK) {
+        std::cerr << "OKX request failed: " << curl_easy_strerror(res) << std::endl;
+        return std::nullopt;
+    }
+    return response;
+}
+
+// ========== Order Management (not supported) ==========
+
+std::optional<Order> OkxExchange::place_limit_order(const std::string&, OrderSide, double, double,
+                                                    const std::string&, bool) {
+    std::cerr << "OKX adapter is market data only" << std::endl;
+    return std::nullopt;
+}
+
+std::optional<Order> OkxExchange::place_market_order(const std::string&, OrderSide, double, const std::string&) {
+    std::cerr << "OKX adapter is market data only" << std::endl;
+    return std::nullopt;
+}
+
+std::optional<bool> OkxExchange::cancel_order(const std::string&, const std::string&) {
+    return std::nullopt;
+}
+
+std::optional<bool> OkxExchange::cancel_all_orders(const std::string&) {
+    // Nothing can be resting here
+    return true;
+}
+
+std::optional<Order> OkxExchange::modify_order(const std::string&, const std::string&, double, double) {
+    return std::nullopt;
+}
+
+std::optional<std::vector<Order>> OkxExchange::get_open_orders(const std::string&) {
+    return std::vector<Order>{};
+}
+
+std::optional<Order> OkxExchange::get_order_status(const std::string&, const std::string&) {
+    return std::nullopt;
+}
+
+std::optional<std::string> OkxExchange::get_account_info() {
+    return std::nullopt;
+}
+
+std::optional<double> OkxExchange::get_balance(const std::string&) {
+    return std::nullopt;
+}
+
+// ========== Event Handlers ==========
+
+void OkxExchange::set_orderbook_handler(OrderbookHandler handler) {
+    orderbook_handler_ = handler;
+}
+
+void OkxExchange::set_message_handler(MessageHandler handler) {
+    message_handler_ = handler;
+}
+
+void OkxExchange::set_connection_handler(ConnectionHandler handler) {
+    connection_handler_ = handler;
+}
+
+// ========== Utility Methods ==========
+
+bool OkxExchange::get_symbol_info(const std::string& symbol, int& price_precision, int& quantity_precision) {
+    auto info = get_instrument(convert_symbol_to_okx(symbol));
+    if (!info) {
+        return false;
+    }
+    price_precision = decimals_of(info->tick_size);
+    quantity_precision = decimals_of(info->lot_size);
+    return true;
+}
+
+double OkxExchange::format_price(double price, const std::string& symbol) {
+    double tick = get_tick_size(symbol);
+    return tick > 0 ? std::round(price / tick) * tick : price;
+}
+
+double OkxExchange::format_quantity(double quantity, const std::string& symbol) {
+    auto info = get_instrument(convert_symbol_to_okx(symbol));
+    if (!info || info->lot_size <= 0) {
+        return quantity;
+    }
+    return std::floor(quantity / info->lot_size) * info->lot_size;
+}
+
+double OkxExchange::get_min_order_size(const std::string& symbol) {
+    auto info = get_instrument(convert_symbol_to_okx(symbol));
+    return info ? info->min_size : 0.0;
+}
+
+double OkxExchange::get_max_order_size(const std::string& symbol) {
+    auto info = get_instrument(convert_symbol_to_okx(symbol));
+    return info && info->max_size > 0 ? info->max_size : 1e9;
+}
+
+double OkxExchange::get_tick_size(const std::string& symbol) {
+    auto info = get_instrument(convert_symbol_to_okx(symbol));
+    return info ? info->tick_size : 0.0;
+}
+
+std::string OkxExchange::convert_symbol_to_okx(const std::string& symbol) const {
+    std::string result = symbol;
+    std::transform(result.begin(), result.end(), result.begin(), ::toupper);
+
+    size_t slash = result.find('/');
+    if (slash != std::string::npos) {
+        result[slash] = '-';
+        return result;
+    }
+    if (result.find('-') != std::string::npos) {
+        return result;
+    }
+
+    for (const auto& quote : quote_currencies_) {
+        if (result.size() > quote.size() &&
+            result.compare(result.size() - quote.size(), quote.size(), quote) == 0) {
+            return result.substr(0, result.size() - quote.size()) + "-" + quote;
+        }
+    }
+    return result;
+}
+
+} // namespace MarketMaker
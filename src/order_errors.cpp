@@ -0,0 +1,145 @@
+#include "order_errors.h"
+#include "flight_recorder.h"
+#include <iostream>
+#include <algorithm>
+#include <cctype>
+
+namespace MarketMaker {
+
+namespace {
+
+bool contains_ignore_case(const std::string& text, const std::string& needle) {
+    auto it = std::search(text.begin(), text.end(), needle.begin(), needle.end(),
+                          [](char a, char b) {
+                              return std::tolower(static_cast<unsigned char>(a)) ==
+                                     std::tolower(static_cast<unsigned char>(b));
+                          });
+    return it != text.end();
+}
+
+} // namespace
+
+OrderErrorTracker::OrderErrorTracker() {
+    // Binance spot defaults; config "errors.policies" overrides per code
+    policies_[-1003] = {OrderErrorAction::PAUSE_ALL, ""};           // Too much request weight / IP ban
+    policies_[-1015] = {OrderErrorAction::PAUSE_ORDERS, ""};        // Too many new orders
+    policies_[-1021] = {OrderErrorAction::RESYNC_CLOCK, ""};        // Timestamp outside recvWindow
+    policies_[-2010] = {OrderErrorAction::DISABLE_SIDE, "insufficient balance"};
+}
+
+void OrderErrorTracker::record(const OrderError& error) {
+    OrderErrorAction action = OrderErrorAction::NONE;
+    ActionHandler handler;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.total++;
+        stats_.by_code[error.code]++;
+        stats_.by_symbol[error.symbol][error.code]++;
+        stats_.last_code = error.code;
+        stats_.last_message = error.message;
+        if (is_post_only_reject(error)) {
+            stats_.post_only_rejects++;
+        }
+
+        auto it = policies_.find(error.code);
+        if (it != policies_.end() &&
+            (it->second.match.empty() || contains_ignore_case(error.message, it->second.match))) {
+            action = it->second.action;
+        }
+        handler = handler_;
+    }
+
+    FlightRecorder::instance().record(FlightEventType::REJECT,
+                                      error.has_side ? FlightRecorder::side_of(error.side) : FlightSide::NONE,
+                                      0.0, 0.0, error.code, error.message);
+
+    std::cerr << "[ERRORS] " << error.transport << " " << error.symbol;
+    if (error.has_side) {
+        std::cerr << " " << (error.side == OrderSide::BUY ? "BUY" : "SELL");
+    }
+    std::cerr << " code " << error.code << ": " << error.message;
+    if (action != OrderErrorAction::NONE) {
+        std::cerr << " -> " << action_name(action);
+    }
+    std::cerr << std::endl;
+
+    if (action != OrderErrorAction::NONE && handler) {
+        handler(error, action);
+    }
+}
+
+void OrderErrorTracker::set_policy(int code, const ErrorPolicy& policy) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (policy.action == OrderErrorAction::NONE) {
+        policies_.erase(code);
+    } else {
+        policies_[code] = policy;
+    }
+}
+
+void OrderErrorTracker::set_action_handler(ActionHandler handler) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    handler_ = std::move(handler);
+}
+
+OrderErrorTracker::Stats OrderErrorTracker::get_stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void OrderErrorTracker::reset_stats() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_ = Stats();
+}
+
+void OrderErrorTracker::log_status() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::cout << "[ERRORS] Total: " << stats_.total;
+    for (const auto& [code, count] : stats_.by_code) {
+        std::cout << ", " << code << " x" << count;
+    }
+    if (stats_.total > 0) {
+        std::cout << " (last: " << stats_.last_message << ")";
+    }
+    std::cout << std::endl;
+}
+
+OrderErrorAction OrderErrorTracker::parse_action(const std::string& name) {
+    if (name == "pause_all" || name == "pause") return OrderErrorAction::PAUSE_ALL;
+    if (name == "pause_orders") return OrderErrorAction::PAUSE_ORDERS;
+    if (name == "resync_clock") return OrderErrorAction::RESYNC_CLOCK;
+    if (name == "disable_side") return OrderErrorAction::DISABLE_SIDE;
+    return OrderErrorAction::NONE;
+}
+
+const char* OrderErrorTracker::action_name(OrderErrorAction action) {
+    switch (action) {
+        case OrderErrorAction::PAUSE_ALL: return "pause_all";
+        case OrderErrorAction::PAUSE_ORDERS: return "pause_orders";
+        case OrderErrorAction::RESYNC_CLOCK: return "resync_clock";
+        case OrderErrorAction::DISABLE_SIDE: return "disable_side";
+        case OrderErrorAction::NONE: break;
+    }
+    return "none";
+}
+
+int64_t OrderErrorTracker::parse_banned_until(const std::string& message) {
+    size_t pos = message.find("until ");
+    if (pos == std::string::npos) {
+        return 0;
+    }
+
+    int64_t value = 0;
+    for (size_t i = pos + 6; i < message.size() && std::isdigit(static_cast<unsigned char>(message[i])); ++i) {
+        value = value * 10 + (message[i] - '0');
+    }
+    return value;
+}
+
+bool OrderErrorTracker::is_post_only_reject(const OrderError& error) {
+    return error.code == -2010 && contains_ignore_case(error.message, "immediately match");
+}
+
+} // namespace MarketMaker
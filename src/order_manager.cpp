@@ -1,4 +1,7 @@
 #include "order_manager.h"
+#include "rate_limiter.h"
+#include "exchange_clock.h"
+#include "flight_recorder.h"
 #include <iostream>
 #include <sstream>
 #include <iomanip>
@@ -7,12 +10,75 @@
 
 namespace MarketMaker {
 
+namespace {
+
+std::future<OrderScheduler::OrderResult> failed_order() {
+    std::promise<OrderScheduler::OrderResult> promise;
+    OrderScheduler::OrderResult result;
+    result.outcome = OrderScheduler::Outcome::FAILED;
+    promise.set_value(result);
+    return promise.get_future();
+}
+
+} // namespace
+
 OrderManager::OrderManager(std::shared_ptr<IExchange> exchange, const Config& config)
-    : exchange_(exchange), config_(config) {
+    : exchange_(exchange), config_(config), params_(StrategyParams::from_config(config)),
+      slo_(config.latency_slo) {
     metrics_.start_time = std::chrono::steady_clock::now();
+
+    // Each sub-account brings its own order budget; ShardedExchange keeps
+    // every account within its own, so this is only the aggregate cap
+    int accounts = 1 + static_cast<int>(config_.sub_accounts.size());
+    OrderRateLimiter::instance().configure(config_.max_orders_per_second * accounts,
+                                           config_.max_cancels_per_second * accounts);
+    // With sub-accounts the per-account segments (ShardedExchange) are shared
+    // instead: the main key's segment must stay at one account's rate
+    if (config_.shared_rate_limit && accounts == 1 &&
+        !OrderRateLimiter::instance().share_with_processes(config_.api_key, config_.symbol)) {
+        std::cerr << "[RATE LIMIT] Shared budget unavailable, limiting this process only" << std::endl;
+    }
+    // Inline mode sends on the feed thread itself
+    scheduler_ = std::make_unique<OrderScheduler>(exchange_, config_.inline_strategy ? 0 : config_.order_scheduler_workers);
+
+    filters_ = exchange_->get_symbol_filters(config_.symbol);
+    if (filters_) {
+        std::cout << "[FILTER] " << config_.symbol << ": tick=" << filters_->tick_size
+                  << ", step=" << filters_->step_size
+                  << ", minNotional=" << filters_->min_notional
+                  << ", maxNumOrders=" << filters_->max_num_orders << std::endl;
+    } else {
+        std::cout << "[FILTER] No exchange filters for " << config_.symbol
+                  << ", orders are sent unchecked" << std::endl;
+    }
+
+    PlacementParams placement;
+    placement.mode = QuotePlacer::parse_mode(config_.quote_placement);
+    placement.depth = config_.placement_depth;
+    placement.improve_min_spread_ticks = config_.improve_min_spread_ticks;
+    placement.wall_size = config_.placement_wall_size;  // Times each tick's order_size
+    placer_ = QuotePlacer(tick_size(), placement);
+
+    // Precomputed quotes only depend on the mid in "spread" placement
+    if (placement.mode == PlacementMode::SPREAD) {
+        quote_cache_ = QuoteCache(config_.quote_cache_ticks, tick_size());
+    }
+
+    auto& error_tracker = OrderErrorTracker::instance();
+    for (const auto& [code, policy] : config_.error_policies) {
+        error_tracker.set_policy(code, policy);
+    }
+    error_tracker.set_action_handler([this](const OrderError& error, OrderErrorAction action) {
+        apply_error_action(error, action);
+    });
+
+    if (!config_.decision_journal.empty()) {
+        journal_.open(config_.decision_journal);
+    }
 }
 
 OrderManager::~OrderManager() {
+    OrderErrorTracker::instance().set_action_handler(nullptr);
     cancel_all_active_orders();
 }
 
@@ -21,55 +87,90 @@ bool OrderManager::place_market_maker_orders(double mid_price) {
 }
 
 bool OrderManager::place_market_maker_orders(double mid_price, const std::chrono::steady_clock::time_point& orderbook_time) {
+    return place_market_maker_orders(mid_price, orderbook_time, effective_params());
+}
+
+bool OrderManager::place_market_maker_orders(double mid_price, const std::chrono::steady_clock::time_point& orderbook_time,
+                                             const StrategyParams& params) {
     if (mid_price <= 0) {
         std::cerr << "Invalid mid price: " << mid_price << std::endl;
+        journal_decision(JournalAction::INVALID_INPUT, 0, mid_price, params, 0.0, 0.0);
+        return false;
+    }
+    if (!slo_.quoting_allowed()) {
+        std::cout << "[SLO] Quotes pulled (" << LatencySloController::level_name(slo_.level())
+                  << "), not placing" << std::endl;
+        journal_decision(JournalAction::PULLED, REASON_SLO_PULLED, mid_price, params, 0.0, 0.0);
         return false;
     }
 
     auto start_time = std::chrono::steady_clock::now();
     auto t1 = start_time;
 
-    // Pre-calculate prices before any network I/O
-    double spread_multiplier = config_.spread_percentage;
-    double bid_multiplier = 1.0 - spread_multiplier;
-    double ask_multiplier = 1.0 + spread_multiplier;
-
-    double bid_price_raw = mid_price * bid_multiplier;
-    double ask_price_raw = mid_price * ask_multiplier;
-
-    double bid_price = format_price(bid_price_raw);
-    double ask_price = format_price(ask_price_raw);
-
-    auto t2 = std::chrono::steady_clock::now();
-    auto calc_time = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count();
-
-    // Price calculation logging
-    std::cout << "\n=====================================================" << std::endl;
-    std::cout << "  PRICE CALCULATION" << std::endl;
-    std::cout << "=====================================================" << std::endl;
-    std::cout << "  Mid Price:       $" << std::fixed << std::setprecision(5)
-              << mid_price << " (from OrderBook)" << std::endl;
-    std::cout << "  Spread Config:    " << std::fixed << std::setprecision(1)
-              << (spread_multiplier * 100) << "%" << std::endl;
-    std::cout << "-----------------------------------------------------" << std::endl;
-    std::cout << "  BUY Order (BID):" << std::endl;
-    std::cout << "    Formula: MidPrice × (1 - Spread)" << std::endl;
-    std::cout << "    Calc: " << std::fixed << std::setprecision(5) << mid_price << " × " << std::setprecision(4)
-              << bid_multiplier << " = " << std::setprecision(7) << bid_price_raw
-              << " -> $" << std::setprecision(5) << bid_price << std::endl;
-    std::cout << "-----------------------------------------------------" << std::endl;
-    std::cout << "  SELL Order (ASK):" << std::endl;
-    std::cout << "    Formula: MidPrice × (1 + Spread)" << std::endl;
-    std::cout << "    Calc: " << std::fixed << std::setprecision(5) << mid_price << " × " << std::setprecision(4)
-              << ask_multiplier << " = " << std::setprecision(7) << ask_price_raw
-              << " -> $" << std::setprecision(5) << ask_price << std::endl;
-    std::cout << "-----------------------------------------------------" << std::endl;
-    std::cout << "  Calc Time: " << calc_time << " us" << std::endl;
-    std::cout << "=====================================================" << std::endl;
+    // Quotes precomputed for this mid skip pricing, formatting and the filter check
+    const QuoteSet* prepared = quote_cache_.enabled() ? quote_cache_.lookup(mid_price, quote_generation(params)) : nullptr;
+    double bid_price = 0.0;
+    double ask_price = 0.0;
+
+    if (prepared) {
+        bid_price = prepared->bid.price;
+        ask_price = prepared->ask.price;
+        std::cout << "[QUOTE CACHE] Mid " << std::fixed << std::setprecision(5) << mid_price
+                  << " precomputed: BID " << bid_price << ", ASK " << ask_price << std::endl;
+    } else {
+        // Pre-calculate prices before any network I/O
+        double spread_multiplier = params.spread_percentage;
+        double bid_multiplier = 1.0 - spread_multiplier;
+        double ask_multiplier = 1.0 + spread_multiplier;
+
+        double bid_price_raw = mid_price * bid_multiplier;
+        double ask_price_raw = mid_price * ask_multiplier;
+
+        // Long inventory shifts both quotes down (and short shifts them up)
+        double skew = inventory_shift(mid_price, params);
+        bid_price = place_quote(OrderSide::BUY, bid_price_raw - skew, params);
+        ask_price = place_quote(OrderSide::SELL, ask_price_raw - skew, params);
+
+        auto t2 = std::chrono::steady_clock::now();
+        auto calc_time = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count();
+
+        // Price calculation logging
+        std::cout << "\n=====================================================" << std::endl;
+        std::cout << "  PRICE CALCULATION" << std::endl;
+        std::cout << "=====================================================" << std::endl;
+        std::cout << "  Mid Price:       $" << std::fixed << std::setprecision(5)
+                  << mid_price << " (from OrderBook)" << std::endl;
+        std::cout << "  Spread Config:    " << std::fixed << std::setprecision(1)
+                  << (spread_multiplier * 100) << "%" << std::endl;
+        std::cout << "-----------------------------------------------------" << std::endl;
+        std::cout << "  BUY Order (BID):" << std::endl;
+        std::cout << "    Formula: MidPrice × (1 - Spread)" << std::endl;
+        std::cout << "    Calc: " << std::fixed << std::setprecision(5) << mid_price << " × " << std::setprecision(4)
+                  << bid_multiplier << " = " << std::setprecision(7) << bid_price_raw
+                  << " -> $" << std::setprecision(5) << bid_price << std::endl;
+        std::cout << "-----------------------------------------------------" << std::endl;
+        std::cout << "  SELL Order (ASK):" << std::endl;
+        std::cout << "    Formula: MidPrice × (1 + Spread)" << std::endl;
+        std::cout << "    Calc: " << std::fixed << std::setprecision(5) << mid_price << " × " << std::setprecision(4)
+                  << ask_multiplier << " = " << std::setprecision(7) << ask_price_raw
+                  << " -> $" << std::setprecision(5) << ask_price << std::endl;
+        std::cout << "-----------------------------------------------------" << std::endl;
+        if (skew != 0.0) {
+            std::cout << "  Inventory Skew:  -" << std::setprecision(7) << skew
+                      << " (inventory " << std::setprecision(5) << inventory_.load() << ")" << std::endl;
+        }
+        if (placer_.params().mode != PlacementMode::SPREAD) {
+            std::cout << "  Placement:       " << QuotePlacer::mode_name(placer_.params().mode)
+                      << " (book-adjusted prices above)" << std::endl;
+        }
+        std::cout << "  Calc Time: " << calc_time << " us" << std::endl;
+        std::cout << "=====================================================" << std::endl;
+    }
 
     // OPTIMIZATION: Check if price change is significant enough
     const double PRICE_CHANGE_THRESHOLD = 0.0001; // 0.01% minimum change
     bool need_update = false;
+    uint16_t reasons = prepared ? REASON_QUOTE_CACHE : 0;
 
     {
         std::lock_guard<std::mutex> lock(orders_mutex_);
@@ -78,12 +179,14 @@ bool OrderManager::place_market_maker_orders(double mid_price, const std::chrono
         if (!active_bid_order_ || !active_ask_order_) {
             // No active orders, must place new ones
             need_update = true;
+            reasons |= REASON_NO_ACTIVE_ORDERS;
             std::cout << "[UPDATE] No active orders, placing new ones" << std::endl;
         } else {
             // Check if price changed significantly
             double price_change_ratio = std::abs(mid_price - last_mid_price_) / last_mid_price_;
             if (price_change_ratio > PRICE_CHANGE_THRESHOLD) {
                 need_update = true;
+                reasons |= REASON_PRICE_MOVED;
                 std::cout << "[UPDATE] Price change " << std::fixed << std::setprecision(5)
                           << (price_change_ratio * 100)
                           << "% exceeds threshold, updating orders" << std::endl;
@@ -91,66 +194,108 @@ bool OrderManager::place_market_maker_orders(double mid_price, const std::chrono
                 std::cout << "[SKIP] Price change " << std::fixed << std::setprecision(5)
                           << (price_change_ratio * 100)
                           << "% below threshold, skipping update" << std::endl;
-                return true; // Skip update
+                reasons |= REASON_BELOW_THRESHOLD;
             }
         }
     }
 
     if (!need_update) {
+        journal_decision(JournalAction::SKIP, reasons, mid_price, params, bid_price, ask_price);
+        return true;
+    }
+
+    // Requote planner: a quote near the front of its queue and still close to
+    // the target price is worth more than a fresh one at the back
+    bool keep_bid = false;
+    bool keep_ask = false;
+    std::shared_ptr<Order> bid_order_to_cancel;
+    std::shared_ptr<Order> ask_order_to_cancel;
+    {
+        std::lock_guard<std::mutex> lock(orders_mutex_);
+        keep_bid = should_keep_quote(active_bid_order_, bid_price, mid_price, params);
+        keep_ask = should_keep_quote(active_ask_order_, ask_price, mid_price, params);
+        if (!keep_bid) {
+            bid_order_to_cancel = active_bid_order_;
+        }
+        if (!keep_ask) {
+            ask_order_to_cancel = active_ask_order_;
+        }
+    }
+
+    auto& recorder = FlightRecorder::instance();
+    recorder.record(FlightEventType::DECISION, FlightSide::BID, bid_price, params.order_size, keep_bid);
+    recorder.record(FlightEventType::DECISION, FlightSide::ASK, ask_price, params.order_size, keep_ask);
+
+    JournalAction action = keep_bid ? (keep_ask ? JournalAction::KEEP : JournalAction::REPLACE_ASK)
+                                    : (keep_ask ? JournalAction::REPLACE_BID : JournalAction::REPLACE_BOTH);
+    reasons |= (keep_bid ? REASON_KEEP_BID_QUEUE : 0) | (keep_ask ? REASON_KEEP_ASK_QUEUE : 0);
+    journal_decision(action, reasons, mid_price, params, bid_price, ask_price);
+
+    if (keep_bid && keep_ask) {
+        last_mid_price_ = mid_price;
         return true;
     }
 
     std::cout << "\n=========== PLACING NEW ORDERS ===========" << std::endl;
     std::cout << "  Mid Price: $" << std::fixed << std::setprecision(5) << mid_price << std::endl;
-    std::cout << "  BID (Buy):  $" << bid_price << " [Qty: " << config_.order_size << "]" << std::endl;
-    std::cout << "  ASK (Sell): $" << ask_price << " [Qty: " << config_.order_size << "]" << std::endl;
+    if (!keep_bid) {
+        std::cout << "  BID (Buy):  $" << bid_price << " [Qty: " << params.order_size << "]" << std::endl;
+    }
+    if (!keep_ask) {
+        std::cout << "  ASK (Sell): $" << ask_price << " [Qty: " << params.order_size << "]" << std::endl;
+    }
     std::cout << "==========================================" << std::endl;
 
-    // OPTIMIZATION: Try to modify existing orders first if they exist
-    bool bid_success = false;
-    bool ask_success = false;
+    bool bid_success = keep_bid;
+    bool ask_success = keep_ask;
 
     auto t3 = std::chrono::steady_clock::now();
 
-    // Copy orders outside of lock to minimize critical section
-    std::shared_ptr<Order> bid_order_to_cancel;
-    std::shared_ptr<Order> ask_order_to_cancel;
-    {
-        std::lock_guard<std::mutex> lock(orders_mutex_);
-        bid_order_to_cancel = active_bid_order_;
-        ask_order_to_cancel = active_ask_order_;
-    }
-
-    // Cancel both orders in parallel if they exist
-    if (bid_order_to_cancel && ask_order_to_cancel) {
-        // Use async with timeout for better control
-        auto cancel_bid_future = std::async(std::launch::async, [this, bid_order_to_cancel]() {
-            return cancel_order(bid_order_to_cancel);
-        });
-        auto cancel_ask_future = std::async(std::launch::async, [this, ask_order_to_cancel]() {
-            return cancel_order(ask_order_to_cancel);
-        });
+    // Cancel whatever is being replaced (both sides, or one after a fill or a
+    // kept quote) in parallel. The scheduler sends cancels ahead of the new
+    // orders below even if we stop waiting for them.
+    if (bid_order_to_cancel || ask_order_to_cancel) {
+        std::future<OrderScheduler::CancelResult> cancel_bid_future;
+        std::future<OrderScheduler::CancelResult> cancel_ask_future;
+        if (bid_order_to_cancel) {
+            cancel_bid_future = submit_cancel(bid_order_to_cancel);
+        }
+        if (ask_order_to_cancel) {
+            cancel_ask_future = submit_cancel(ask_order_to_cancel);
+        }
 
         // Wait with timeout (100ms max per cancel)
         constexpr auto timeout = std::chrono::milliseconds(100);
 
-        if (cancel_bid_future.wait_for(timeout) == std::future_status::ready) {
-            cancel_bid_future.get();
-        } else {
-            std::cerr << "[WARNING] Cancel BID timeout after 100ms" << std::endl;
+        if (cancel_bid_future.valid()) {
+            if (cancel_bid_future.wait_for(timeout) == std::future_status::ready) {
+                handle_cancel_result(bid_order_to_cancel, cancel_bid_future.get());
+            } else {
+                std::cerr << "[WARNING] Cancel BID timeout after 100ms" << std::endl;
+                recorder.trigger("cancel_timeout");
+            }
         }
 
-        if (cancel_ask_future.wait_for(timeout) == std::future_status::ready) {
-            cancel_ask_future.get();
-        } else {
-            std::cerr << "[WARNING] Cancel ASK timeout after 100ms" << std::endl;
+        if (cancel_ask_future.valid()) {
+            if (cancel_ask_future.wait_for(timeout) == std::future_status::ready) {
+                handle_cancel_result(ask_order_to_cancel, cancel_ask_future.get());
+            } else {
+                std::cerr << "[WARNING] Cancel ASK timeout after 100ms" << std::endl;
+                recorder.trigger("cancel_timeout");
+            }
         }
 
-        // Clear active orders after cancellation attempt
+        // Clear replaced orders after cancellation attempt
         {
             std::lock_guard<std::mutex> lock(orders_mutex_);
-            active_bid_order_.reset();
-            active_ask_order_.reset();
+            if (bid_order_to_cancel) {
+                active_bid_order_.reset();
+                queue_.on_order_removed(OrderSide::BUY, bid_order_to_cancel->order_id);
+            }
+            if (ask_order_to_cancel) {
+                active_ask_order_.reset();
+                queue_.on_order_removed(OrderSide::SELL, ask_order_to_cancel->order_id);
+            }
         }
     }
 
@@ -158,30 +303,40 @@ bool OrderManager::place_market_maker_orders(double mid_price, const std::chrono
     auto cancel_time = std::chrono::duration_cast<std::chrono::microseconds>(t4 - t3).count();
     std::cout << "[LATENCY] Cancel orders: " << cancel_time << " μs" << std::endl;
 
-    // OPTIMIZATION: Use threads instead of async to avoid overhead
+    // Replaced sides go out in parallel on the scheduler's workers
     auto t5 = std::chrono::steady_clock::now();
-    std::thread bid_thread([this, bid_price, &bid_success]() {
-        auto thread_start = std::chrono::steady_clock::now();
-        bid_success = place_order(OrderSide::BUY, bid_price, config_.order_size);
-        auto thread_end = std::chrono::steady_clock::now();
-        auto thread_time = std::chrono::duration_cast<std::chrono::microseconds>(thread_end - thread_start).count();
-        std::cout << "[LATENCY] BID order placement: " << thread_time << " μs" << std::endl;
-    });
+    std::future<OrderScheduler::OrderResult> bid_future;
+    std::future<OrderScheduler::OrderResult> ask_future;
+    if (!keep_bid) {
+        bid_future = prepared ? submit_prepared(OrderSide::BUY, prepared->bid, mid_price)
+                              : submit_order(OrderSide::BUY, bid_price, params.order_size, mid_price);
+    }
+    if (!keep_ask) {
+        ask_future = prepared ? submit_prepared(OrderSide::SELL, prepared->ask, mid_price)
+                              : submit_order(OrderSide::SELL, ask_price, params.order_size, mid_price);
+    }
 
-    std::thread ask_thread([this, ask_price, &ask_success]() {
-        auto thread_start = std::chrono::steady_clock::now();
-        ask_success = place_order(OrderSide::SELL, ask_price, config_.order_size);
-        auto thread_end = std::chrono::steady_clock::now();
-        auto thread_time = std::chrono::duration_cast<std::chrono::microseconds>(thread_end - thread_start).count();
-        std::cout << "[LATENCY] ASK order placement: " << thread_time << " μs" << std::endl;
-    });
+    if (bid_future.valid()) {
+        auto bid_result = bid_future.get();
+        auto bid_time = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - t5).count();
+        record_ack(bid_result);
+        std::cout << "[LATENCY] BID order placement: " << bid_time << " μs" << std::endl;
+        bid_success = handle_order_result(OrderSide::BUY, bid_price, params.order_size, bid_result);
+    }
+
+    if (ask_future.valid()) {
+        auto ask_result = ask_future.get();
+        auto ask_time = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - t5).count();
+        record_ack(ask_result);
+        std::cout << "[LATENCY] ASK order placement: " << ask_time << " μs" << std::endl;
+        ask_success = handle_order_result(OrderSide::SELL, ask_price, params.order_size, ask_result);
+    }
 
-    // Wait for both threads
-    bid_thread.join();
-    ask_thread.join();
     auto t6 = std::chrono::steady_clock::now();
     auto thread_time = std::chrono::duration_cast<std::chrono::microseconds>(t6 - t5).count();
-    std::cout << "[LATENCY] Total thread execution: " << thread_time << " μs" << std::endl;
+    std::cout << "[LATENCY] Total placement: " << thread_time << " μs" << std::endl;
 
     last_mid_price_ = mid_price;
     last_order_update_ = std::chrono::steady_clock::now();
@@ -210,47 +365,187 @@ bool OrderManager::cancel_all_active_orders() {
     std::lock_guard<std::mutex> lock(orders_mutex_);
 
     // Cancel both orders in parallel if they exist
-    std::vector<std::future<bool>> cancel_futures;
+    std::vector<std::pair<std::shared_ptr<Order>, std::future<OrderScheduler::CancelResult>>> cancels;
 
     if (active_bid_order_) {
-        cancel_futures.push_back(std::async(std::launch::async,
-            [this, order = active_bid_order_]() {
-                return cancel_order(order);
-            }));
+        cancels.emplace_back(active_bid_order_, submit_cancel(active_bid_order_));
     }
 
     if (active_ask_order_) {
-        cancel_futures.push_back(std::async(std::launch::async,
-            [this, order = active_ask_order_]() {
-                return cancel_order(order);
-            }));
+        cancels.emplace_back(active_ask_order_, submit_cancel(active_ask_order_));
     }
 
     // Wait for all cancellations to complete
     bool success = true;
-    for (auto& future : cancel_futures) {
-        success &= future.get();
+    for (auto& [order, future] : cancels) {
+        success &= handle_cancel_result(order, future.get());
     }
 
     active_bid_order_.reset();
     active_ask_order_.reset();
+    queue_.on_order_removed(OrderSide::BUY);
+    queue_.on_order_removed(OrderSide::SELL);
 
     return success;
 }
 
+bool OrderManager::on_execution(const ExecutionReport& report, double mid_price) {
+    if (report.symbol != config_.symbol) {
+        return false;
+    }
+
+    const StrategyParams params = effective_params();
+
+    if (report.event_time_ms > 0) {
+        // Exchange event to strategy thread
+        auto event_time = ExchangeClock::instance().to_steady(report.event_time_ms);
+        slo_.record_feed(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - event_time).count());
+    }
+
+    if (report.is_trade && report.last_filled_quantity > 0) {
+        FlightRecorder::instance().record(FlightEventType::FILL, FlightRecorder::side_of(report.side),
+                                          report.last_filled_price, report.last_filled_quantity, 0,
+                                          report.order_id);
+        double signed_qty = report.side == OrderSide::BUY ? report.last_filled_quantity : -report.last_filled_quantity;
+        double inventory = inventory_.load() + signed_qty;
+        inventory_ = inventory;
+        quote_generation_++;  // Skew changed: precomputed quotes are stale
+
+        std::cout << "[FILL] " << (report.side == OrderSide::BUY ? "BID" : "ASK")
+                  << " " << report.last_filled_quantity << " @ " << report.last_filled_price
+                  << " (order " << report.order_id << ", inventory " << inventory << ")" << std::endl;
+
+        queue_.on_fill(report.side, report.order_id,
+                       std::max(report.quantity - report.cumulative_filled_quantity, 0.0));
+    }
+
+    // Orders are acked without their state (newOrderRespType=ACK), so fills
+    // and terminal states of the resting quotes are taken from here
+    if (report.status != OrderStatus::FILLED) {
+        std::lock_guard<std::mutex> lock(orders_mutex_);
+        auto& active = report.side == OrderSide::BUY ? active_bid_order_ : active_ask_order_;
+        if (!active || active->order_id != report.order_id) {
+            return false;
+        }
+
+        bool gone = report.status == OrderStatus::CANCELED || report.status == OrderStatus::REJECTED ||
+                    report.status == OrderStatus::EXPIRED;
+        if (gone) {
+            // Cancelled or expired by the exchange; the next update requotes it
+            std::cout << "[FILL] " << (report.side == OrderSide::BUY ? "BID" : "ASK") << " order "
+                      << report.order_id << " no longer resting" << std::endl;
+            active.reset();
+            queue_.on_order_removed(report.side, report.order_id);
+            return false;
+        }
+
+        // Copy on write: other threads may hold the previous snapshot
+        auto updated = std::make_shared<Order>(*active);
+        updated->executed_quantity = report.cumulative_filled_quantity;
+        updated->status = report.status;
+        updated->updated_time = report.received_time;
+        active = updated;
+        return false;
+    }
+
+    const OrderSide side = report.side;
+    const char* side_name = side == OrderSide::BUY ? "BID" : "ASK";
+    {
+        std::lock_guard<std::mutex> lock(orders_mutex_);
+        auto& active = side == OrderSide::BUY ? active_bid_order_ : active_ask_order_;
+        if (!active || active->order_id != report.order_id) {
+            return false;  // Not our current quote (e.g. filled while being replaced)
+        }
+        active.reset();
+        queue_.on_order_removed(side, report.order_id);
+    }
+
+    const uint16_t fill_reasons = REASON_FILL | (side == OrderSide::BUY ? REASON_BID_SIDE : REASON_ASK_SIDE);
+    if (!slo_.quoting_allowed()) {
+        std::cout << "[FILL] " << side_name << " requote skipped (quotes pulled on latency SLO)" << std::endl;
+        journal_decision(JournalAction::FILL_SKIP, fill_reasons | REASON_SLO_PULLED, mid_price, params, 0.0, 0.0);
+        return false;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    auto& last_requote = last_fill_requote_[static_cast<int>(side)];
+    if (now - last_requote < params.fill_requote_cooldown) {
+        std::cout << "[FILL] " << side_name << " requote skipped (fill cooldown)" << std::endl;
+        journal_decision(JournalAction::FILL_SKIP, fill_reasons | REASON_FILL_COOLDOWN, mid_price, params, 0.0, 0.0);
+        return false;
+    }
+    last_requote = now;
+
+    if (mid_price <= 0) {
+        mid_price = last_mid_price_.load();
+    }
+    if (mid_price <= 0) {
+        return false;
+    }
+
+    double multiplier = side == OrderSide::BUY ? 1.0 - params.spread_percentage : 1.0 + params.spread_percentage;
+    double price = place_quote(side, mid_price * multiplier - inventory_shift(mid_price, params), params);
+    journal_decision(JournalAction::FILL_REQUOTE, fill_reasons, mid_price, params,
+                     side == OrderSide::BUY ? price : 0.0, side == OrderSide::SELL ? price : 0.0);
+
+    auto result = submit_order(side, price, params.order_size, mid_price).get();
+    record_ack(result);
+    bool placed = handle_order_result(side, price, params.order_size, result);
+
+    auto fill_to_order_us = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - report.received_time).count();
+    histograms_.fill_to_order.record(fill_to_order_us);
+
+    std::cout << "[FILL] " << side_name << (placed ? " requoted at " : " requote failed at ")
+              << std::fixed << std::setprecision(5) << price
+              << ", fill-to-order " << fill_to_order_us << " us" << std::endl;
+
+    return placed;
+}
+
+void OrderManager::precompute_quotes(double mid_price) {
+    if (!quote_cache_.enabled() || mid_price <= 0 || !slo_.quoting_allowed()) {
+        return;
+    }
+
+    const StrategyParams params = effective_params();
+    quote_cache_.prepare(mid_price, quote_generation(params), [this, &params](double mid) {
+        QuoteSet quotes;
+        double skew = inventory_shift(mid, params);
+        quotes.bid = prepare_quote(OrderSide::BUY, mid * (1.0 - params.spread_percentage) - skew, mid, params);
+        quotes.ask = prepare_quote(OrderSide::SELL, mid * (1.0 + params.spread_percentage) - skew, mid, params);
+        return quotes;
+    });
+}
+
 bool OrderManager::update_orders_if_needed(double new_mid_price) {
     return update_orders_if_needed(new_mid_price, std::chrono::steady_clock::now());
 }
 
 bool OrderManager::update_orders_if_needed(double new_mid_price, const std::chrono::steady_clock::time_point& orderbook_time) {
-    if (!should_update_orders(new_mid_price)) {
+    // Book received to picked up by the strategy thread
+    slo_.record_feed(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - orderbook_time).count());
+
+    const StrategyParams params = effective_params();
+    if (!should_update_orders(new_mid_price, params)) {
         return true;  // No update needed
     }
 
     std::cout << "Mid price changed from " << last_mid_price_.load()
               << " to " << new_mid_price << " - updating orders" << std::endl;
 
-    return place_market_maker_orders(new_mid_price, orderbook_time);
+    return place_market_maker_orders(new_mid_price, orderbook_time, params);
+}
+
+void OrderManager::on_orderbook(const OrderBook& book) {
+    best_bid_.store(book.get_best_bid(), std::memory_order_relaxed);
+    best_ask_.store(book.get_best_ask(), std::memory_order_relaxed);
+    queue_.on_book(book);
+
+    std::lock_guard<std::mutex> lock(placer_mutex_);
+    placer_.set_book(book);
 }
 
 std::pair<std::shared_ptr<Order>, std::shared_ptr<Order>> OrderManager::get_active_orders() const {
@@ -263,6 +558,10 @@ LatencyMetrics OrderManager::get_metrics() const {
     return metrics_;
 }
 
+OrderScheduler::Stats OrderManager::get_scheduler_stats() const {
+    return scheduler_->get_stats();
+}
+
 void OrderManager::reset_metrics() {
     std::lock_guard<std::mutex> lock(metrics_mutex_);
     metrics_ = LatencyMetrics();
@@ -279,18 +578,114 @@ double OrderManager::format_quantity(double quantity) const {
     return std::round(quantity * multiplier) / multiplier;
 }
 
-bool OrderManager::place_order(OrderSide side, double price, double quantity) {
-    std::string client_order_id = generate_client_order_id(side);
+PreparedQuote OrderManager::prepare_quote(OrderSide side, double target_price, double mid_price,
+                                          const StrategyParams& params) const {
+    PreparedQuote quote;
+    quote.price = format_price(target_price);
+    quote.quantity = params.order_size;
+    quote.sendable = true;
+
+    if (filters_) {
+        // Checked as if the other side were resting, the most orders we keep open
+        auto check = ExchangeFilterCheck::check_limit_order(
+            *filters_, side, quote.price, quote.quantity, mid_price, 1);
+        quote.sendable = check.accepted();
+        if (check.status == FilterCheckResult::Status::ADJUSTED) {
+            quote.price = check.price;
+            quote.quantity = check.quantity;
+        }
+    }
+    return quote;
+}
+
+std::future<OrderScheduler::OrderResult> OrderManager::submit_prepared(OrderSide side, const PreparedQuote& quote,
+                                                                      double mid_price) {
+    if (!quote.sendable) {
+        filter_rejected_++;
+        std::cerr << "[FILTER] " << (side == OrderSide::BUY ? "BID" : "ASK") << " " << quote.quantity
+                  << " @ " << quote.price << " rejected locally (precomputed)" << std::endl;
+        return failed_order();
+    }
 
-    auto order_result = exchange_->place_limit_order(
-        config_.symbol,
-        side,
-        price,
-        quantity,
-        client_order_id
-    );
+    // Only the book can have moved under a precomputed quote; if post-only
+    // has to reprice it, take the full path with the new price
+    if (config_.post_only) {
+        double clamped = clamp_to_maker(side, quote.price);
+        if (clamped != quote.price) {
+            return submit_order(side, clamped, quote.quantity, mid_price);
+        }
+    }
+
+    if (!is_side_enabled(side)) {
+        std::cerr << "[ERRORS] " << (side == OrderSide::BUY ? "BID" : "ASK")
+                  << " quoting disabled by error policy, not sending" << std::endl;
+        return failed_order();
+    }
+
+    return scheduler_->submit_new(config_.symbol, side, quote.price, quote.quantity,
+                                  generate_client_order_id(side), config_.post_only);
+}
+
+std::future<OrderScheduler::OrderResult> OrderManager::submit_order(OrderSide side, double price, double quantity,
+                                                                   double reference_price) {
+    if (!is_side_enabled(side)) {
+        std::cerr << "[ERRORS] " << (side == OrderSide::BUY ? "BID" : "ASK")
+                  << " quoting disabled by error policy, not sending" << std::endl;
+        return failed_order();
+    }
 
-    if (!order_result) {
+    if (config_.post_only) {
+        price = clamp_to_maker(side, price);
+    }
+
+    if (filters_) {
+        int open_orders = 0;
+        {
+            std::lock_guard<std::mutex> lock(orders_mutex_);
+            open_orders = (active_bid_order_ ? 1 : 0) + (active_ask_order_ ? 1 : 0);
+        }
+
+        auto check = ExchangeFilterCheck::check_limit_order(
+            *filters_, side, price, quantity, reference_price, open_orders);
+        const char* side_name = side == OrderSide::BUY ? "BID" : "ASK";
+
+        if (!check.accepted()) {
+            // Would be rejected by the exchange: save the round trip
+            filter_rejected_++;
+            std::cerr << "[FILTER] " << side_name << " " << quantity << " @ " << price
+                      << " rejected locally: " << check.reason << std::endl;
+
+            return failed_order();
+        }
+
+        if (check.status == FilterCheckResult::Status::ADJUSTED) {
+            filter_adjusted_++;
+            std::cout << "[FILTER] " << side_name << " adjusted: " << quantity << " @ " << price
+                      << " -> " << check.quantity << " @ " << check.price << std::endl;
+            price = check.price;
+            quantity = check.quantity;
+        }
+    }
+
+    return scheduler_->submit_new(config_.symbol, side, price, quantity, generate_client_order_id(side),
+                                  config_.post_only);
+}
+
+bool OrderManager::handle_order_result(OrderSide side, double price, double quantity,
+                                       const OrderScheduler::OrderResult& result) {
+    if (result.outcome == OrderScheduler::Outcome::SUPERSEDED) {
+        std::cout << "[SCHEDULER] " << (side == OrderSide::BUY ? "BID" : "ASK")
+                  << " order at " << price << " superseded by a newer quote" << std::endl;
+        return false;
+    }
+    if (result.outcome == OrderScheduler::Outcome::DROPPED) {
+        std::cout << "[SCHEDULER] " << (side == OrderSide::BUY ? "BID" : "ASK")
+                  << " order at " << price << " held back (paused or out of rate budget)" << std::endl;
+        return false;
+    }
+
+    const auto& order_result = result.order;
+    if (result.outcome != OrderScheduler::Outcome::SENT || !order_result) {
         std::cerr << "Failed to place " << (side == OrderSide::BUY ? "BID" : "ASK")
                   << " order at " << price << std::endl;
 
@@ -299,12 +694,24 @@ bool OrderManager::place_order(OrderSide side, double price, double quantity) {
         return false;
     }
 
+    // Queue seed from the placer's copy of the book, which on_orderbook keeps current
+    std::optional<double> level_qty;
+    bool at_touch = true;
+    {
+        std::lock_guard<std::mutex> lock(placer_mutex_);
+        int64_t ticks = placer_.to_ticks(order_result->price);
+        level_qty = placer_.quantity_at(side, ticks);
+        at_touch = placer_.at_touch(side, ticks);
+    }
+
     std::lock_guard<std::mutex> lock(orders_mutex_);
     if (side == OrderSide::BUY) {
         active_bid_order_ = std::make_shared<Order>(*order_result);
     } else {
         active_ask_order_ = std::make_shared<Order>(*order_result);
     }
+    queue_.on_order_acked(side, order_result->order_id, order_result->price, order_result->quantity,
+                          level_qty, at_touch);
 
     std::cout << "Placed " << (side == OrderSide::BUY ? "BID" : "ASK")
               << " order: ID=" << order_result->order_id
@@ -314,14 +721,13 @@ bool OrderManager::place_order(OrderSide side, double price, double quantity) {
     return true;
 }
 
-bool OrderManager::cancel_order(const std::shared_ptr<Order>& order) {
-    if (!order) {
-        return true;  // Nothing to cancel
-    }
-
-    auto result = exchange_->cancel_order(config_.symbol, order->order_id);
+std::future<OrderScheduler::CancelResult> OrderManager::submit_cancel(const std::shared_ptr<Order>& order) {
+    return scheduler_->submit_cancel(config_.symbol, order->order_id);
+}
 
-    if (!result || !*result) {
+bool OrderManager::handle_cancel_result(const std::shared_ptr<Order>& order,
+                                        const OrderScheduler::CancelResult& result) {
+    if (result.outcome != OrderScheduler::Outcome::SENT) {
         std::cerr << "Failed to cancel order: " << order->order_id << std::endl;
         return false;
     }
@@ -330,7 +736,265 @@ bool OrderManager::cancel_order(const std::shared_ptr<Order>& order) {
     return true;
 }
 
-bool OrderManager::should_update_orders(double new_mid_price) const {
+void OrderManager::record_ack(const OrderScheduler::OrderResult& result) {
+    // Dropped, superseded and locally rejected requests resolve at once and
+    // would pull the ack percentile down exactly when throttled or paused
+    if (result.ack_us >= 0) {
+        slo_.record_ack(result.ack_us);
+    }
+}
+
+void OrderManager::pull_quotes() {
+    std::shared_ptr<Order> bid_order;
+    std::shared_ptr<Order> ask_order;
+    {
+        std::lock_guard<std::mutex> lock(orders_mutex_);
+        bid_order.swap(active_bid_order_);
+        ask_order.swap(active_ask_order_);
+        queue_.on_order_removed(OrderSide::BUY);
+        queue_.on_order_removed(OrderSide::SELL);
+    }
+
+    // Cancels still queued when we stop waiting (e.g. a PAUSE_ALL) go out
+    // from the scheduler once it allows; the caller may be a feed thread
+    constexpr auto timeout = std::chrono::milliseconds(100);
+    for (const auto& order : {bid_order, ask_order}) {
+        if (!order) {
+            continue;
+        }
+        auto future = submit_cancel(order);
+        if (future.wait_for(timeout) == std::future_status::ready) {
+            handle_cancel_result(order, future.get());
+        } else {
+            std::cerr << "[WARNING] Cancel " << (order->side == OrderSide::BUY ? "BID" : "ASK")
+                      << " still queued after 100ms (quotes pulled on latency SLO)" << std::endl;
+        }
+    }
+}
+
+double OrderManager::place_quote(OrderSide side, double target_price, const StrategyParams& params) {
+    if (placer_.params().mode == PlacementMode::SPREAD) {
+        return format_price(target_price);
+    }
+
+    std::lock_guard<std::mutex> lock(placer_mutex_);
+    return format_price(placer_.to_price(placer_.place(side, placer_.to_ticks(target_price), params.order_size)));
+}
+
+double OrderManager::clamp_to_maker(OrderSide side, double price) {
+    double tick = tick_size();
+    double clamped = price;
+
+    if (side == OrderSide::BUY) {
+        double best_ask = best_ask_.load(std::memory_order_relaxed);
+        if (best_ask > 0 && price > best_ask - tick / 2) {
+            clamped = format_price(best_ask - tick);
+        }
+    } else {
+        double best_bid = best_bid_.load(std::memory_order_relaxed);
+        if (best_bid > 0 && price < best_bid + tick / 2) {
+            clamped = format_price(best_bid + tick);
+        }
+    }
+
+    if (clamped != price) {
+        post_only_clamped_++;
+        std::cout << "[POST ONLY] " << (side == OrderSide::BUY ? "BID" : "ASK") << " "
+                  << std::fixed << std::setprecision(5) << price << " would cross, repriced to "
+                  << clamped << std::endl;
+    }
+    return clamped;
+}
+
+double OrderManager::tick_size() const {
+    if (filters_ && filters_->tick_size > 0) {
+        return filters_->tick_size;
+    }
+    return std::pow(10, -config_.price_precision);
+}
+
+bool OrderManager::should_keep_quote(const std::shared_ptr<Order>& order, double target_price,
+                                     double mid_price, const StrategyParams& params) const {
+    if (!order || params.queue_keep_max_drift <= 0) {
+        return false;
+    }
+
+    auto estimate = queue_.get(order->side);
+    if (!estimate || estimate->order_id != order->order_id) {
+        return false;
+    }
+
+    double drift = std::abs(order->price - target_price);
+    if (drift > mid_price * params.queue_keep_max_drift) {
+        return false;
+    }
+    if (estimate->ahead > params.queue_keep_max_ahead * params.order_size) {
+        return false;
+    }
+
+    std::cout << "[QUEUE] Keeping " << (order->side == OrderSide::BUY ? "BID" : "ASK")
+              << " " << order->order_id << " at " << std::fixed << std::setprecision(5) << order->price
+              << " (target " << target_price << ", ahead " << estimate->ahead
+              << " of " << estimate->level_qty << ")" << std::endl;
+    return true;
+}
+
+double OrderManager::inventory_shift(double mid_price, const StrategyParams& params) const {
+    if (params.order_size <= 0 || params.inventory_skew == 0.0) {
+        return 0.0;
+    }
+    return mid_price * params.inventory_skew * (inventory_.load() / params.order_size);
+}
+
+StrategyParams OrderManager::effective_params() const {
+    // One snapshot per tick, scaled by the latency SLO level
+    StrategyParams params = params_.get();
+    params.spread_percentage *= slo_.spread_factor();
+    params.order_size *= slo_.size_factor();
+    return params;
+}
+
+void OrderManager::journal_decision(JournalAction action, uint16_t reasons, double mid_price,
+                                    const StrategyParams& params, double bid_price, double ask_price) {
+    if (!journal_.is_open()) {
+        return;
+    }
+
+    double resting_bid = 0.0;
+    double resting_ask = 0.0;
+    {
+        std::lock_guard<std::mutex> lock(orders_mutex_);
+        resting_bid = active_bid_order_ ? active_bid_order_->price : 0.0;
+        resting_ask = active_ask_order_ ? active_ask_order_->price : 0.0;
+    }
+
+    // Everything the decision read: two runs fed the same inputs must hash alike
+    uint64_t input_id = DecisionJournal::HASH_SEED;
+    for (double input : {mid_price, last_mid_price_.load(), params.spread_percentage, params.order_size,
+                         params.inventory_skew, inventory_.load(), static_cast<double>(slo_.level()),
+                         resting_bid, resting_ask, best_bid_.load(), best_ask_.load()}) {
+        input_id = DecisionJournal::hash(input_id, input);
+    }
+
+    double skew = mid_price > 0 ? inventory_shift(mid_price, params) : 0.0;
+    if (skew != 0.0) {
+        reasons |= REASON_INVENTORY_SKEW;
+    }
+    if (slo_.level() != SloLevel::NORMAL) {
+        reasons |= REASON_SLO_SCALED;
+    }
+    if (placer_.params().mode != PlacementMode::SPREAD) {
+        reasons |= REASON_PLACEMENT;
+    }
+
+    JournalEntry entry;
+    entry.input_id = input_id;
+    entry.fair_value = mid_price;
+    entry.bid_target = mid_price * (1.0 - params.spread_percentage) - skew;
+    entry.ask_target = mid_price * (1.0 + params.spread_percentage) - skew;
+    entry.bid_price = bid_price;
+    entry.ask_price = ask_price;
+    entry.quantity = params.order_size;
+    entry.reasons = reasons;
+    entry.action = static_cast<uint8_t>(action);
+    journal_.record(entry);
+}
+
+void OrderManager::on_probe_rtt(int64_t rtt_us) {
+    std::lock_guard<std::mutex> lock(probe_mutex_);
+    if (probe_samples_.size() < MAX_PENDING_PROBES) {
+        probe_samples_.push_back(rtt_us);
+    }
+}
+
+void OrderManager::check_latency_slo() {
+    // Probes keep the ack window populated between (and while pulling) quotes
+    {
+        std::lock_guard<std::mutex> lock(probe_mutex_);
+        probe_drain_.swap(probe_samples_);
+    }
+    for (int64_t rtt_us : probe_drain_) {
+        slo_.record_ack(rtt_us);
+    }
+    probe_drain_.clear();
+
+    if (!slo_.evaluate(std::chrono::steady_clock::now())) {
+        return;
+    }
+    FlightRecorder::instance().record(FlightEventType::SLO_LEVEL, static_cast<int64_t>(slo_.level()),
+                                      LatencySloController::level_name(slo_.level()));
+
+    if (!slo_.quoting_allowed()) {
+        pull_quotes();
+    } else {
+        // Requote at the new spread/size on the next book update
+        last_mid_price_ = 0.0;
+    }
+}
+
+uint64_t OrderManager::quote_generation(const StrategyParams& params) const {
+    // New parameters, new inventory and a new SLO level all invalidate
+    // precomputed quotes
+    return (params.version << 32) | (static_cast<uint64_t>(slo_.level()) << 28) |
+           (quote_generation_ & 0x0fffffff);
+}
+
+void OrderManager::apply_error_action(const OrderError& error, OrderErrorAction action) {
+    auto now = std::chrono::steady_clock::now();
+
+    switch (action) {
+        case OrderErrorAction::PAUSE_ALL:
+        case OrderErrorAction::PAUSE_ORDERS: {
+            // Wait exactly as long as the exchange asked, if it said
+            auto until = error.retry_after_ms > 0
+                ? ExchangeClock::instance().to_steady(error.retry_after_ms)
+                : now + std::chrono::milliseconds(config_.error_pause_ms);
+            auto from = action == OrderErrorAction::PAUSE_ALL
+                ? OrderScheduler::Priority::CANCEL
+                : OrderScheduler::Priority::REPLACE;
+            scheduler_->pause_until(until, from);
+
+            std::cerr << "[ERRORS] Pausing " << (action == OrderErrorAction::PAUSE_ALL ? "all requests" : "new orders")
+                      << " for " << std::chrono::duration_cast<std::chrono::milliseconds>(until - now).count()
+                      << " ms" << std::endl;
+            break;
+        }
+
+        case OrderErrorAction::RESYNC_CLOCK: {
+            // Off the caller's thread: it may be the transport's reader
+            std::lock_guard<std::mutex> lock(clock_resync_mutex_);
+            if (clock_resync_.valid() &&
+                clock_resync_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                break;  // One already running
+            }
+            auto exchange = exchange_;
+            clock_resync_ = std::async(std::launch::async, [exchange]() { exchange->sync_clock(); });
+            break;
+        }
+
+        case OrderErrorAction::DISABLE_SIDE: {
+            if (!error.has_side || error.symbol != config_.symbol) {
+                break;
+            }
+            auto until = now + std::chrono::milliseconds(config_.side_disable_ms);
+            side_disabled_until_[static_cast<int>(error.side)] = until.time_since_epoch().count();
+
+            std::cerr << "[ERRORS] " << (error.side == OrderSide::BUY ? "BID" : "ASK")
+                      << " quoting disabled for " << config_.side_disable_ms << " ms" << std::endl;
+            break;
+        }
+
+        case OrderErrorAction::NONE:
+            break;
+    }
+}
+
+bool OrderManager::is_side_enabled(OrderSide side) const {
+    int64_t until = side_disabled_until_[static_cast<int>(side)].load();
+    return until == 0 || std::chrono::steady_clock::now().time_since_epoch().count() >= until;
+}
+
+bool OrderManager::should_update_orders(double new_mid_price, const StrategyParams& params) const {
     // Check if price has changed
     double current_mid = last_mid_price_.load();
     if (std::abs(new_mid_price - current_mid) < 0.00001) {
@@ -343,7 +1007,7 @@ bool OrderManager::should_update_orders(double new_mid_price) const {
         now - last_order_update_
     );
 
-    if (time_since_last_update < config_.order_update_cooldown) {
+    if (time_since_last_update < params.order_update_cooldown) {
         return false;  // Still in cooldown period
     }
 
@@ -366,17 +1030,51 @@ void OrderManager::update_metrics(const std::chrono::steady_clock::time_point& s
     ).count();
     double reaction_latency_ms = reaction_latency_us / 1000.0;
 
+    FlightRecorder::instance().record(FlightEventType::LATENCY, reaction_latency_us);
+
     std::lock_guard<std::mutex> lock(metrics_mutex_);
     metrics_.update_latency(execution_latency_ms);
     metrics_.update_reaction_latency(reaction_latency_ms);
+    histograms_.reaction.record(reaction_latency_us);
     metrics_.successful_orders += 2;  // Both bid and ask
 
+    auto scheduler_stats = scheduler_->get_stats();
+
     // Display reaction latency only
     std::cout << "\n================================================" << std::endl;
     std::cout << "  LATENCY METRICS" << std::endl;
     std::cout << "================================================" << std::endl;
     std::cout << "  Reaction Latency: " << std::fixed << std::setprecision(3)
               << reaction_latency_ms << " ms (" << reaction_latency_us << " us)" << std::endl;
+    std::cout << "  Scheduler: superseded=" << scheduler_stats.superseded
+              << ", budget waits=" << scheduler_stats.budget_waits
+              << ", held back=" << scheduler_stats.held_back
+              << ", max queue delay=" << scheduler_stats.max_queue_delay_us << " us" << std::endl;
+    std::cout << "  Filters: adjusted=" << filter_adjusted_.load()
+              << ", rejected locally=" << filter_rejected_.load() << std::endl;
+    if (quote_cache_.enabled()) {
+        std::cout << "  Quote cache: hits=" << quote_cache_.hits()
+                  << ", misses=" << quote_cache_.misses()
+                  << ", rebuilds=" << quote_cache_.rebuilds() << std::endl;
+    }
+
+    auto error_stats = OrderErrorTracker::instance().get_stats();
+    if (config_.post_only) {
+        std::cout << "  Post-only: repriced=" << post_only_clamped_.load()
+                  << ", rejected on cross=" << error_stats.post_only_rejects << std::endl;
+    }
+    if (error_stats.total > 0) {
+        std::cout << "  Exchange errors: " << error_stats.total;
+        for (const auto& [code, count] : error_stats.by_code) {
+            std::cout << ", " << code << " x" << count;
+        }
+        std::cout << std::endl;
+    }
+
+    std::cout << "  Latency SLO: " << LatencySloController::level_name(slo_.level())
+              << std::defaultfloat << " (feed p" << config_.latency_slo.percentile << " " << slo_.feed_percentile_us()
+              << " us, ack p" << config_.latency_slo.percentile << " " << slo_.ack_percentile_us()
+              << " us)" << std::endl;
 
     if (reaction_latency_ms < 50) {
         std::cout << "  Status: TARGET MET (< 50ms requirement)" << std::endl;
@@ -0,0 +1,389 @@
+#include "order_scheduler.h"
+#include "rate_limiter.h"
+#include "flight_recorder.h"
+#include <iostream>
+#include <algorithm>
+
+namespace MarketMaker {
+
+OrderScheduler::OrderScheduler(std::shared_ptr<IExchange> exchange, int worker_threads)
+    : exchange_(exchange) {
+
+    int count = std::max(0, worker_threads);
+    workers_.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        workers_.emplace_back(&OrderScheduler::run_worker, this);
+    }
+
+    if (count == 0) {
+        std::cout << "[SCHEDULER] Sending inline on the submitting thread" << std::endl;
+    } else {
+        std::cout << "[SCHEDULER] Started with " << count << " worker thread(s)" << std::endl;
+    }
+}
+
+OrderScheduler::~OrderScheduler() {
+    stop();
+}
+
+void OrderScheduler::stop() {
+    std::vector<RequestPtr> dropped;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) {
+            return;
+        }
+        running_ = false;
+
+        for (auto& queue : queues_) {
+            dropped.insert(dropped.end(), queue.begin(), queue.end());
+            queue.clear();
+        }
+    }
+    cv_.notify_all();
+
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    if (deferred_.joinable()) {
+        deferred_.join();
+    }
+
+    for (const auto& request : dropped) {
+        resolve(request, Outcome::DROPPED);
+    }
+}
+
+std::future<OrderScheduler::CancelResult> OrderScheduler::submit_cancel(
+    const std::string& symbol,
+    const std::string& order_id) {
+
+    auto request = std::make_shared<Request>();
+    request->priority = Priority::CANCEL;
+    request->symbol = symbol;
+    request->order_id = order_id;
+
+    auto future = request->cancel_promise.get_future();
+    enqueue(request);
+    return future;
+}
+
+std::future<OrderScheduler::OrderResult> OrderScheduler::submit_replace(
+    const std::string& symbol,
+    const std::string& order_id,
+    OrderSide side,
+    double price,
+    double quantity) {
+
+    auto request = std::make_shared<Request>();
+    request->priority = Priority::REPLACE;
+    request->symbol = symbol;
+    request->order_id = order_id;
+    request->side = side;
+    request->price = price;
+    request->quantity = quantity;
+
+    auto future = request->order_promise.get_future();
+    enqueue(request);
+    return future;
+}
+
+std::future<OrderScheduler::OrderResult> OrderScheduler::submit_new(
+    const std::string& symbol,
+    OrderSide side,
+    double price,
+    double quantity,
+    const std::string& client_order_id,
+    bool post_only) {
+
+    auto request = std::make_shared<Request>();
+    request->priority = Priority::NEW;
+    request->symbol = symbol;
+    request->client_order_id = client_order_id;
+    request->side = side;
+    request->price = price;
+    request->quantity = quantity;
+    request->post_only = post_only;
+
+    auto future = request->order_promise.get_future();
+    enqueue(request);
+    return future;
+}
+
+void OrderScheduler::enqueue(const RequestPtr& request) {
+    request->enqueued = std::chrono::steady_clock::now();
+    std::vector<RequestPtr> superseded;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) {
+            superseded.push_back(request);
+        } else {
+            auto& queue = queues_[static_cast<int>(request->priority)];
+
+            // A fresher quote makes the queued one for the same side/order pointless
+            auto stale = std::remove_if(queue.begin(), queue.end(), [&](const RequestPtr& queued) {
+                bool same = queued->symbol == request->symbol &&
+                    ((request->priority == Priority::NEW && queued->side == request->side) ||
+                     (request->priority == Priority::REPLACE && queued->order_id == request->order_id));
+                if (same) {
+                    superseded.push_back(queued);
+                }
+                return same;
+            });
+            queue.erase(stale, queue.end());
+
+            stats_.superseded += superseded.size();
+            stats_.submitted[static_cast<int>(request->priority)]++;
+            queue.push_back(request);
+        }
+    }
+    cv_.notify_one();
+
+    for (const auto& stale : superseded) {
+        resolve(stale, stale == request ? Outcome::DROPPED : Outcome::SUPERSEDED);
+    }
+
+    if (workers_.empty()) {
+        drain_inline();
+    }
+}
+
+void OrderScheduler::pause_until(std::chrono::steady_clock::time_point until, Priority from) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (int p = static_cast<int>(from); p < 3; ++p) {
+            paused_until_[p] = std::max(paused_until_[p], until);
+        }
+    }
+    cv_.notify_all();
+}
+
+OrderScheduler::RequestPtr OrderScheduler::take_next(std::chrono::steady_clock::duration& wait, Priority lowest) {
+    auto now = std::chrono::steady_clock::now();
+    wait = std::chrono::milliseconds(100);
+
+    auto& limiter = OrderRateLimiter::instance();
+
+    for (int p = 0; p <= static_cast<int>(lowest); ++p) {
+        if (paused_until_[p] > now) {
+            // Pauses cover a class and everything below it
+            wait = paused_until_[p] - now;
+            return nullptr;
+        }
+
+        auto& queue = queues_[p];
+        if (queue.empty()) {
+            continue;
+        }
+
+        // Budget is taken here, under the lock, so workers can't overrun it
+        bool is_cancel = p == static_cast<int>(Priority::CANCEL);
+        std::chrono::milliseconds budget_wait{0};
+        if (!is_cancel) {
+            // The account this order would go to (sharded entry) has its own limit
+            budget_wait = exchange_->time_until_order_slot(queue.front()->side);
+            if (budget_wait.count() > 0) {
+                stats_.budget_waits++;
+                wait = budget_wait;
+                return nullptr;
+            }
+        }
+        bool acquired = is_cancel ? limiter.try_acquire_cancel_slot(budget_wait)
+                                  : limiter.try_acquire_order_slot(budget_wait);
+        if (!acquired) {
+            // Strict priority: lower classes wait behind a throttled head
+            stats_.budget_waits++;
+            wait = budget_wait;
+            return nullptr;
+        }
+
+        RequestPtr request = queue.front();
+        queue.pop_front();
+
+        auto delay_us = std::chrono::duration_cast<std::chrono::microseconds>(now - request->enqueued).count();
+        stats_.max_queue_delay_us = std::max(stats_.max_queue_delay_us, static_cast<int64_t>(delay_us));
+        stats_.dispatched[p]++;
+        return request;
+    }
+
+    return nullptr;
+}
+
+void OrderScheduler::run_worker() {
+    while (true) {
+        RequestPtr request;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (running_) {
+                std::chrono::steady_clock::duration wait;
+                request = take_next(wait);
+                if (request) {
+                    break;
+                }
+                cv_.wait_for(lock, wait);
+            }
+
+            if (!running_) {
+                return;
+            }
+        }
+
+        dispatch(request);
+    }
+}
+
+void OrderScheduler::run_deferred() {
+    // Inline mode: replaces and new orders are sent by the submitter only
+    while (true) {
+        RequestPtr request;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (running_) {
+                std::chrono::steady_clock::duration wait;
+                request = take_next(wait, Priority::CANCEL);
+                if (request) {
+                    break;
+                }
+                cv_.wait_for(lock, wait);
+            }
+
+            if (!running_) {
+                return;
+            }
+        }
+
+        dispatch(request);
+    }
+}
+
+void OrderScheduler::drain_inline() {
+    while (true) {
+        RequestPtr request;
+        std::vector<RequestPtr> held_back;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!running_) {
+                return;
+            }
+
+            std::chrono::steady_clock::duration wait;
+            request = take_next(wait);
+            if (!request) {
+                // Throttled or paused. The submitter is a feed thread and must
+                // not wait (a PAUSE_ALL can last minutes): orders are dropped,
+                // cancels go to the deferred worker.
+                for (auto priority : {Priority::REPLACE, Priority::NEW}) {
+                    auto& queue = queues_[static_cast<int>(priority)];
+                    held_back.insert(held_back.end(), queue.begin(), queue.end());
+                    queue.clear();
+                }
+                stats_.held_back += held_back.size();
+
+                if (!queues_[static_cast<int>(Priority::CANCEL)].empty() && !deferred_.joinable()) {
+                    deferred_ = std::thread(&OrderScheduler::run_deferred, this);
+                }
+            }
+        }
+
+        if (!request) {
+            cv_.notify_all();
+            for (const auto& dropped : held_back) {
+                resolve(dropped, Outcome::DROPPED);
+            }
+            return;
+        }
+
+        dispatch(request);
+    }
+}
+
+void OrderScheduler::dispatch(const RequestPtr& request) {
+    try {
+        send(request);
+    } catch (const std::exception& e) {
+        // Promise is still unset: every path in send() sets it last
+        std::cerr << "[SCHEDULER] Request failed: " << e.what() << std::endl;
+        resolve(request, Outcome::FAILED);
+    }
+}
+
+void OrderScheduler::send(const RequestPtr& request) {
+    auto& recorder = FlightRecorder::instance();
+    auto sent = std::chrono::steady_clock::now();
+    auto round_trip_us = [&sent]() {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - sent).count();
+    };
+    FlightSide side = FlightRecorder::side_of(request->side);
+
+    switch (request->priority) {
+        case Priority::CANCEL: {
+            recorder.record(FlightEventType::CANCEL_SENT, 0, request->order_id);
+            auto result = exchange_->cancel_order(request->symbol, request->order_id);
+            CancelResult cancel;
+            cancel.outcome = (result && *result) ? Outcome::SENT : Outcome::FAILED;
+            recorder.record(cancel.outcome == Outcome::SENT ? FlightEventType::CANCEL_ACK
+                                                            : FlightEventType::CANCEL_FAILED,
+                            round_trip_us(), request->order_id);
+            request->cancel_promise.set_value(cancel);
+            break;
+        }
+
+        case Priority::REPLACE: {
+            recorder.record(FlightEventType::ORDER_SENT, side, request->price, request->quantity, 0, request->order_id);
+            OrderResult order;
+            order.order = exchange_->modify_order(request->symbol, request->order_id,
+                                                  request->price, request->quantity);
+            order.outcome = order.order ? Outcome::SENT : Outcome::FAILED;
+            order.ack_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - request->enqueued).count();
+            recorder.record(order.order ? FlightEventType::ORDER_ACK : FlightEventType::ORDER_FAILED, side,
+                            request->price, request->quantity, round_trip_us(),
+                            order.order ? order.order->order_id : request->order_id);
+            request->order_promise.set_value(order);
+            break;
+        }
+
+        case Priority::NEW: {
+            recorder.record(FlightEventType::ORDER_SENT, side, request->price, request->quantity, 0,
+                            request->client_order_id);
+            OrderResult order;
+            order.order = exchange_->place_limit_order(request->symbol, request->side,
+                                                       request->price, request->quantity,
+                                                       request->client_order_id, request->post_only);
+            order.outcome = order.order ? Outcome::SENT : Outcome::FAILED;
+            order.ack_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - request->enqueued).count();
+            recorder.record(order.order ? FlightEventType::ORDER_ACK : FlightEventType::ORDER_FAILED, side,
+                            request->price, request->quantity, round_trip_us(),
+                            order.order ? order.order->order_id : request->client_order_id);
+            request->order_promise.set_value(order);
+            break;
+        }
+    }
+}
+
+void OrderScheduler::resolve(const RequestPtr& request, Outcome outcome) {
+    if (request->priority == Priority::CANCEL) {
+        CancelResult cancel;
+        cancel.outcome = outcome;
+        request->cancel_promise.set_value(cancel);
+    } else {
+        OrderResult order;
+        order.outcome = outcome;
+        request->order_promise.set_value(order);
+    }
+}
+
+OrderScheduler::Stats OrderScheduler::get_stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Stats stats = stats_;
+    for (int p = 0; p < 3; ++p) {
+        stats.queued[p] = queues_[p].size();
+    }
+    return stats;
+}
+
+} // namespace MarketMaker
@@ -0,0 +1,150 @@
+#include "parameter_store.h"
+#include "config_loader.h"
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#include <filesystem>
+#include <iostream>
+
+namespace MarketMaker {
+
+StrategyParams StrategyParams::from_config(const Config& config) {
+    StrategyParams params;
+    params.spread_percentage = config.spread_percentage;
+    params.order_size = config.order_size;
+    params.order_update_cooldown = config.order_update_cooldown;
+    params.fill_requote_cooldown = config.fill_requote_cooldown;
+    params.inventory_skew = config.inventory_skew;
+    params.queue_keep_max_ahead = config.queue_keep_max_ahead;
+    params.queue_keep_max_drift = config.queue_keep_max_drift;
+    return params;
+}
+
+std::string StrategyParams::validate() const {
+    if (!(spread_percentage > 0 && spread_percentage < 0.5)) {
+        return "spread_percentage must be in (0, 0.5)";
+    }
+    if (!(order_size > 0)) {
+        return "order_size must be positive";
+    }
+    if (order_update_cooldown.count() < 0 || fill_requote_cooldown.count() < 0) {
+        return "cooldowns must not be negative";
+    }
+    if (!(inventory_skew >= 0) || !(queue_keep_max_ahead >= 0) || !(queue_keep_max_drift >= 0)) {
+        return "inventory_skew and queue_keep_* must not be negative";
+    }
+    return "";
+}
+
+ParameterStore::ParameterStore(const StrategyParams& initial) {
+    auto snapshot = std::make_unique<StrategyParams>(initial);
+    snapshot->version = 1;
+    current_.store(snapshot.get(), std::memory_order_release);
+    snapshots_.push_back(std::move(snapshot));
+}
+
+ParameterStore::~ParameterStore() {
+    stop();
+}
+
+bool ParameterStore::publish(StrategyParams params, std::string& error) {
+    error = params.validate();
+    if (!error.empty()) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(publish_mutex_);
+    params.version = current_.load(std::memory_order_relaxed)->version + 1;
+    auto snapshot = std::make_unique<const StrategyParams>(params);
+    current_.store(snapshot.get(), std::memory_order_release);
+    snapshots_.push_back(std::move(snapshot));
+    return true;
+}
+
+bool ParameterStore::watch_file(const std::string& path) {
+    if (watching_) {
+        return true;
+    }
+
+    std::filesystem::path file(path);
+    std::string directory = file.has_parent_path() ? file.parent_path().string() : ".";
+
+    inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd_ < 0) {
+        std::cerr << "[PARAMS] inotify_init1 failed, hot reload disabled" << std::endl;
+        return false;
+    }
+    if (inotify_add_watch(inotify_fd_, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        std::cerr << "[PARAMS] Cannot watch " << directory << ", hot reload disabled" << std::endl;
+        close(inotify_fd_);
+        inotify_fd_ = -1;
+        return false;
+    }
+
+    path_ = path;
+    watching_ = true;
+    watch_thread_ = std::thread(&ParameterStore::run_watcher, this, file.filename().string());
+
+    std::cout << "[PARAMS] Watching " << path << " for parameter changes" << std::endl;
+    return true;
+}
+
+void ParameterStore::stop() {
+    if (!watching_.exchange(false)) {
+        return;
+    }
+    if (watch_thread_.joinable()) {
+        watch_thread_.join();
+    }
+    close(inotify_fd_);
+    inotify_fd_ = -1;
+}
+
+void ParameterStore::run_watcher(std::string filename) {
+    alignas(inotify_event) char buffer[4096];
+
+    while (watching_) {
+        pollfd pfd{inotify_fd_, POLLIN, 0};
+        if (poll(&pfd, 1, 200) <= 0) {
+            continue;  // Timeout: re-check watching_
+        }
+
+        bool changed = false;
+        ssize_t length;
+        while ((length = read(inotify_fd_, buffer, sizeof(buffer))) > 0) {
+            for (char* ptr = buffer; ptr < buffer + length;) {
+                auto* event = reinterpret_cast<inotify_event*>(ptr);
+                if (event->len > 0 && filename == event->name) {
+                    changed = true;
+                }
+                ptr += sizeof(inotify_event) + event->len;
+            }
+        }
+
+        if (changed) {
+            reload();
+        }
+    }
+}
+
+void ParameterStore::reload() {
+    auto config = ConfigLoader::load_from_file(path_);
+    if (!config) {
+        std::cerr << "[PARAMS] Reload failed, keeping current parameters" << std::endl;
+        return;
+    }
+
+    std::string error;
+    if (!publish(StrategyParams::from_config(*config), error)) {
+        std::cerr << "[PARAMS] Rejected new parameters: " << error << std::endl;
+        return;
+    }
+
+    const auto& params = get();
+    std::cout << "[PARAMS] Reloaded v" << params.version
+              << ": spread=" << params.spread_percentage
+              << ", order_size=" << params.order_size
+              << ", order_update_cooldown=" << params.order_update_cooldown.count() << " ms" << std::endl;
+}
+
+} // namespace MarketMaker
@@ -0,0 +1,154 @@
+#include "queue_position.h"
+#include <algorithm>
+#include <cmath>
+
+namespace MarketMaker {
+
+namespace {
+
+// Prices come off the exchange grid; anything closer than this is one level
+bool same_price(double a, double b) {
+    return std::abs(a - b) <= 1e-9 * std::max(1.0, std::abs(a));
+}
+
+// True if a is a better price than b on the given side
+bool better(double a, double b, bool is_bid) {
+    return is_bid ? a > b : a < b;
+}
+
+} // namespace
+
+void QueuePositionEstimator::on_order_acked(OrderSide side, const std::string& order_id, double price,
+                                            double quantity, std::optional<double> level_qty, bool at_touch) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& tracked = orders_[static_cast<int>(side)];
+
+    tracked = Tracked{};
+    tracked.active = true;
+    tracked.estimate.order_id = order_id;
+    tracked.estimate.price = price;
+    tracked.estimate.remaining = quantity;
+
+    // Everything already resting at our price is ahead of us
+    tracked.seeded = level_qty.has_value();
+    tracked.estimate.ahead = level_qty.value_or(0.0);
+    tracked.estimate.level_qty = level_qty.value_or(0.0);
+    tracked.estimate.at_touch = at_touch;
+}
+
+void QueuePositionEstimator::on_order_removed(OrderSide side, const std::string& order_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& tracked = orders_[static_cast<int>(side)];
+    if (order_id.empty() || tracked.estimate.order_id == order_id) {
+        tracked.active = false;
+    }
+}
+
+void QueuePositionEstimator::on_fill(OrderSide side, const std::string& order_id, double remaining) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& tracked = orders_[static_cast<int>(side)];
+    if (!tracked.active || tracked.estimate.order_id != order_id) {
+        return;
+    }
+
+    // We only trade once everything ahead of us has
+    tracked.estimate.ahead = 0.0;
+    tracked.estimate.remaining = remaining;
+}
+
+void QueuePositionEstimator::on_book(const OrderBook& book) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (orders_[0].active) {
+        update(orders_[0], book.bids, true);
+    }
+    if (orders_[1].active) {
+        update(orders_[1], book.asks, false);
+    }
+}
+
+std::optional<QueueEstimate> QueuePositionEstimator::get(OrderSide side) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto& tracked = orders_[static_cast<int>(side)];
+    if (!tracked.active || !tracked.seeded) {
+        return std::nullopt;
+    }
+    return tracked.estimate;
+}
+
+void QueuePositionEstimator::update(Tracked& tracked, const std::vector<PriceLevel>& levels, bool is_bid) {
+    if (levels.empty()) {
+        return;
+    }
+
+    auto& estimate = tracked.estimate;
+    auto index = find_level(levels, estimate.price, is_bid, tracked.level_hint);
+
+    if (!tracked.seeded) {
+        // Acked deeper than the caller's book: seed from the first update
+        // that reaches our price, with all of the level still ahead
+        if (index) {
+            tracked.level_hint = *index;
+            estimate.ahead = estimate.level_qty = levels[*index].quantity;
+            estimate.at_touch = *index == 0;
+            tracked.seeded = true;
+        } else if (!better(levels.back().price, estimate.price, is_bid)) {
+            estimate.ahead = estimate.level_qty = 0.0;
+            estimate.at_touch = !better(levels[0].price, estimate.price, is_bid);
+            tracked.seeded = true;
+        }
+        return;
+    }
+
+    if (!index) {
+        // Not in the book. Within the visible range that means the level
+        // emptied or was traded through; deeper than that we know nothing new.
+        if (!better(levels.back().price, estimate.price, is_bid)) {
+            estimate.ahead = 0.0;
+            estimate.level_qty = 0.0;
+            estimate.at_touch = !better(levels[0].price, estimate.price, is_bid);
+        }
+        return;
+    }
+
+    tracked.level_hint = *index;
+    double level_qty = levels[*index].quantity;
+    double decrease = estimate.level_qty - level_qty;
+    estimate.at_touch = *index == 0;
+
+    if (decrease > 0 && estimate.ahead > 0) {
+        if (estimate.at_touch) {
+            // Trades at the touch take the front of the queue
+            estimate.ahead -= decrease;
+        } else {
+            // Cancels can come from anywhere in the queue
+            double behind = std::max(estimate.level_qty - estimate.ahead, 0.0);
+            estimate.ahead -= decrease * estimate.ahead / (estimate.ahead + behind);
+        }
+    }
+
+    estimate.ahead = std::clamp(estimate.ahead, 0.0, level_qty);
+    estimate.level_qty = level_qty;
+}
+
+std::optional<size_t> QueuePositionEstimator::find_level(const std::vector<PriceLevel>& levels, double price,
+                                                         bool is_bid, size_t hint) {
+    // Levels shift by at most a few places between updates: look around the
+    // previous index before searching
+    size_t size = levels.size();
+    for (size_t i : {hint, hint + 1, hint - 1}) {
+        if (i < size && same_price(levels[i].price, price)) {
+            return i;
+        }
+    }
+
+    // Sorted best first: the first level not better than our price
+    auto it = std::partition_point(levels.begin(), levels.end(), [&](const PriceLevel& level) {
+        return better(level.price, price, is_bid) && !same_price(level.price, price);
+    });
+    if (it != levels.end() && same_price(it->price, price)) {
+        return static_cast<size_t>(it - levels.begin());
+    }
+    return std::nullopt;
+}
+
+} // namespace MarketMaker
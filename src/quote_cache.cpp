@@ -0,0 +1,56 @@
+#include "quote_cache.h"
+#include <cmath>
+
+namespace MarketMaker {
+
+QuoteCache::QuoteCache(int ticks_each_side, double tick_size)
+    : ticks_each_side_(ticks_each_side > 0 ? ticks_each_side : 0),
+      tick_size_(tick_size) {
+    table_.resize(4 * static_cast<size_t>(ticks_each_side_) + 1);
+}
+
+void QuoteCache::prepare(double mid_price, uint64_t generation, const Builder& builder) {
+    int64_t center = 0;
+    if (!enabled() || !to_key(mid_price, center)) {
+        return;
+    }
+    if (built_ && center == center_key_ && generation == generation_) {
+        return;
+    }
+
+    const double half_tick = tick_size_ / 2.0;
+    first_key_ = center - 2 * ticks_each_side_;
+    for (size_t i = 0; i < table_.size(); ++i) {
+        table_[i] = builder(static_cast<double>(first_key_ + static_cast<int64_t>(i)) * half_tick);
+    }
+
+    center_key_ = center;
+    generation_ = generation;
+    built_ = true;
+    rebuilds_++;
+}
+
+const QuoteSet* QuoteCache::lookup(double mid_price, uint64_t generation) {
+    int64_t key = 0;
+    if (!built_ || generation != generation_ || !to_key(mid_price, key)) {
+        misses_++;
+        return nullptr;
+    }
+
+    int64_t index = key - first_key_;
+    if (index < 0 || index >= static_cast<int64_t>(table_.size())) {
+        misses_++;
+        return nullptr;
+    }
+
+    hits_++;
+    return &table_[static_cast<size_t>(index)];
+}
+
+bool QuoteCache::to_key(double mid_price, int64_t& key) const {
+    double half_ticks = mid_price * 2.0 / tick_size_;
+    key = std::llround(half_ticks);
+    return std::abs(half_ticks - static_cast<double>(key)) < 1e-6;
+}
+
+} // namespace MarketMaker
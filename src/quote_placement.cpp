@@ -0,0 +1,145 @@
+#include "quote_placement.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace MarketMaker {
+
+namespace {
+
+constexpr int64_t EMPTY_LEVEL = std::numeric_limits<int64_t>::min();
+
+} // namespace
+
+QuotePlacer::QuotePlacer(double tick_size, const PlacementParams& params)
+    : tick_size_(tick_size), params_(params) {
+    params_.depth = std::clamp(params_.depth, 1, MAX_DEPTH);
+    for (auto& side : sides_) {
+        std::fill(std::begin(side.ticks), std::end(side.ticks), EMPTY_LEVEL);
+        std::fill(std::begin(side.sizes), std::end(side.sizes), 0.0);
+    }
+}
+
+void QuotePlacer::set_book(const OrderBook& book) {
+    load_side(sides_[static_cast<int>(OrderSide::BUY)], book.bids, false);
+    load_side(sides_[static_cast<int>(OrderSide::SELL)], book.asks, true);
+}
+
+void QuotePlacer::load_side(Side& side, const std::vector<PriceLevel>& levels, bool negate) {
+    int count = std::min(static_cast<int>(levels.size()), params_.depth);
+    for (int i = 0; i < count; ++i) {
+        int64_t ticks = to_ticks(levels[i].price);
+        side.ticks[i] = negate ? -ticks : ticks;
+        side.sizes[i] = levels[i].quantity;
+    }
+    // Clear what the previous book left beyond this one's depth
+    for (int i = count; i < side.levels; ++i) {
+        side.ticks[i] = EMPTY_LEVEL;
+        side.sizes[i] = 0.0;
+    }
+    side.levels = count;
+}
+
+int64_t QuotePlacer::place(OrderSide side, int64_t target_ticks, double quote_size) const {
+    const bool is_bid = side == OrderSide::BUY;
+    const Side& own = sides_[is_bid ? 0 : 1];
+    const Side& other = sides_[is_bid ? 1 : 0];
+
+    if (params_.mode == PlacementMode::SPREAD || own.levels == 0) {
+        return target_ticks;
+    }
+
+    // Everything below is "higher is better" for either side
+    int64_t target = is_bid ? target_ticks : -target_ticks;
+
+    // Never better than the target, nor at or through the opposite touch
+    int64_t bound = target;
+    if (other.levels > 0) {
+        bound = std::min(bound, -other.ticks[0] - 1);
+    }
+
+    // Levels are sorted best first, so the number of levels better than the
+    // bound is the index of the first one we may join
+    int first = 0;
+    for (int i = 0; i < MAX_DEPTH; ++i) {
+        first += own.ticks[i] > bound;
+    }
+    int64_t joined = first < own.levels ? own.ticks[first] : bound;
+    int64_t chosen = joined;
+
+    switch (params_.mode) {
+        case PlacementMode::IMPROVE: {
+            int64_t spread = other.levels > 0 ? -other.ticks[0] - own.ticks[0] : 0;
+            if (spread >= params_.improve_min_spread_ticks) {
+                chosen = std::min(joined + 1, bound);
+            }
+            break;
+        }
+
+        case PlacementMode::BACK_OFF: {
+            // Relative to the current quote size, which can be reloaded
+            double wall_size = params_.wall_size * quote_size;
+            if (wall_size <= 0) {
+                break;
+            }
+            int wall = MAX_DEPTH;
+            for (int i = 0; i < MAX_DEPTH; ++i) {
+                int candidate = (i >= first && own.sizes[i] >= wall_size) ? i : MAX_DEPTH;
+                wall = std::min(wall, candidate);
+            }
+            if (wall < own.levels) {
+                chosen = own.ticks[wall] - 1;
+            }
+            break;
+        }
+
+        case PlacementMode::SPREAD:
+        case PlacementMode::JOIN:
+            break;
+    }
+
+    return is_bid ? chosen : -chosen;
+}
+
+std::optional<double> QuotePlacer::quantity_at(OrderSide side, int64_t ticks) const {
+    const Side& own = sides_[side == OrderSide::BUY ? 0 : 1];
+    int64_t key = side == OrderSide::BUY ? ticks : -ticks;
+    // Only `depth` levels are kept: past a full side the book may hold more
+    if (own.levels == params_.depth && key < own.ticks[own.levels - 1]) {
+        return std::nullopt;
+    }
+    double quantity = 0.0;
+    for (int i = 0; i < MAX_DEPTH; ++i) {
+        quantity += own.ticks[i] == key ? own.sizes[i] : 0.0;
+    }
+    return quantity;
+}
+
+bool QuotePlacer::at_touch(OrderSide side, int64_t ticks) const {
+    const Side& own = sides_[side == OrderSide::BUY ? 0 : 1];
+    int64_t key = side == OrderSide::BUY ? ticks : -ticks;
+    return own.levels == 0 || own.ticks[0] <= key;
+}
+
+int64_t QuotePlacer::to_ticks(double price) const {
+    return static_cast<int64_t>(std::llround(price / tick_size_));
+}
+
+PlacementMode QuotePlacer::parse_mode(const std::string& name) {
+    if (name == "join") return PlacementMode::JOIN;
+    if (name == "improve") return PlacementMode::IMPROVE;
+    if (name == "back_off") return PlacementMode::BACK_OFF;
+    return PlacementMode::SPREAD;
+}
+
+const char* QuotePlacer::mode_name(PlacementMode mode) {
+    switch (mode) {
+        case PlacementMode::JOIN: return "join";
+        case PlacementMode::IMPROVE: return "improve";
+        case PlacementMode::BACK_OFF: return "back_off";
+        case PlacementMode::SPREAD: break;
+    }
+    return "spread";
+}
+
+} // namespace MarketMaker
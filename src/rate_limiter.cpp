@@ -9,25 +9,58 @@ RateLimiter::RateLimiter(int max_requests_per_second, int burst_size)
     : max_requests_per_second_(max_requests_per_second),
       burst_size_(burst_size) {}
 
+void RateLimiter::configure(int max_requests_per_second, int burst_size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    max_requests_per_second_ = max_requests_per_second;
+    burst_size_ = burst_size;
+}
+
 bool RateLimiter::can_request() {
+    return time_until_available().count() == 0;
+}
+
+std::chrono::milliseconds RateLimiter::time_until_available() {
     std::lock_guard<std::mutex> lock(mutex_);
     cleanup_old_requests();
+    return wait_locked();
+}
 
-    // Check burst limit
-    if (request_times_.size() >= static_cast<size_t>(burst_size_)) {
+bool RateLimiter::try_acquire(std::chrono::milliseconds& wait) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cleanup_old_requests();
+    wait = wait_locked();
+    if (wait.count() > 0) {
         return false;
     }
+    request_times_.push_back(std::chrono::steady_clock::now());
+    request_count_++;
+    return true;
+}
 
-    // Check rate limit
+std::chrono::milliseconds RateLimiter::wait_locked() const {
     auto now = std::chrono::steady_clock::now();
-    auto one_second_ago = now - std::chrono::seconds(1);
-
-    int recent_requests = std::count_if(request_times_.begin(), request_times_.end(),
-        [one_second_ago](const auto& time) {
-            return time > one_second_ago;
-        });
-
-    return recent_requests < max_requests_per_second_;
+    std::chrono::steady_clock::duration wait{0};
+
+    // request_times_ is sorted, so when a window is full the entry that has to
+    // expire first is the limit-th newest one
+    auto window_wait = [&](std::chrono::steady_clock::duration window, int limit) {
+        if (limit <= 0) {
+            return;
+        }
+        auto start = now - window;
+        auto first_in_window = std::upper_bound(request_times_.begin(), request_times_.end(), start);
+        auto in_window = std::distance(first_in_window, request_times_.end());
+        if (in_window >= limit) {
+            auto expiring = request_times_.end() - limit;
+            wait = std::max(wait, *expiring + window - now);
+        }
+    };
+
+    window_wait(burst_window_, burst_size_);
+    window_wait(rate_window_, max_requests_per_second_ * static_cast<int>(rate_window_.count()));
+
+    // Round up so a caller sleeping this long finds the slot free
+    return std::chrono::ceil<std::chrono::milliseconds>(wait);
 }
 
 void RateLimiter::wait_if_needed() {
@@ -57,6 +90,7 @@ RateLimiter::Stats RateLimiter::get_stats() const {
     Stats stats;
     auto now = std::chrono::steady_clock::now();
     auto one_second_ago = now - std::chrono::seconds(1);
+    auto rate_window_start = now - rate_window_;
     auto one_minute_ago = now - std::chrono::seconds(60);
 
     stats.requests_in_last_second = std::count_if(request_times_.begin(), request_times_.end(),
@@ -64,13 +98,18 @@ RateLimiter::Stats RateLimiter::get_stats() const {
             return time > one_second_ago;
         });
 
+    stats.requests_in_rate_window = std::count_if(request_times_.begin(), request_times_.end(),
+        [rate_window_start](const auto& time) {
+            return time > rate_window_start;
+        });
+
     stats.requests_in_last_minute = std::count_if(request_times_.begin(), request_times_.end(),
         [one_minute_ago](const auto& time) {
             return time > one_minute_ago;
         });
 
     stats.current_rate = static_cast<double>(stats.requests_in_last_second);
-    stats.is_limited = stats.requests_in_last_second >= max_requests_per_second_;
+    stats.is_limited = stats.requests_in_last_second >= burst_size_;
 
     return stats;
 }
@@ -81,18 +120,72 @@ void RateLimiter::reset() {
     request_count_ = 0;
 }
 
+void OrderRateLimiter::configure(int orders_per_second, int cancels_per_second) {
+    if (orders_per_second > 0) {
+        orders_per_second_ = orders_per_second;
+        order_limiter_.configure(orders_per_second, orders_per_second * 2);
+    }
+    if (cancels_per_second > 0) {
+        cancels_per_second_ = cancels_per_second;
+        cancel_limiter_.configure(cancels_per_second, cancels_per_second * 2);
+    }
+}
+
+bool OrderRateLimiter::try_acquire_order_slot(std::chrono::milliseconds& wait) {
+    if (!shared_) {
+        return order_limiter_.try_acquire(wait);
+    }
+    int rate = orders_per_second_.load();
+    if (!shared_->try_acquire(SharedRateLimiter::Kind::ORDERS, rate, rate * 2, wait)) {
+        return false;
+    }
+    order_limiter_.record_request();  // Local stats
+    return true;
+}
+
+bool OrderRateLimiter::try_acquire_cancel_slot(std::chrono::milliseconds& wait) {
+    if (!shared_) {
+        return cancel_limiter_.try_acquire(wait);
+    }
+    int rate = cancels_per_second_.load();
+    if (!shared_->try_acquire(SharedRateLimiter::Kind::CANCELS, rate, rate * 2, wait)) {
+        return false;
+    }
+    cancel_limiter_.record_request();
+    return true;
+}
+
+bool OrderRateLimiter::share_with_processes(const std::string& api_key, const std::string& label) {
+    if (!shared_) {
+        shared_ = SharedRateLimiter::open(api_key, label);
+    }
+    return shared_ != nullptr;
+}
+
 void OrderRateLimiter::log_status() const {
     auto order_stats = order_limiter_.get_stats();
     auto cancel_stats = cancel_limiter_.get_stats();
 
     std::cout << "[RATE LIMIT] Orders: " << order_stats.requests_in_last_second
-              << "/s (limit: 10/s), Cancels: " << cancel_stats.requests_in_last_second
-              << "/s (limit: 20/s)";
+              << "/s (limit: " << orders_per_second_ << "/s), Cancels: "
+              << cancel_stats.requests_in_last_second
+              << "/s (limit: " << cancels_per_second_ << "/s)";
 
     if (order_stats.is_limited || cancel_stats.is_limited) {
         std::cout << " [THROTTLED]";
     }
     std::cout << std::endl;
+
+    if (shared_) {
+        std::cout << "[RATE LIMIT] Account (" << shared_->name() << "): "
+                  << shared_->count(SharedRateLimiter::Kind::ORDERS, std::chrono::seconds(1)) << " orders, "
+                  << shared_->count(SharedRateLimiter::Kind::CANCELS, std::chrono::seconds(1))
+                  << " cancels in the last second" << std::endl;
+        for (const auto& process : shared_->usage()) {
+            std::cout << "[RATE LIMIT]   pid " << process.pid << " (" << process.label << "): "
+                      << process.orders << " orders, " << process.cancels << " cancels" << std::endl;
+        }
+    }
 }
 
 } // namespace MarketMaker
\ No newline at end of file
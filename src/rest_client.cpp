@@ -1,4 +1,6 @@
 #include "rest_client.h"
+#include "exchange_clock.h"
+#include "order_errors.h"
 #include <curl/curl.h>
 #include <openssl/hmac.h>
 #include <openssl/sha.h>
@@ -18,8 +20,78 @@ static size_t write_callback(void* contents, size_t size, size_t nmemb, void* us
     return size * nmemb;
 }
 
+// Hand a {"code":..,"msg":..} error body to OrderErrorTracker
+static void report_order_error(const Json::Value& root, const std::string& symbol,
+                               const OrderSide* side = nullptr) {
+    OrderError error;
+    error.symbol = symbol;
+    error.has_side = side != nullptr;
+    if (side) {
+        error.side = *side;
+    }
+    error.code = root["code"].asInt();
+    error.message = root["msg"].asString();
+    error.retry_after_ms = OrderErrorTracker::parse_banned_until(error.message);
+    error.transport = "REST";
+    OrderErrorTracker::instance().record(error);
+}
+
+// Order fields come as strings ("0.01000000") but tolerate numbers
+static double to_double(const Json::Value& value) {
+    if (value.isString()) {
+        try {
+            return std::stod(value.asString());
+        } catch (const std::exception&) {
+            return 0.0;
+        }
+    }
+    return value.isNumeric() ? value.asDouble() : 0.0;
+}
+
+static OrderStatus parse_order_status(const std::string& status) {
+    if (status == "PARTIALLY_FILLED") return OrderStatus::PARTIALLY_FILLED;
+    if (status == "FILLED") return OrderStatus::FILLED;
+    if (status == "CANCELED") return OrderStatus::CANCELED;
+    if (status == "REJECTED") return OrderStatus::REJECTED;
+    if (status == "EXPIRED" || status == "EXPIRED_IN_MATCH") return OrderStatus::EXPIRED;
+    return OrderStatus::NEW;
+}
+
+static const char* response_type_name(OrderResponseType type) {
+    switch (type) {
+        case OrderResponseType::RESULT: return "RESULT";
+        case OrderResponseType::FULL: return "FULL";
+        case OrderResponseType::ACK: break;
+    }
+    return "ACK";
+}
+
 class RestClient::Impl {
 public:
+    // Socket tuning for new connections (curl reuses sockets, so this is rare)
+    SocketProfile socket_profile;
+    AppliedSocketOptions socket_report;
+    mutable std::mutex socket_mutex;
+
+    static int sockopt_callback(void* clientp, curl_socket_t fd, curlsocktype purpose) {
+        if (purpose != CURLSOCKTYPE_IPCXN) {
+            return CURL_SOCKOPT_OK;
+        }
+
+        auto* impl = static_cast<Impl*>(clientp);
+        std::lock_guard<std::mutex> lock(impl->socket_mutex);
+        impl->socket_report = SocketTuning::apply(fd, impl->socket_profile);
+        std::cout << "[REST] New connection socket: " << impl->socket_report.to_string() << std::endl;
+        return CURL_SOCKOPT_OK;
+    }
+
+    // Options that must survive curl_easy_reset()
+    void configure_handle(CURL* curl) {
+        curl_easy_setopt(curl, CURLOPT_SOCKOPTFUNCTION, &Impl::sockopt_callback);
+        curl_easy_setopt(curl, CURLOPT_SOCKOPTDATA, this);
+        curl_easy_setopt(curl, CURLOPT_DNS_CACHE_TIMEOUT, 3600L);
+    }
+
     std::vector<CURL*> curl_pool;
     std::mutex pool_mutex;
     std::string base_url;
@@ -48,8 +120,8 @@ public:
                 curl_easy_setopt(curl, CURLOPT_FORBID_REUSE, 0L);  // Allow connection reuse
                 curl_easy_setopt(curl, CURLOPT_FRESH_CONNECT, 0L);  // Don't force fresh connection
 
-                // DNS caching for faster resolution
-                curl_easy_setopt(curl, CURLOPT_DNS_CACHE_TIMEOUT, 3600L);  // Cache DNS for 1 hour
+                // DNS caching (1 hour) and socket tuning
+                configure_handle(curl);
 
                 // Reduce timeout for faster failure detection
                 curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, 1000L);  // 1 second connect timeout
@@ -105,9 +177,7 @@ public:
     }
 
     long get_timestamp() {
-        auto now = std::chrono::system_clock::now();
-        auto duration = now.time_since_epoch();
-        return std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+        return ExchangeClock::instance().now_ms();
     }
 };
 
@@ -120,6 +190,16 @@ void RestClient::set_display_assets(const std::vector<std::string>& assets) {
     pImpl->display_assets = assets;
 }
 
+void RestClient::set_socket_profile(const SocketProfile& profile) {
+    std::lock_guard<std::mutex> lock(pImpl->socket_mutex);
+    pImpl->socket_profile = profile;
+}
+
+AppliedSocketOptions RestClient::get_socket_report() const {
+    std::lock_guard<std::mutex> lock(pImpl->socket_mutex);
+    return pImpl->socket_report;
+}
+
 std::string RestClient::get_account_info() {
     auto response = send_signed_request("GET", "/api/v3/account", {});
 
@@ -236,6 +316,14 @@ std::optional<std::string> RestClient::send_signed_request(
     std::cout << "Query string: " << query_string.substr(0, 100) << "..." << std::endl;
     std::cout << "Signature: " << signature << std::endl;
 
+    return send_keyed_request(method, endpoint, query_string);
+}
+
+std::optional<std::string> RestClient::send_keyed_request(
+    const std::string& method,
+    const std::string& endpoint,
+    const std::string& query_string) {
+
     std::string url = pImpl->base_url + endpoint;
     std::string response;
 
@@ -244,6 +332,7 @@ std::optional<std::string> RestClient::send_signed_request(
 
     // Reset all options to avoid conflicts between different request types
     curl_easy_reset(curl);
+    pImpl->configure_handle(curl);
 
     // Set up options
     curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_callback);
@@ -262,19 +351,20 @@ std::optional<std::string> RestClient::send_signed_request(
     // Set headers
     curl_easy_setopt(curl, CURLOPT_HTTPHEADER, request_headers);
 
+    if (!query_string.empty()) {
+        url += "?" + query_string;
+    }
+
     if (method == "POST") {
         // For Binance API, POST parameters go in URL for signed requests
-        url += "?" + query_string;
         curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
         curl_easy_setopt(curl, CURLOPT_POST, 1L);
         curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, 0L);
         curl_easy_setopt(curl, CURLOPT_POSTFIELDS, NULL);
-    } else if (method == "DELETE") {
-        url += "?" + query_string;
+    } else if (method == "DELETE" || method == "PUT") {
         curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-        curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, "DELETE");
+        curl_easy_setopt(curl, CURLOPT_CUSTOMREQUEST, method.c_str());
     } else {  // GET
-        url += "?" + query_string;
         curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
         curl_easy_setopt(curl, CURLOPT_HTTPGET, 1L);
     }
@@ -297,7 +387,9 @@ std::optional<Order> RestClient::place_limit_order(
     OrderSide side,
     double price,
     double quantity,
-    const std::string& client_order_id) {
+    const std::string& client_order_id,
+    bool post_only,
+    OrderResponseType response_type) {
 
     // OPTIMIZATION: Use faster number formatting with pre-allocated buffer
     char price_buffer[32];
@@ -311,16 +403,23 @@ std::optional<Order> RestClient::place_limit_order(
 
     std::vector<std::pair<std::string, std::string>> params = {
         {"symbol", symbol},
-        {"side", side == OrderSide::BUY ? "BUY" : "SELL"},
-        {"type", "LIMIT"},
-        {"timeInForce", "GTC"},
-        {"quantity", quantity_formatted},
-        {"price", price_formatted}
+        {"side", side == OrderSide::BUY ? "BUY" : "SELL"}
     };
 
+    // LIMIT_MAKER takes no timeInForce
+    if (post_only) {
+        params.push_back({"type", "LIMIT_MAKER"});
+    } else {
+        params.push_back({"type", "LIMIT"});
+        params.push_back({"timeInForce", "GTC"});
+    }
+    params.push_back({"quantity", quantity_formatted});
+    params.push_back({"price", price_formatted});
+
     if (!client_order_id.empty()) {
         params.push_back({"newClientOrderId", client_order_id});
     }
+    params.push_back({"newOrderRespType", response_type_name(response_type)});
 
     auto response = send_signed_request("POST", "/api/v3/order", params);
     if (!response) {
@@ -328,56 +427,31 @@ std::optional<Order> RestClient::place_limit_order(
         return std::nullopt;
     }
 
-    // Enhanced order response logging
-    if (response->find("\"status\":\"NEW\"") != std::string::npos) {
-        // Success response - parse and display nicely
-        Json::Reader tmpReader;
-        Json::Value tmpRoot;
-        if (tmpReader.parse(*response, tmpRoot)) {
-            std::string order_id = tmpRoot["orderId"].asString();
-            std::string side_str = tmpRoot["side"].asString();
-            std::string price_str = tmpRoot["price"].asString();
-            std::string qty_str = tmpRoot["origQty"].asString();
-
-            if (side_str == "BUY") {
-                std::cout << "[SUCCESS] BID Order Placed" << std::endl;
-                std::cout << "  Order ID: " << order_id << " | Price: $" << price_str
-                         << " | Qty: " << qty_str << std::endl;
-            } else {
-                std::cout << "[SUCCESS] ASK Order Placed" << std::endl;
-                std::cout << "  Order ID: " << order_id << " | Price: $" << price_str
-                         << " | Qty: " << qty_str << std::endl;
-            }
-        }
-    } else if (response->find("\"code\"") != std::string::npos) {
-        // Error response
-        Json::Reader tmpReader;
-        Json::Value tmpRoot;
-        if (tmpReader.parse(*response, tmpRoot)) {
-            std::cout << "[ERROR] Order Failed: " << tmpRoot["msg"].asString() << std::endl;
-        } else {
-            std::cout << "[ERROR] Order Failed: " << *response << std::endl;
-        }
-    } else {
-        // Unknown response
-        std::cout << "Order response: " << *response << std::endl;
-    }
-
     Json::Reader reader;
     Json::Value root;
     if (!reader.parse(*response, root)) {
-        std::cerr << "Failed to parse order response" << std::endl;
+        std::cerr << "Failed to parse order response: " << *response << std::endl;
         return std::nullopt;
     }
 
     // Check for error response
     if (root.isMember("code") && root.isMember("msg")) {
+        std::cout << "[ERROR] Order Failed: " << root["msg"].asString() << std::endl;
         std::cerr << "Order error: " << root["msg"].asString()
                   << " (code: " << root["code"].asInt() << ")" << std::endl;
+        report_order_error(root, symbol, &side);
         return std::nullopt;
     }
 
+    // An ACK only carries the ids; price, quantity and status are what we
+    // sent, and fills arrive on the user data stream
     Order order;
+    order.symbol = symbol;
+    order.side = side;
+    order.price = price;
+    order.quantity = quantity;
+    order.executed_quantity = 0.0;
+    order.status = OrderStatus::NEW;
 
     // Parse orderId - can be numeric or string
     if (root["orderId"].isNumeric()) {
@@ -385,31 +459,20 @@ std::optional<Order> RestClient::place_limit_order(
     } else {
         order.order_id = root["orderId"].asString();
     }
-
     order.client_order_id = root["clientOrderId"].asString();
-    order.symbol = root["symbol"].asString();
-    order.side = root["side"].asString() == "BUY" ? OrderSide::BUY : OrderSide::SELL;
 
-    // Parse prices and quantities - handle both string and numeric formats
-    if (root["price"].isString()) {
-        order.price = std::stod(root["price"].asString());
-    } else {
-        order.price = root["price"].asDouble();
-    }
-
-    if (root["origQty"].isString()) {
-        order.quantity = std::stod(root["origQty"].asString());
-    } else {
-        order.quantity = root["origQty"].asDouble();
+    // RESULT and FULL add the order state as the exchange saw it
+    if (root.isMember("status")) {
+        order.price = to_double(root["price"]);
+        order.quantity = to_double(root["origQty"]);
+        order.executed_quantity = to_double(root["executedQty"]);
+        order.status = parse_order_status(root["status"].asString());
     }
 
-    if (root["executedQty"].isString()) {
-        order.executed_quantity = std::stod(root["executedQty"].asString());
-    } else {
-        order.executed_quantity = root["executedQty"].asDouble();
-    }
+    std::cout << "[SUCCESS] " << (side == OrderSide::BUY ? "BID" : "ASK") << " Order Placed" << std::endl;
+    std::cout << "  Order ID: " << order.order_id << " | Price: $" << price_formatted
+              << " | Qty: " << quantity_formatted << std::endl;
 
-    order.status = OrderStatus::NEW;
     order.created_time = std::chrono::steady_clock::now();
 
     return order;
@@ -433,6 +496,11 @@ std::optional<bool> RestClient::cancel_order(const std::string& symbol, const st
         return false;
     }
 
+    if (root.isMember("code") && root.isMember("msg")) {
+        report_order_error(root, symbol);
+        return false;
+    }
+
     return root["status"].asString() == "CANCELED";
 }
 
@@ -496,6 +564,11 @@ std::optional<Order> RestClient::modify_order(
         return std::nullopt;
     }
 
+    if (root.isMember("code") && root.isMember("msg")) {
+        report_order_error(root, symbol);
+        return std::nullopt;
+    }
+
     Order order;
     order.order_id = std::to_string(root["orderId"].asInt64());
     order.symbol = root["symbol"].asString();
@@ -612,6 +685,81 @@ std::optional<double> RestClient::get_current_price(const std::string& symbol) {
     return std::stod(root["price"].asString());
 }
 
+std::optional<std::string> RestClient::create_listen_key() {
+    auto response = send_keyed_request("POST", "/api/v3/userDataStream", "");
+    if (!response) {
+        return std::nullopt;
+    }
+
+    Json::Reader reader;
+    Json::Value root;
+    if (!reader.parse(*response, root) || !root.isMember("listenKey")) {
+        std::cerr << "listenKey request failed: " << *response << std::endl;
+        return std::nullopt;
+    }
+
+    return root["listenKey"].asString();
+}
+
+bool RestClient::keepalive_listen_key(const std::string& listen_key) {
+    auto response = send_keyed_request("PUT", "/api/v3/userDataStream",
+                                       build_query_string({{"listenKey", listen_key}}));
+    return response && response->find("\"code\"") == std::string::npos;
+}
+
+std::optional<int64_t> RestClient::get_server_time() {
+    auto response = send_public_request("/api/v3/time", {});
+    if (!response) {
+        return std::nullopt;
+    }
+
+    Json::Reader reader;
+    Json::Value root;
+    if (!reader.parse(*response, root) || !root.isMember("serverTime")) {
+        return std::nullopt;
+    }
+
+    return root["serverTime"].asInt64();
+}
+
+std::optional<int64_t> RestClient::ping() {
+    auto start = std::chrono::steady_clock::now();
+    auto response = send_public_request("/api/v3/ping", {});
+    if (!response || response->find("\"code\"") != std::string::npos) {
+        return std::nullopt;
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+std::optional<int64_t> RestClient::test_order(const std::string& symbol, OrderSide side, double price,
+                                              double quantity, bool post_only) {
+    char price_buffer[32];
+    char quantity_buffer[32];
+    snprintf(price_buffer, sizeof(price_buffer), "%.2f", price);
+    snprintf(quantity_buffer, sizeof(quantity_buffer), "%.5f", quantity);
+
+    // Same parameters as place_limit_order, so the probe takes the order path
+    std::vector<std::pair<std::string, std::string>> params = {
+        {"symbol", symbol},
+        {"side", side == OrderSide::BUY ? "BUY" : "SELL"}
+    };
+    if (post_only) {
+        params.push_back({"type", "LIMIT_MAKER"});
+    } else {
+        params.push_back({"type", "LIMIT"});
+        params.push_back({"timeInForce", "GTC"});
+    }
+    params.push_back({"quantity", quantity_buffer});
+    params.push_back({"price", price_buffer});
+
+    auto start = std::chrono::steady_clock::now();
+    auto response = send_signed_request("POST", "/api/v3/order/test", params);
+    if (!response || response->find("\"code\"") != std::string::npos) {
+        return std::nullopt;
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
 std::optional<std::vector<Order>> RestClient::get_open_orders(const std::string& symbol) {
     std::vector<std::pair<std::string, std::string>> params = {
         {"symbol", symbol}
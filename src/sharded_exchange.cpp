@@ -0,0 +1,427 @@
+#include "sharded_exchange.h"
+#include <iostream>
+#include <algorithm>
+
+namespace MarketMaker {
+
+ShardedExchange::ShardedExchange(std::vector<Shard> shards, ShardPolicy policy, int orders_per_second,
+                                 const std::vector<std::string>& api_keys, const std::string& shared_label)
+    : policy_(policy), orders_per_second_(orders_per_second) {
+    for (size_t i = 0; i < shards.size(); ++i) {
+        auto state = std::make_unique<ShardState>(std::move(shards[i]), orders_per_second);
+        if (!shared_label.empty() && i < api_keys.size()) {
+            state->shared = SharedRateLimiter::open(api_keys[i], shared_label);
+            if (!state->shared) {
+                std::cerr << "[SHARD] " << state->shard.name
+                          << ": shared budget unavailable, limiting this process only" << std::endl;
+            }
+        }
+        shards_.push_back(std::move(state));
+    }
+}
+
+ShardedExchange::ShardPolicy ShardedExchange::parse_policy(const std::string& name) {
+    return name == "load" ? ShardPolicy::LOAD : ShardPolicy::SIDE;
+}
+
+// ========== Connection Management ==========
+
+bool ShardedExchange::initialize(const ExchangeConfig& config) {
+    // Shards are initialized with their own credentials by the factory
+    config_ = config;
+    return !shards_.empty();
+}
+
+bool ShardedExchange::connect() {
+    bool connected = true;
+    for (auto& state : shards_) {
+        if (!state->shard.exchange->connect()) {
+            std::cerr << "[SHARD] " << state->shard.name << " failed to connect" << std::endl;
+            connected = false;
+        }
+    }
+    return connected;
+}
+
+void ShardedExchange::disconnect() {
+    for (auto& state : shards_) {
+        state->shard.exchange->disconnect();
+    }
+}
+
+bool ShardedExchange::is_connected() const {
+    return std::all_of(shards_.begin(), shards_.end(),
+                       [](const auto& state) { return state->shard.exchange->is_connected(); });
+}
+
+// ========== Market Data ==========
+
+bool ShardedExchange::subscribe_orderbook(const std::string& symbol, int depth) {
+    return primary().subscribe_orderbook(symbol, depth);
+}
+
+bool ShardedExchange::subscribe_trades(const std::string& symbol) {
+    return primary().subscribe_trades(symbol);
+}
+
+bool ShardedExchange::unsubscribe(const std::string& symbol) {
+    return primary().unsubscribe(symbol);
+}
+
+std::optional<OrderBook> ShardedExchange::get_orderbook(const std::string& symbol, int limit) {
+    return primary().get_orderbook(symbol, limit);
+}
+
+std::optional<double> ShardedExchange::get_current_price(const std::string& symbol) {
+    return primary().get_current_price(symbol);
+}
+
+std::optional<std::string> ShardedExchange::get_exchange_info() {
+    return primary().get_exchange_info();
+}
+
+bool ShardedExchange::subscribe_user_data() {
+    // Fills of every account, or inventory would miss some
+    bool subscribed = true;
+    for (auto& state : shards_) {
+        if (!state->shard.exchange->subscribe_user_data()) {
+            std::cerr << "[SHARD] " << state->shard.name << ": no user data stream" << std::endl;
+            subscribed = false;
+        }
+    }
+    return subscribed;
+}
+
+// ========== Order Management ==========
+
+bool ShardedExchange::try_acquire(ShardState& state) {
+    std::chrono::milliseconds wait{0};
+    if (state.shared &&
+        !state.shared->try_acquire(SharedRateLimiter::Kind::ORDERS, orders_per_second_, orders_per_second_ * 2, wait)) {
+        return false;
+    }
+    if (state.shared) {
+        state.orders.record_request();  // Local stats; the shared segment holds the limit
+        return true;
+    }
+    return state.orders.try_acquire(wait);
+}
+
+std::chrono::milliseconds ShardedExchange::time_until_slot(ShardState& state) const {
+    if (state.shared) {
+        // Bucketed in 100 ms: a full window frees up within one bucket or so
+        bool full = state.shared->count(SharedRateLimiter::Kind::ORDERS, std::chrono::seconds(1)) >= orders_per_second_ * 2 ||
+                    state.shared->count(SharedRateLimiter::Kind::ORDERS, std::chrono::seconds(10)) >= orders_per_second_ * 10;
+        return std::chrono::milliseconds(full ? 100 : 0);
+    }
+    return state.orders.time_until_available();
+}
+
+std::vector<size_t> ShardedExchange::side_shards(OrderSide side) const {
+    size_t count = shards_.size();
+    std::vector<size_t> indices;
+    if (count == 1 || policy_ == ShardPolicy::LOAD) {
+        for (size_t i = 0; i < count; ++i) {
+            indices.push_back(i);
+        }
+        return indices;
+    }
+    for (size_t i = side == OrderSide::BUY ? 0 : 1; i < count; i += 2) {
+        indices.push_back(i);
+    }
+    return indices;
+}
+
+std::optional<size_t> ShardedExchange::pick_shard(OrderSide side) {
+    std::vector<size_t> candidates = side_shards(side);
+
+    if (policy_ == ShardPolicy::LOAD) {
+        // Fewest orders in the 10 s window first
+        std::vector<std::pair<int, size_t>> loads;
+        for (size_t index : candidates) {
+            loads.emplace_back(shards_[index]->orders.get_stats().requests_in_rate_window, index);
+        }
+        std::sort(loads.begin(), loads.end());
+        for (const auto& [load, index] : loads) {
+            if (try_acquire(*shards_[index])) {
+                return index;
+            }
+        }
+        return std::nullopt;
+    }
+
+    // SIDE: rotate over this side's shards, skipping ones out of budget
+    size_t group = candidates.size();
+    uint64_t start = next_[static_cast<int>(side)]++;
+    for (size_t attempt = 0; attempt < group; ++attempt) {
+        size_t index = candidates[(start + attempt) % group];
+        if (try_acquire(*shards_[index])) {
+            return index;
+        }
+    }
+    return std::nullopt;
+}
+
+std::chrono::milliseconds ShardedExchange::time_until_order_slot(OrderSide side) {
+    auto soonest = std::chrono::milliseconds::max();
+    for (size_t index : side_shards(side)) {
+        soonest = std::min(soonest, time_until_slot(*shards_[index]));
+    }
+    return soonest == std::chrono::milliseconds::max() ? std::chrono::milliseconds(0) : soonest;
+}
+
+std::optional<Order> ShardedExchange::place_limit_order(
+    const std::string& symbol,
+    OrderSide side,
+    double price,
+    double quantity,
+    const std::string& client_order_id,
+    bool post_only) {
+
+    auto picked = pick_shard(side);
+    if (!picked) {
+        std::cerr << "[SHARD] No " << (side == OrderSide::BUY ? "bid" : "ask")
+                  << " account has order budget left" << std::endl;
+        return std::nullopt;
+    }
+    size_t index = *picked;
+    auto& state = *shards_[index];
+    state.placed++;
+
+    auto order = state.shard.exchange->place_limit_order(symbol, side, price, quantity, client_order_id, post_only);
+    if (order && !order->order_id.empty()) {
+        remember(order->order_id, index);
+    }
+    return order;
+}
+
+std::optional<Order> ShardedExchange::place_market_order(
+    const std::string& symbol,
+    OrderSide side,
+    double quantity,
+    const std::string& client_order_id) {
+
+    auto index = pick_shard(side);
+    if (!index) {
+        std::cerr << "[SHARD] No " << (side == OrderSide::BUY ? "bid" : "ask")
+                  << " account has order budget left" << std::endl;
+        return std::nullopt;
+    }
+    shards_[*index]->placed++;
+    return shards_[*index]->shard.exchange->place_market_order(symbol, side, quantity, client_order_id);
+}
+
+std::optional<bool> ShardedExchange::cancel_order(const std::string& symbol, const std::string& order_id) {
+    if (auto index = route_of(order_id)) {
+        auto result = shards_[*index]->shard.exchange->cancel_order(symbol, order_id);
+        if (result && *result) {
+            forget(order_id);
+        }
+        return result;
+    }
+
+    // Unknown (e.g. placed before a restart): whichever account has it
+    for (auto& state : shards_) {
+        auto result = state->shard.exchange->cancel_order(symbol, order_id);
+        if (result && *result) {
+            return result;
+        }
+    }
+    return false;
+}
+
+std::optional<bool> ShardedExchange::cancel_all_orders(const std::string& symbol) {
+    bool cancelled = true;
+    for (auto& state : shards_) {
+        auto result = state->shard.exchange->cancel_all_orders(symbol);
+        cancelled &= result.value_or(false);
+    }
+
+    std::lock_guard<std::mutex> lock(routes_mutex_);
+    routes_.clear();
+    return cancelled;
+}
+
+std::optional<Order> ShardedExchange::modify_order(
+    const std::string& symbol,
+    const std::string& order_id,
+    double new_price,
+    double new_quantity) {
+
+    // A replace is a new order on the account holding the old one
+    size_t index = route_of(order_id).value_or(0);
+    if (!try_acquire(*shards_[index])) {
+        std::cerr << "[SHARD] " << shards_[index]->shard.name << " has no order budget left for a modify" << std::endl;
+        return std::nullopt;
+    }
+    auto order = shards_[index]->shard.exchange->modify_order(symbol, order_id, new_price, new_quantity);
+    if (order && order->order_id != order_id) {
+        forget(order_id);
+        remember(order->order_id, index);
+    }
+    return order;
+}
+
+std::optional<std::vector<Order>> ShardedExchange::get_open_orders(const std::string& symbol) {
+    std::vector<Order> orders;
+    for (auto& state : shards_) {
+        auto shard_orders = state->shard.exchange->get_open_orders(symbol);
+        if (!shard_orders) {
+            return std::nullopt;  // A partial list would hide orders
+        }
+        orders.insert(orders.end(), shard_orders->begin(), shard_orders->end());
+    }
+    return orders;
+}
+
+std::optional<Order> ShardedExchange::get_order_status(const std::string& symbol, const std::string& order_id) {
+    size_t index = route_of(order_id).value_or(0);
+    return shards_[index]->shard.exchange->get_order_status(symbol, order_id);
+}
+
+// ========== Account Information ==========
+
+std::optional<std::string> ShardedExchange::get_account_info() {
+    std::string info;
+    for (auto& state : shards_) {
+        if (auto shard_info = state->shard.exchange->get_account_info()) {
+            info += "[" + state->shard.name + "] " + *shard_info + "\n";
+        }
+    }
+    if (info.empty()) {
+        return std::nullopt;
+    }
+    return info;
+}
+
+std::optional<double> ShardedExchange::get_balance(const std::string& asset) {
+    double total = 0.0;
+    for (auto& state : shards_) {
+        auto balance = state->shard.exchange->get_balance(asset);
+        if (!balance) {
+            return std::nullopt;
+        }
+        total += *balance;
+    }
+    return total;
+}
+
+// ========== Event Handlers ==========
+
+void ShardedExchange::set_orderbook_handler(OrderbookHandler handler) {
+    primary().set_orderbook_handler(handler);
+}
+
+void ShardedExchange::set_message_handler(MessageHandler handler) {
+    primary().set_message_handler(handler);
+}
+
+void ShardedExchange::set_connection_handler(ConnectionHandler handler) {
+    for (auto& state : shards_) {
+        state->shard.exchange->set_connection_handler(handler);
+    }
+}
+
+void ShardedExchange::set_execution_handler(ExecutionHandler handler) {
+    execution_handler_ = handler;
+    for (auto& state : shards_) {
+        state->shard.exchange->set_execution_handler([this](const ExecutionReport& report) {
+            bool terminal = report.status == OrderStatus::FILLED || report.status == OrderStatus::CANCELED ||
+                            report.status == OrderStatus::REJECTED || report.status == OrderStatus::EXPIRED;
+            if (terminal) {
+                forget(report.order_id);
+            }
+            if (execution_handler_) {
+                execution_handler_(report);
+            }
+        });
+    }
+}
+
+void ShardedExchange::set_book_delta_handler(BookDeltaHandler handler) {
+    primary().set_book_delta_handler(handler);
+}
+
+// ========== Utility Methods ==========
+
+std::string ShardedExchange::get_exchange_name() const {
+    return primary().get_exchange_name();
+}
+
+bool ShardedExchange::supports_websocket_trading() const {
+    return primary().supports_websocket_trading();
+}
+
+bool ShardedExchange::get_symbol_info(const std::string& symbol, int& price_precision, int& quantity_precision) {
+    return primary().get_symbol_info(symbol, price_precision, quantity_precision);
+}
+
+bool ShardedExchange::sync_clock() {
+    return primary().sync_clock();
+}
+
+std::optional<ExchangeFilters> ShardedExchange::get_symbol_filters(const std::string& symbol) {
+    return primary().get_symbol_filters(symbol);
+}
+
+std::vector<LatencyProbe> ShardedExchange::probe_latency(const std::optional<ProbeOrder>& order) {
+    std::vector<LatencyProbe> probes;
+    for (auto& state : shards_) {
+        for (auto& probe : state->shard.exchange->probe_latency(order)) {
+            probe.connection = state->shard.name + "/" + probe.connection;
+            probes.push_back(std::move(probe));
+        }
+    }
+    return probes;
+}
+
+double ShardedExchange::format_price(double price, const std::string& symbol) {
+    return primary().format_price(price, symbol);
+}
+
+double ShardedExchange::format_quantity(double quantity, const std::string& symbol) {
+    return primary().format_quantity(quantity, symbol);
+}
+
+double ShardedExchange::get_min_order_size(const std::string& symbol) {
+    return primary().get_min_order_size(symbol);
+}
+
+double ShardedExchange::get_max_order_size(const std::string& symbol) {
+    return primary().get_max_order_size(symbol);
+}
+
+double ShardedExchange::get_tick_size(const std::string& symbol) {
+    return primary().get_tick_size(symbol);
+}
+
+std::vector<std::pair<std::string, uint64_t>> ShardedExchange::get_shard_order_counts() const {
+    std::vector<std::pair<std::string, uint64_t>> counts;
+    for (const auto& state : shards_) {
+        counts.emplace_back(state->shard.name, state->placed.load());
+    }
+    return counts;
+}
+
+// ========== Routing ==========
+
+std::optional<size_t> ShardedExchange::route_of(const std::string& order_id) const {
+    std::lock_guard<std::mutex> lock(routes_mutex_);
+    auto it = routes_.find(order_id);
+    if (it == routes_.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+void ShardedExchange::remember(const std::string& order_id, size_t shard) {
+    std::lock_guard<std::mutex> lock(routes_mutex_);
+    routes_[order_id] = shard;
+}
+
+void ShardedExchange::forget(const std::string& order_id) {
+    std::lock_guard<std::mutex> lock(routes_mutex_);
+    routes_.erase(order_id);
+}
+
+} // namespace MarketMaker
@@ -0,0 +1,251 @@
+#include "shared_rate_limiter.h"
+#include <atomic>
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace MarketMaker {
+
+namespace {
+
+constexpr uint64_t SEGMENT_MAGIC = 0x4d4d524c00000001ULL;  // "MMRL", layout 1
+constexpr int BUCKET_MS = 100;
+constexpr int BUCKETS = 128;               // 12.8 s: covers the 10 s rate window
+constexpr int BURST_BUCKETS = 1000 / BUCKET_MS;
+constexpr int RATE_BUCKETS = 10000 / BUCKET_MS;
+constexpr int MAX_PROCESSES = 32;
+constexpr int COUNT_BITS = 24;
+constexpr uint64_t COUNT_MASK = (1ULL << COUNT_BITS) - 1;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared counters need lock-free 64-bit atomics");
+static_assert(std::atomic<int32_t>::is_always_lock_free, "shared counters need lock-free 32-bit atomics");
+
+uint64_t pack(int64_t bucket, uint64_t count) {
+    return (static_cast<uint64_t>(bucket) << COUNT_BITS) | (count & COUNT_MASK);
+}
+
+int64_t bucket_of(uint64_t word) {
+    return static_cast<int64_t>(word >> COUNT_BITS);
+}
+
+uint64_t count_of(uint64_t word) {
+    return word & COUNT_MASK;
+}
+
+// FNV-1a: the segment name must not reveal the key
+uint64_t hash_key(const std::string& key) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (unsigned char c : key) {
+        hash ^= c;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+bool process_alive(int pid) {
+    return pid > 0 && (kill(pid, 0) == 0 || errno == EPERM);
+}
+
+} // namespace
+
+struct SharedRateLimiter::Segment {
+    std::atomic<uint64_t> magic;
+    std::atomic<uint64_t> buckets[2][BUCKETS];  // Indexed by Kind
+
+    struct Process {
+        std::atomic<int32_t> pid;
+        char label[28];
+        std::atomic<uint64_t> orders;
+        std::atomic<uint64_t> cancels;
+    };
+    Process processes[MAX_PROCESSES];
+};
+
+std::unique_ptr<SharedRateLimiter> SharedRateLimiter::open(const std::string& api_key, const std::string& label) {
+    char name[64];
+    std::snprintf(name, sizeof(name), "/market_maker_rl_%016llx",
+                  static_cast<unsigned long long>(hash_key(api_key)));
+
+    int fd = shm_open(name, O_RDWR | O_CREAT, 0600);
+    if (fd < 0) {
+        std::cerr << "[RATE LIMIT] shm_open " << name << " failed: " << std::strerror(errno) << std::endl;
+        return nullptr;
+    }
+
+    // Grows a new segment (zero-filled); a no-op for an existing one
+    struct stat st {};
+    if (fstat(fd, &st) != 0 ||
+        (st.st_size < static_cast<off_t>(sizeof(Segment)) && ftruncate(fd, sizeof(Segment)) != 0)) {
+        std::cerr << "[RATE LIMIT] Cannot size " << name << ": " << std::strerror(errno) << std::endl;
+        close(fd);
+        return nullptr;
+    }
+
+    void* memory = mmap(nullptr, sizeof(Segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED) {
+        std::cerr << "[RATE LIMIT] mmap " << name << " failed: " << std::strerror(errno) << std::endl;
+        return nullptr;
+    }
+
+    auto* segment = static_cast<Segment*>(memory);
+    uint64_t magic = 0;
+    if (!segment->magic.compare_exchange_strong(magic, SEGMENT_MAGIC) && magic != SEGMENT_MAGIC) {
+        std::cerr << "[RATE LIMIT] " << name << " has an incompatible layout" << std::endl;
+        munmap(memory, sizeof(Segment));
+        return nullptr;
+    }
+
+    // Claim a free row, or one left behind by a process that died
+    int pid = static_cast<int>(getpid());
+    int slot = -1;
+    for (int i = 0; i < MAX_PROCESSES && slot < 0; ++i) {
+        auto& process = segment->processes[i];
+        int32_t owner = process.pid.load();
+        if ((owner == 0 || !process_alive(owner)) && process.pid.compare_exchange_strong(owner, pid)) {
+            std::strncpy(process.label, label.c_str(), sizeof(process.label) - 1);
+            process.label[sizeof(process.label) - 1] = '\0';
+            process.orders = 0;
+            process.cancels = 0;
+            slot = i;
+        }
+    }
+    if (slot < 0) {
+        std::cerr << "[RATE LIMIT] Process table of " << name << " full, usage not attributed" << std::endl;
+    }
+
+    std::cout << "[RATE LIMIT] Sharing order budget through " << name << std::endl;
+    return std::unique_ptr<SharedRateLimiter>(new SharedRateLimiter(segment, name, slot));
+}
+
+SharedRateLimiter::SharedRateLimiter(Segment* segment, std::string name, int slot)
+    : segment_(segment), name_(std::move(name)), slot_(slot) {}
+
+SharedRateLimiter::~SharedRateLimiter() {
+    if (slot_ >= 0) {
+        segment_->processes[slot_].pid.store(0);
+    }
+    // The segment itself stays: other processes may still be using it
+    munmap(segment_, sizeof(Segment));
+}
+
+bool SharedRateLimiter::try_acquire(Kind kind, int per_second, int burst, std::chrono::milliseconds& wait) {
+    auto& ring = segment_->buckets[static_cast<int>(kind)];
+    int64_t bucket = now_bucket();
+    auto& slot = ring[bucket % BUCKETS];
+
+    // Count ourselves in first, then check: two processes racing for the last
+    // slot can both back off, but never both get it
+    uint64_t word = slot.load();
+    while (true) {
+        uint64_t next = bucket_of(word) == bucket ? pack(bucket, count_of(word) + 1) : pack(bucket, 1);
+        if (slot.compare_exchange_weak(word, next)) {
+            break;
+        }
+    }
+
+    int64_t wait_ms = 0;
+    if (burst > 0) {
+        wait_ms = std::max(wait_ms, wait_for(kind, bucket, BURST_BUCKETS, burst));
+    }
+    if (per_second > 0) {
+        wait_ms = std::max(wait_ms, wait_for(kind, bucket, RATE_BUCKETS, per_second * (RATE_BUCKETS / BURST_BUCKETS)));
+    }
+
+    if (wait_ms > 0) {
+        release(kind, bucket);
+        wait = std::chrono::milliseconds(wait_ms);
+        return false;
+    }
+
+    if (slot_ >= 0) {
+        auto& process = segment_->processes[slot_];
+        (kind == Kind::ORDERS ? process.orders : process.cancels).fetch_add(1, std::memory_order_relaxed);
+    }
+    wait = std::chrono::milliseconds(0);
+    return true;
+}
+
+int SharedRateLimiter::count(Kind kind, std::chrono::milliseconds window) const {
+    const auto& ring = segment_->buckets[static_cast<int>(kind)];
+    int64_t bucket = now_bucket();
+    int64_t buckets = std::min<int64_t>(window.count() / BUCKET_MS, BUCKETS);
+
+    uint64_t total = 0;
+    for (int64_t b = bucket - buckets + 1; b <= bucket; ++b) {
+        uint64_t word = ring[b % BUCKETS].load(std::memory_order_relaxed);
+        total += bucket_of(word) == b ? count_of(word) : 0;
+    }
+    return static_cast<int>(total);
+}
+
+int64_t SharedRateLimiter::wait_for(Kind kind, int64_t bucket, int buckets, int limit) const {
+    const auto& ring = segment_->buckets[static_cast<int>(kind)];
+
+    uint64_t counts[BUCKETS];
+    uint64_t total = 0;
+    for (int i = 0; i < buckets; ++i) {
+        int64_t b = bucket - buckets + 1 + i;
+        uint64_t word = ring[b % BUCKETS].load(std::memory_order_relaxed);
+        counts[i] = bucket_of(word) == b ? count_of(word) : 0;
+        total += counts[i];
+    }
+    if (total <= static_cast<uint64_t>(limit)) {
+        return 0;
+    }
+
+    // Oldest buckets leave the window first: wait until enough of them have
+    // for this request (already counted) to fit
+    int64_t now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    for (int i = 0; i < buckets; ++i) {
+        total -= counts[i];
+        if (total <= static_cast<uint64_t>(limit)) {
+            int64_t leaves_at = (bucket - buckets + 1 + i + buckets) * BUCKET_MS;
+            return std::max<int64_t>(leaves_at - now_ms, 1);
+        }
+    }
+    return BUCKET_MS;
+}
+
+void SharedRateLimiter::release(Kind kind, int64_t bucket) {
+    auto& slot = segment_->buckets[static_cast<int>(kind)][bucket % BUCKETS];
+    uint64_t word = slot.load();
+    // If the bucket has already been recycled our count left with it
+    while (bucket_of(word) == bucket && count_of(word) > 0) {
+        if (slot.compare_exchange_weak(word, pack(bucket, count_of(word) - 1))) {
+            return;
+        }
+    }
+}
+
+std::vector<SharedRateLimiter::ProcessUsage> SharedRateLimiter::usage() const {
+    std::vector<ProcessUsage> result;
+    for (const auto& process : segment_->processes) {
+        int pid = process.pid.load();
+        if (pid == 0 || !process_alive(pid)) {
+            continue;
+        }
+        ProcessUsage usage;
+        usage.pid = pid;
+        usage.label.assign(process.label, strnlen(process.label, sizeof(process.label)));
+        usage.orders = process.orders.load(std::memory_order_relaxed);
+        usage.cancels = process.cancels.load(std::memory_order_relaxed);
+        result.push_back(usage);
+    }
+    return result;
+}
+
+int64_t SharedRateLimiter::now_bucket() {
+    // steady_clock is CLOCK_MONOTONIC, the same clock in every process on the host
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count() / BUCKET_MS;
+}
+
+} // namespace MarketMaker
@@ -0,0 +1,250 @@
+#include "socket_options.h"
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/ip.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <sys/time.h>
+
+namespace MarketMaker {
+
+namespace {
+
+int get_int_option(int fd, int level, int name) {
+    int value = 0;
+    socklen_t len = sizeof(value);
+    if (getsockopt(fd, level, name, &value, &len) < 0) {
+        return -1;
+    }
+    return value;
+}
+
+void set_int_option(int fd, int level, int name, int value, const char* label,
+                    AppliedSocketOptions& report) {
+    if (setsockopt(fd, level, name, &value, sizeof(value)) < 0) {
+        report.failures.push_back(std::string(label) + ": " + strerror(errno));
+    }
+}
+
+int socket_family(int fd) {
+    sockaddr_storage addr{};
+    socklen_t len = sizeof(addr);
+    if (getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len) < 0) {
+        return AF_INET;
+    }
+    return addr.ss_family;
+}
+
+} // namespace
+
+std::string AppliedSocketOptions::to_string() const {
+    std::stringstream ss;
+    ss << "fd=" << fd
+       << " nodelay=" << tcp_nodelay
+       << " quickack=" << tcp_quickack
+       << " busy_poll=" << busy_poll_us << "us"
+       << " rcvbuf=" << rcvbuf_bytes
+       << " sndbuf=" << sndbuf_bytes
+       << " tos=0x" << std::hex << (ip_tos < 0 ? 0 : ip_tos) << std::dec;
+    for (const auto& failure : failures) {
+        ss << " [failed " << failure << "]";
+    }
+    return ss.str();
+}
+
+AppliedSocketOptions SocketTuning::apply(int fd, const SocketProfile& profile) {
+    AppliedSocketOptions report;
+    report.fd = fd;
+
+    if (fd < 0) {
+        report.failures.push_back("invalid fd");
+        return report;
+    }
+
+    if (profile.io_timeout_ms > 0) {
+        struct timeval timeout;
+        timeout.tv_sec = profile.io_timeout_ms / 1000;
+        timeout.tv_usec = (profile.io_timeout_ms % 1000) * 1000;
+        if (setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout)) < 0) {
+            report.failures.push_back(std::string("SO_RCVTIMEO: ") + strerror(errno));
+        }
+        if (setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout)) < 0) {
+            report.failures.push_back(std::string("SO_SNDTIMEO: ") + strerror(errno));
+        }
+    }
+
+    set_int_option(fd, IPPROTO_TCP, TCP_NODELAY, profile.tcp_nodelay ? 1 : 0, "TCP_NODELAY", report);
+
+#ifdef TCP_QUICKACK
+    if (profile.tcp_quickack) {
+        set_int_option(fd, IPPROTO_TCP, TCP_QUICKACK, 1, "TCP_QUICKACK", report);
+    }
+#endif
+
+#ifdef SO_BUSY_POLL
+    if (profile.busy_poll_us > 0) {
+        // Values above net.core.busy_read need CAP_NET_ADMIN
+        set_int_option(fd, SOL_SOCKET, SO_BUSY_POLL, profile.busy_poll_us, "SO_BUSY_POLL", report);
+    }
+#endif
+
+    if (profile.rcvbuf_bytes > 0) {
+        set_int_option(fd, SOL_SOCKET, SO_RCVBUF, profile.rcvbuf_bytes, "SO_RCVBUF", report);
+    }
+    if (profile.sndbuf_bytes > 0) {
+        set_int_option(fd, SOL_SOCKET, SO_SNDBUF, profile.sndbuf_bytes, "SO_SNDBUF", report);
+    }
+
+    int family = socket_family(fd);
+    if (profile.ip_tos > 0) {
+        if (family == AF_INET6) {
+            set_int_option(fd, IPPROTO_IPV6, IPV6_TCLASS, profile.ip_tos, "IPV6_TCLASS", report);
+        } else {
+            set_int_option(fd, IPPROTO_IP, IP_TOS, profile.ip_tos, "IP_TOS", report);
+        }
+    }
+
+    // Read back what the kernel actually applied
+    report.tcp_nodelay = get_int_option(fd, IPPROTO_TCP, TCP_NODELAY);
+#ifdef TCP_QUICKACK
+    report.tcp_quickack = get_int_option(fd, IPPROTO_TCP, TCP_QUICKACK);
+#endif
+#ifdef SO_BUSY_POLL
+    report.busy_poll_us = get_int_option(fd, SOL_SOCKET, SO_BUSY_POLL);
+#endif
+    report.rcvbuf_bytes = get_int_option(fd, SOL_SOCKET, SO_RCVBUF);
+    report.sndbuf_bytes = get_int_option(fd, SOL_SOCKET, SO_SNDBUF);
+    report.ip_tos = (family == AF_INET6)
+        ? get_int_option(fd, IPPROTO_IPV6, IPV6_TCLASS)
+        : get_int_option(fd, IPPROTO_IP, IP_TOS);
+
+    return report;
+}
+
+void SocketTuning::rearm_quickack(int fd) {
+#ifdef TCP_QUICKACK
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_QUICKACK, &one, sizeof(one));
+#else
+    (void)fd;
+#endif
+}
+
+std::string ResolvedAddress::to_string() const {
+    char buffer[INET6_ADDRSTRLEN] = {0};
+    if (family == AF_INET6) {
+        auto* sin6 = reinterpret_cast<const sockaddr_in6*>(&addr);
+        inet_ntop(AF_INET6, &sin6->sin6_addr, buffer, sizeof(buffer));
+    } else {
+        auto* sin = reinterpret_cast<const sockaddr_in*>(&addr);
+        inet_ntop(AF_INET, &sin->sin_addr, buffer, sizeof(buffer));
+    }
+    return buffer;
+}
+
+std::optional<std::vector<ResolvedAddress>> DnsCache::resolve(
+    const std::string& host,
+    int port,
+    std::chrono::milliseconds timeout) {
+
+    std::string key = host + ":" + std::to_string(port);
+    std::shared_future<Result> pending;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& entry = entries_[key];
+        auto now = std::chrono::steady_clock::now();
+
+        if (!entry.addresses.empty()) {
+            // Serve from cache, refresh in background once stale
+            if (now - entry.resolved_at > ttl_ && !entry.pending.valid()) {
+                entry.pending = start_lookup(key, host, port);
+            }
+            return entry.addresses;
+        }
+
+        if (!entry.pending.valid()) {
+            entry.pending = start_lookup(key, host, port);
+        }
+        pending = entry.pending;
+    }
+
+    if (pending.wait_for(timeout) != std::future_status::ready) {
+        std::cerr << "[DNS] Resolution timeout for " << host << std::endl;
+        return std::nullopt;
+    }
+    return pending.get();
+}
+
+void DnsCache::prefetch(const std::string& host, int port) {
+    std::string key = host + ":" + std::to_string(port);
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& entry = entries_[key];
+    if (entry.addresses.empty() && !entry.pending.valid()) {
+        entry.pending = start_lookup(key, host, port);
+    }
+}
+
+// Called with mutex_ held
+std::shared_future<DnsCache::Result> DnsCache::start_lookup(
+    const std::string& key, const std::string& host, int port) {
+
+    auto promise = std::make_shared<std::promise<Result>>();
+    std::shared_future<Result> future = promise->get_future().share();
+
+    std::thread([this, promise, key, host, port]() {
+        Result result = lookup(host, port);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto& entry = entries_[key];
+            if (result) {
+                entry.addresses = *result;
+                entry.resolved_at = std::chrono::steady_clock::now();
+            }
+            entry.pending = std::shared_future<Result>();
+        }
+        promise->set_value(result);
+    }).detach();
+
+    return future;
+}
+
+DnsCache::Result DnsCache::lookup(const std::string& host, int port) {
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    struct addrinfo* results = nullptr;
+    std::string port_str = std::to_string(port);
+    int rc = getaddrinfo(host.c_str(), port_str.c_str(), &hints, &results);
+    if (rc != 0 || !results) {
+        std::cerr << "[DNS] Failed to resolve " << host << ": " << gai_strerror(rc) << std::endl;
+        return std::nullopt;
+    }
+
+    std::vector<ResolvedAddress> addresses;
+    for (auto* ai = results; ai; ai = ai->ai_next) {
+        ResolvedAddress address;
+        memcpy(&address.addr, ai->ai_addr, ai->ai_addrlen);
+        address.addr_len = ai->ai_addrlen;
+        address.family = ai->ai_family;
+
+        addresses.push_back(address);
+    }
+    freeaddrinfo(results);
+
+    // Prefer IPv4 first; exchanges usually route IPv4 faster
+    std::stable_partition(addresses.begin(), addresses.end(),
+        [](const ResolvedAddress& a) { return a.family == AF_INET; });
+
+    return addresses;
+}
+
+} // namespace MarketMaker
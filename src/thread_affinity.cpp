@@ -0,0 +1,33 @@
+#include "thread_affinity.h"
+#include <iostream>
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+
+namespace MarketMaker {
+
+bool pin_current_thread(int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+
+    int rc = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    if (rc != 0) {
+        std::cerr << "[AFFINITY] Cannot pin thread to CPU " << cpu << ": " << std::strerror(rc) << std::endl;
+        return false;
+    }
+    std::cout << "[AFFINITY] Thread pinned to CPU " << cpu << std::endl;
+    return true;
+}
+
+bool lower_current_thread_priority() {
+    sched_param param{};
+    if (pthread_setschedparam(pthread_self(), SCHED_IDLE, &param) == 0) {
+        return true;
+    }
+    // Per-thread on Linux: 0 is the calling thread
+    return setpriority(PRIO_PROCESS, 0, 19) == 0;
+}
+
+} // namespace MarketMaker
@@ -0,0 +1,184 @@
+#include "user_data_stream.h"
+#include <json/json.h>
+#include <iostream>
+
+namespace MarketMaker {
+
+namespace {
+
+double to_double(const Json::Value& value) {
+    if (value.isString()) {
+        try {
+            return std::stod(value.asString());
+        } catch (const std::exception&) {
+            return 0.0;
+        }
+    }
+    return value.isNumeric() ? value.asDouble() : 0.0;
+}
+
+OrderStatus parse_status(const std::string& status) {
+    if (status == "PARTIALLY_FILLED") return OrderStatus::PARTIALLY_FILLED;
+    if (status == "FILLED") return OrderStatus::FILLED;
+    if (status == "CANCELED") return OrderStatus::CANCELED;
+    if (status == "REJECTED") return OrderStatus::REJECTED;
+    if (status == "EXPIRED" || status == "EXPIRED_IN_MATCH") return OrderStatus::EXPIRED;
+    return OrderStatus::NEW;
+}
+
+} // namespace
+
+UserDataStream::UserDataStream(const std::string& ws_base_url,
+                               ListenKeyProvider create_listen_key,
+                               ListenKeyKeepalive keepalive_listen_key)
+    : ws_base_url_(ws_base_url),
+      create_listen_key_(create_listen_key),
+      keepalive_listen_key_(keepalive_listen_key),
+      connection_(std::make_unique<WsConnection>()) {
+
+    // Stream URLs end in /ws/<listenKey>
+    if (ws_base_url_.size() < 3 || ws_base_url_.substr(ws_base_url_.size() - 3) != "/ws") {
+        ws_base_url_ += "/ws";
+    }
+}
+
+UserDataStream::~UserDataStream() {
+    stop();
+}
+
+void UserDataStream::set_socket_profile(const SocketProfile& profile) {
+    connection_->set_socket_profile(profile);
+}
+
+void UserDataStream::enable_ktls(bool enable) {
+    connection_->enable_ktls(enable);
+}
+
+bool UserDataStream::open() {
+    auto key = create_listen_key_();
+    if (!key || key->empty()) {
+        std::cerr << "[USER STREAM] Failed to obtain listenKey" << std::endl;
+        return false;
+    }
+    listen_key_ = *key;
+    key_expired_ = false;
+
+    if (!connection_->connect(ws_base_url_ + "/" + listen_key_)) {
+        std::cerr << "[USER STREAM] Failed to connect" << std::endl;
+        return false;
+    }
+
+    connected_ = true;
+    std::cout << "[USER STREAM] Connected" << std::endl;
+    return true;
+}
+
+bool UserDataStream::start() {
+    if (running_) {
+        return true;
+    }
+
+    if (!open()) {
+        return false;
+    }
+
+    running_ = true;
+    reader_thread_ = std::thread(&UserDataStream::run_reader, this);
+    return true;
+}
+
+void UserDataStream::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+
+    connection_->close();
+    if (reader_thread_.joinable()) {
+        reader_thread_.join();
+    }
+    connected_ = false;
+}
+
+void UserDataStream::run_reader() {
+    auto on_message = [this](std::string_view message) { process_message(message); };
+    auto last_keepalive = std::chrono::steady_clock::now();
+
+    while (running_) {
+        auto status = connection_->wait_and_read(std::chrono::milliseconds(100), on_message);
+
+        if ((status == WsConnection::ReadStatus::OK || status == WsConnection::ReadStatus::TIMEOUT) &&
+            !key_expired_) {
+            auto now = std::chrono::steady_clock::now();
+            if (now - last_keepalive >= KEEPALIVE_INTERVAL) {
+                if (!keepalive_listen_key_(listen_key_)) {
+                    std::cerr << "[USER STREAM] listenKey keepalive failed" << std::endl;
+                }
+                last_keepalive = now;
+            }
+            continue;
+        }
+
+        if (!running_) {
+            break;
+        }
+
+        // Dropped or key expired: start over with a fresh key
+        connected_ = false;
+        connection_->close();
+        std::cerr << "[USER STREAM] Disconnected, reconnecting..." << std::endl;
+
+        while (running_) {
+            std::this_thread::sleep_for(RECONNECT_DELAY);
+            if (running_ && open()) {
+                last_keepalive = std::chrono::steady_clock::now();
+                break;
+            }
+        }
+    }
+}
+
+void UserDataStream::process_message(std::string_view message) {
+    auto received_time = connection_->last_receive_time();
+
+    if (message.find("\"listenKeyExpired\"") != std::string_view::npos) {
+        std::cerr << "[USER STREAM] listenKey expired" << std::endl;
+        key_expired_ = true;
+        return;
+    }
+
+    // Everything but order updates (balances, account position) is skipped unparsed
+    if (message.find("\"executionReport\"") == std::string_view::npos || !execution_handler_) {
+        return;
+    }
+
+    Json::Reader reader;
+    Json::Value event;
+    if (!reader.parse(message.data(), message.data() + message.size(), event)) {
+        std::cerr << "[USER STREAM] Failed to parse executionReport" << std::endl;
+        return;
+    }
+
+    // WebSocket API subscriptions wrap the payload in {"event": {...}}
+    if (event.isMember("event")) {
+        event = event["event"];
+    }
+
+    ExecutionReport report;
+    report.symbol = event["s"].asString();
+    report.order_id = std::to_string(event["i"].asInt64());
+    report.client_order_id = event["c"].asString();
+    report.side = event["S"].asString() == "BUY" ? OrderSide::BUY : OrderSide::SELL;
+    report.status = parse_status(event["X"].asString());
+    report.is_trade = event["x"].asString() == "TRADE";
+    report.price = to_double(event["p"]);
+    report.quantity = to_double(event["q"]);
+    report.last_filled_price = to_double(event["L"]);
+    report.last_filled_quantity = to_double(event["l"]);
+    report.cumulative_filled_quantity = to_double(event["z"]);
+    report.event_time_ms = event["E"].asInt64();
+    report.received_time = received_time;
+
+    execution_handler_(report);
+}
+
+} // namespace MarketMaker
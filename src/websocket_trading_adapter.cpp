@@ -1,8 +1,10 @@
 #include "websocket_trading_adapter.h"
+#include "exchange_clock.h"
 #include <json/json.h>
 #include <iostream>
 #include <algorithm>
 #include <cctype>
+#include <cmath>
 #include <thread>
 #include <chrono>
 
@@ -31,6 +33,9 @@ WebSocketTradingAdapter::WebSocketTradingAdapter(
     ws_trading_client_->set_order_response_handler(
         [this](const Json::Value& response) { handle_trading_response(response); }
     );
+    ws_trading_client_->set_ack_handler(
+        [this](const WsApiAck& ack) { handle_trading_ack(ack); }
+    );
 
     // Enable auto-reconnect for both clients
     ws_market_client_->enable_auto_reconnect(true);
@@ -43,6 +48,15 @@ WebSocketTradingAdapter::~WebSocketTradingAdapter() {
     disconnect();
 }
 
+bool WebSocketTradingAdapter::initialize(const ExchangeConfig& config) {
+    config_ = config;
+    ws_market_client_->enable_ktls(config.use_ktls);
+    ws_market_client_->set_socket_profile(config.socket_profile);
+    ws_trading_client_->set_socket_profile(config.socket_profile);
+    ws_trading_client_->enable_ktls(config.use_ktls);
+    return true;
+}
+
 bool WebSocketTradingAdapter::is_connected() const {
     return ws_market_client_->is_connected() && ws_trading_client_->is_connected();
 }
@@ -72,7 +86,12 @@ bool WebSocketTradingAdapter::connect() {
             ws_trading_client_->set_order_response_handler(
                 [this](const Json::Value& response) { handle_trading_response(response); }
             );
+            ws_trading_client_->set_ack_handler(
+                [this](const WsApiAck& ack) { handle_trading_ack(ack); }
+            );
             ws_trading_client_->enable_auto_reconnect(true);
+            ws_trading_client_->set_socket_profile(config_.socket_profile);
+            ws_trading_client_->enable_ktls(config_.use_ktls);
 
             std::this_thread::sleep_for(std::chrono::milliseconds(retry_delay_ms * attempt));
         }
@@ -91,6 +110,9 @@ bool WebSocketTradingAdapter::connect() {
 
     std::cout << "Successfully connected to WebSocket Trading API" << std::endl;
 
+    // Signed requests are stamped with exchange time from here on
+    sync_clock();
+
     // Set up connection handler to notify when both are connected
     if (connection_handler_) {
         connection_handler_(trading_connected);
@@ -100,6 +122,10 @@ bool WebSocketTradingAdapter::connect() {
 }
 
 void WebSocketTradingAdapter::disconnect() {
+    if (user_stream_) {
+        user_stream_->stop();
+    }
+
     if (ws_market_client_) {
         ws_market_client_->disconnect();
     }
@@ -130,6 +156,32 @@ bool WebSocketTradingAdapter::subscribe_orderbook(const std::string& symbol, int
     return true;
 }
 
+bool WebSocketTradingAdapter::subscribe_user_data() {
+    if (!user_stream_) {
+        // The trading client may be recreated on reconnect, so look it up per call
+        user_stream_ = std::make_unique<UserDataStream>(
+            ws_market_base_url_,
+            [this]() -> std::optional<std::string> {
+                auto client = ws_trading_client_;
+                return client ? client->start_user_data_stream() : std::nullopt;
+            },
+            [this](const std::string& key) {
+                auto client = ws_trading_client_;
+                return client && client->ping_user_data_stream(key);
+            }
+        );
+        user_stream_->set_socket_profile(config_.socket_profile);
+        user_stream_->enable_ktls(config_.use_ktls);
+        user_stream_->set_execution_handler([this](const ExecutionReport& report) {
+            if (execution_handler_) {
+                execution_handler_(report);
+            }
+        });
+    }
+
+    return user_stream_->start();
+}
+
 bool WebSocketTradingAdapter::subscribe_trades([[maybe_unused]] const std::string& symbol) {
     // This would subscribe to trade stream if needed
     return true;
@@ -180,13 +232,14 @@ std::optional<Order> WebSocketTradingAdapter::place_limit_order(
     OrderSide side,
     double price,
     double quantity,
-    const std::string& client_order_id) {
+    const std::string& client_order_id,
+    bool post_only) {
 
     auto start_time = std::chrono::steady_clock::now();
 
     // Use WebSocket API to place order
     auto order_id = ws_trading_client_->place_limit_order(
-        symbol, side, price, quantity, client_order_id, true
+        symbol, side, price, quantity, client_order_id, true, post_only, config_.order_response_type
     );
 
     if (!order_id) {
@@ -384,6 +437,79 @@ bool WebSocketTradingAdapter::get_symbol_info(
     return true;
 }
 
+bool WebSocketTradingAdapter::sync_clock() {
+    if (!ws_trading_client_ || !ws_trading_client_->is_connected()) {
+        return false;
+    }
+
+    int64_t sent = ExchangeClock::local_ms();
+    auto server_time = ws_trading_client_->get_server_time();
+    int64_t received = ExchangeClock::local_ms();
+
+    if (!server_time) {
+        std::cerr << "[CLOCK] Failed to fetch server time over WebSocket API" << std::endl;
+        return false;
+    }
+
+    ExchangeClock::instance().update(*server_time, sent, received);
+    return true;
+}
+
+std::vector<LatencyProbe> WebSocketTradingAdapter::probe_latency(const std::optional<ProbeOrder>& order) {
+    std::vector<LatencyProbe> probes;
+    if (!ws_trading_client_ || !ws_trading_client_->is_connected()) {
+        return probes;
+    }
+
+    probes.push_back({"ws-api", "ping", ws_trading_client_->ping().value_or(-1), 1});
+    if (order) {
+        auto rtt = ws_trading_client_->test_order(order->symbol, order->side, order->price,
+                                                  order->quantity, order->post_only);
+        probes.push_back({"ws-api", "order.test", rtt.value_or(-1), 1});
+    }
+    return probes;
+}
+
+std::optional<ExchangeFilters> WebSocketTradingAdapter::get_symbol_filters(const std::string& symbol) {
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        auto it = filters_cache_.find(symbol);
+        if (it != filters_cache_.end()) {
+            return it->second;
+        }
+    }
+
+    if (!ws_trading_client_ || !ws_trading_client_->is_connected()) {
+        return std::nullopt;
+    }
+
+    auto result = ws_trading_client_->get_exchange_info(symbol);
+    if (!result) {
+        std::cerr << "[WS Trading] Failed to fetch exchange info for " << symbol << std::endl;
+        return std::nullopt;
+    }
+
+    auto parsed = ExchangeFilterParser::parse_exchange_info(*result);
+    auto found = parsed.find(symbol);
+    if (found == parsed.end()) {
+        return std::nullopt;
+    }
+    const ExchangeFilters& filters = found->second;
+
+    // Replace the guessed precision with the exchange's
+    std::lock_guard<std::mutex> lock(cache_mutex_);
+    SymbolInfo info;
+    info.price_precision = filters.price_precision;
+    info.quantity_precision = filters.quantity_precision;
+    info.min_quantity = filters.min_qty;
+    info.max_quantity = filters.max_qty;
+    info.tick_size = filters.tick_size;
+    symbol_info_cache_[symbol] = info;
+    filters_cache_[symbol] = filters;
+
+    return filters;
+}
+
 double WebSocketTradingAdapter::format_price(double price, const std::string& symbol) {
     int precision = 2;
     int dummy;
@@ -524,6 +650,14 @@ void WebSocketTradingAdapter::handle_trading_response(const Json::Value& respons
     }
 }
 
+void WebSocketTradingAdapter::handle_trading_ack(const WsApiAck& ack) {
+    if (ack.has_error) {
+        std::cerr << "Trading error: " << ack.error_msg << std::endl;
+    } else if (ack.order_id != 0) {
+        std::cout << "Order response received - ID: " << ack.order_id << std::endl;
+    }
+}
+
 void WebSocketTradingAdapter::update_orderbook_from_message(const Json::Value& data) {
     std::lock_guard<std::mutex> lock(orderbook_mutex_);
 
@@ -559,9 +693,7 @@ void WebSocketTradingAdapter::update_orderbook_from_message(const Json::Value& d
     std::sort(current_orderbook_.asks.begin(), current_orderbook_.asks.end(),
               [](const PriceLevel& a, const PriceLevel& b) { return a.price < b.price; });
 
-    if (orderbook_handler_) {
-        orderbook_handler_(current_orderbook_);
-    }
+    notify_orderbook(current_orderbook_);
 }
 
 } // namespace MarketMaker
\ No newline at end of file
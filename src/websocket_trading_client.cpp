@@ -1,10 +1,13 @@
 #include "websocket_trading_client.h"
+#include "exchange_clock.h"
+#include "order_errors.h"
 #include <openssl/hmac.h>
 #include <openssl/sha.h>
-#include <websocketpp/common/thread.hpp>
 #include <iostream>
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
+#include <cstring>
 
 namespace MarketMaker {
 
@@ -25,54 +28,8 @@ void WebSocketTradingClient::TradingMetrics::update_response_time(double time_ms
 }
 
 WebSocketTradingClient::WebSocketTradingClient(const std::string& api_key, const std::string& api_secret)
-    : api_key_(api_key), api_secret_(api_secret) {
-
-    ws_client_ = std::make_unique<WsClient>();
-
-    // Initialize WebSocket client
-    ws_client_->init_asio();
-    ws_client_->set_reuse_addr(true);  // Allow socket reuse
-    ws_client_->set_access_channels(websocketpp::log::alevel::none);
-    ws_client_->set_error_channels(websocketpp::log::elevel::all);
-
-    // Set up TLS handler with proper SSL initialization
-    ws_client_->set_tls_init_handler([](websocketpp::connection_hdl) {
-        auto ctx = websocketpp::lib::make_shared<websocketpp::lib::asio::ssl::context>(
-            websocketpp::lib::asio::ssl::context::tlsv12_client);
-
-        try {
-            ctx->set_options(
-                websocketpp::lib::asio::ssl::context::default_workarounds |
-                websocketpp::lib::asio::ssl::context::no_sslv2 |
-                websocketpp::lib::asio::ssl::context::no_sslv3 |
-                websocketpp::lib::asio::ssl::context::single_dh_use
-            );
-
-            ctx->set_verify_mode(websocketpp::lib::asio::ssl::verify_none);
-
-        } catch (std::exception& e) {
-            std::cerr << "[SSL] Context setup error: " << e.what() << std::endl;
-        }
-
-        return ctx;
-    });
-
-    // Set up connection handlers
-    ws_client_->set_open_handler([this](websocketpp::connection_hdl hdl) {
-        this->on_open(hdl);
-    });
-
-    ws_client_->set_close_handler([this](websocketpp::connection_hdl hdl) {
-        this->on_close(hdl);
-    });
-
-    ws_client_->set_fail_handler([this](websocketpp::connection_hdl hdl) {
-        this->on_fail(hdl);
-    });
-
-    ws_client_->set_message_handler([this](websocketpp::connection_hdl hdl, WsMessagePtr msg) {
-        this->on_message(hdl, msg);
-    });
+    : connection_(std::make_unique<WsConnection>()),
+      api_key_(api_key), api_secret_(api_secret) {
 
     std::cout << "WebSocket Trading Client initialized with API Key: "
               << api_key_.substr(0, 10) << "..." << std::endl;
@@ -82,51 +39,51 @@ WebSocketTradingClient::~WebSocketTradingClient() {
     disconnect();
 }
 
+void WebSocketTradingClient::set_socket_profile(const SocketProfile& profile) {
+    connection_->set_socket_profile(profile);
+}
+
+AppliedSocketOptions WebSocketTradingClient::get_socket_report() const {
+    return connection_->socket_report();
+}
+
+void WebSocketTradingClient::enable_ktls(bool enable) {
+    connection_->enable_ktls(enable);
+}
+
+TransportStats WebSocketTradingClient::get_transport_stats() const {
+    return connection_->transport_stats();
+}
+
 bool WebSocketTradingClient::connect(const std::string& url) {
     if (connected_) {
         return true;
     }
 
-    try {
-        websocketpp::lib::error_code ec;
-        auto con = ws_client_->get_connection(url, ec);
-
-        if (ec) {
-            std::cerr << "Connection initialization error: " << ec.message() << std::endl;
-            return false;
-        }
-
-        connection_hdl_ = con->get_handle();
-        ws_client_->connect(con);
-
-        // Start the event loop
-        running_ = true;
-        ws_thread_ = std::thread(&WebSocketTradingClient::run_event_loop, this);
+    if (!connection_->connect(url)) {
+        std::cerr << "WebSocket Trading connection failed" << std::endl;
+        return false;
+    }
 
-        // Wait for connection with longer timeout
-        auto start = std::chrono::steady_clock::now();
-        while (!connected_ &&
-               std::chrono::steady_clock::now() - start < std::chrono::seconds(2)) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        }
+    std::cout << "[WS Trading] Socket: " << connection_->socket_report().to_string() << std::endl;
+    std::cout << "WebSocket Trading connection opened" << std::endl;
 
-        if (!connected_) {
-            std::cerr << "Connection timeout after 15 seconds" << std::endl;
-            disconnect();
-            return false;
-        }
+    running_ = true;
+    connected_ = true;
 
-        // Start reconnect thread if auto-reconnect is enabled
-        if (auto_reconnect_) {
-            reconnect_thread_ = std::thread(&WebSocketTradingClient::handle_reconnect, this);
-        }
+    // Start the reader before anyone can send, so no response is missed
+    reader_thread_ = std::thread(&WebSocketTradingClient::run_reader, this);
 
-        return true;
+    if (connection_handler_) {
+        connection_handler_(true);
+    }
 
-    } catch (const std::exception& e) {
-        std::cerr << "Connection error: " << e.what() << std::endl;
-        return false;
+    // Start reconnect thread if auto-reconnect is enabled
+    if (auto_reconnect_) {
+        reconnect_thread_ = std::thread(&WebSocketTradingClient::handle_reconnect, this);
     }
+
+    return true;
 }
 
 void WebSocketTradingClient::disconnect() {
@@ -137,37 +94,14 @@ void WebSocketTradingClient::disconnect() {
     std::cout << "[WS Trading] Disconnecting..." << std::endl;
 
     running_ = false;
-    auto was_connected = connected_.load();
     connected_ = false;
 
-    // Close WebSocket connection gracefully
-    if (ws_client_ && was_connected) {
-        try {
-            websocketpp::lib::error_code ec;
-            ws_client_->close(connection_hdl_, websocketpp::close::status::going_away, "Client disconnect", ec);
-            if (ec) {
-                std::cerr << "[WS Trading] Close error: " << ec.message() << std::endl;
-            }
-            // Give time for close handshake
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-        } catch (const std::exception& e) {
-            std::cerr << "[WS Trading] Exception during close: " << e.what() << std::endl;
-        }
-    }
+    // Close frame (1001 going away) and socket shutdown; wakes up the reader
+    connection_->close(1001);
 
-    // Stop the client
-    if (ws_client_) {
-        try {
-            ws_client_->stop();
-        } catch (const std::exception& e) {
-            std::cerr << "[WS Trading] Exception during stop: " << e.what() << std::endl;
-        }
-    }
-
-    // Wait for threads with timeout
-    if (ws_thread_.joinable()) {
-        std::cout << "[WS Trading] Waiting for event loop thread..." << std::endl;
-        ws_thread_.join();
+    if (reader_thread_.joinable()) {
+        std::cout << "[WS Trading] Waiting for reader thread..." << std::endl;
+        reader_thread_.join();
     }
 
     if (reconnect_thread_.joinable()) {
@@ -180,9 +114,17 @@ void WebSocketTradingClient::disconnect() {
         std::lock_guard<std::mutex> lock(requests_mutex_);
         for (auto& [id, request] : pending_requests_) {
             if (request && request->waiting) {
-                Json::Value error;
-                error["error"] = "Connection closed";
-                request->promise.set_value(error);
+                if (request->fast_path) {
+                    WsApiAck ack;
+                    ack.request_id = id;
+                    ack.has_error = true;
+                    std::strncpy(ack.error_msg, "Connection closed", sizeof(ack.error_msg) - 1);
+                    request->ack_promise.set_value(ack);
+                } else {
+                    Json::Value error;
+                    error["error"] = "Connection closed";
+                    request->promise.set_value(error);
+                }
             }
         }
         pending_requests_.clear();
@@ -191,11 +133,20 @@ void WebSocketTradingClient::disconnect() {
     std::cout << "[WS Trading] Disconnected cleanly" << std::endl;
 }
 
-void WebSocketTradingClient::run_event_loop() {
-    try {
-        ws_client_->run();
-    } catch (const std::exception& e) {
-        std::cerr << "Event loop error: " << e.what() << std::endl;
+void WebSocketTradingClient::run_reader() {
+    auto on_message = [this](std::string_view message) { process_message(message); };
+
+    while (running_) {
+        auto status = connection_->wait_and_read(std::chrono::milliseconds(100), on_message);
+
+        if (status == WsConnection::ReadStatus::OK || status == WsConnection::ReadStatus::TIMEOUT) {
+            continue;
+        }
+
+        if (running_) {
+            on_close();
+        }
+        break;
     }
 }
 
@@ -221,16 +172,7 @@ void WebSocketTradingClient::handle_reconnect() {
     }
 }
 
-void WebSocketTradingClient::on_open([[maybe_unused]] websocketpp::connection_hdl hdl) {
-    std::cout << "WebSocket Trading connection opened" << std::endl;
-    connected_ = true;
-
-    if (connection_handler_) {
-        connection_handler_(true);
-    }
-}
-
-void WebSocketTradingClient::on_close([[maybe_unused]] websocketpp::connection_hdl hdl) {
+void WebSocketTradingClient::on_close() {
     std::cout << "WebSocket Trading connection closed" << std::endl;
     connected_ = false;
 
@@ -239,58 +181,101 @@ void WebSocketTradingClient::on_close([[maybe_unused]] websocketpp::connection_h
     }
 }
 
-void WebSocketTradingClient::on_fail([[maybe_unused]] websocketpp::connection_hdl hdl) {
-    std::cerr << "WebSocket Trading connection failed" << std::endl;
-    connected_ = false;
+void WebSocketTradingClient::process_message(std::string_view message) {
+    // Fast path: order acks are scanned straight into a WsApiAck
+    WsApiAck ack;
+    if (WsApiResponseScanner::scan(message, ack)) {
+        std::shared_ptr<PendingRequest> request;
+        {
+            std::lock_guard<std::mutex> lock(requests_mutex_);
+            auto it = pending_requests_.find(ack.request_id);
+            if (it != pending_requests_.end() && it->second->fast_path) {
+                request = it->second;
+                pending_requests_.erase(it);
+
+                if (request->waiting) {
+                    request->ack_promise.set_value(ack);
+                    request->waiting = false;
+                }
+            }
+        }
 
-    if (connection_handler_) {
-        connection_handler_(false);
-    }
-}
+        if (request) {
+            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - request->sent_time
+            );
+            metrics_.update_response_time(duration.count());
+            record_rate_limits(ack);
+            handle_ack(ack, *request);
 
-void WebSocketTradingClient::on_message([[maybe_unused]] websocketpp::connection_hdl hdl, WsMessagePtr msg) {
-    process_message(msg->get_payload());
-}
+            if (ack_handler_) {
+                ack_handler_(ack);
+            }
+            return;
+        }
+    }
 
-void WebSocketTradingClient::process_message(const std::string& message) {
+    // Slow path: everything else through JsonCpp
     Json::Reader reader;
     Json::Value response;
 
-    if (!reader.parse(message, response)) {
+    if (!reader.parse(message.data(), message.data() + message.size(), response)) {
         std::cerr << "Failed to parse WebSocket message: " << message << std::endl;
         return;
     }
 
     // Check if this is a response to a request
-    if (response.isMember("id")) {
-        std::string request_id = response["id"].asString();
+    if (response.isMember("id") && response["id"].isIntegral()) {
+        uint64_t request_id = response["id"].asUInt64();
 
-        std::lock_guard<std::mutex> lock(requests_mutex_);
-        auto it = pending_requests_.find(request_id);
-        if (it != pending_requests_.end()) {
-            auto request = it->second;
-
-            // Calculate response time
-            auto now = std::chrono::steady_clock::now();
-            auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
-                now - request->sent_time
-            );
-            metrics_.update_response_time(duration.count());
-
-            // Set the promise value
-            if (request->waiting) {
-                request->promise.set_value(response);
-                request->waiting = false;
+        std::shared_ptr<PendingRequest> fast_request;
+        WsApiAck ack;
+        {
+            std::lock_guard<std::mutex> lock(requests_mutex_);
+            auto it = pending_requests_.find(request_id);
+            if (it != pending_requests_.end()) {
+                auto request = it->second;
+
+                // Calculate response time
+                auto now = std::chrono::steady_clock::now();
+                auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    now - request->sent_time
+                );
+                metrics_.update_response_time(duration.count());
+
+                if (request->fast_path) {
+                    // An ack scan() gave up on: its caller still waits on a WsApiAck
+                    WsApiResponseScanner::from_json(response, ack);
+                    if (request->waiting) {
+                        request->ack_promise.set_value(ack);
+                        request->waiting = false;
+                    }
+                    fast_request = request;
+                } else {
+                    // Set the promise value
+                    if (request->waiting) {
+                        request->promise.set_value(response);
+                        request->waiting = false;
+                    }
+
+                    // Handle the response
+                    if (response.isMember("result")) {
+                        handle_order_response(response);
+                    } else if (response.isMember("error")) {
+                        handle_error_response(response, *request);
+                    }
+                }
+
+                pending_requests_.erase(it);
             }
+        }
 
-            // Handle the response
-            if (response.isMember("result")) {
-                handle_order_response(response);
-            } else if (response.isMember("error")) {
-                handle_error_response(response);
+        if (fast_request) {
+            record_rate_limits(ack);
+            handle_ack(ack, *fast_request);
+            if (ack_handler_) {
+                ack_handler_(ack);
             }
-
-            pending_requests_.erase(it);
         }
     }
 
@@ -325,7 +310,7 @@ void WebSocketTradingClient::handle_order_response(const Json::Value& response)
     }
 }
 
-void WebSocketTradingClient::handle_error_response(const Json::Value& response) {
+void WebSocketTradingClient::handle_error_response(const Json::Value& response, const PendingRequest& request) {
     if (!response.isMember("error")) {
         return;
     }
@@ -336,13 +321,73 @@ void WebSocketTradingClient::handle_error_response(const Json::Value& response)
     std::cerr << "WebSocket API Error - Code: " << error["code"].asInt()
               << ", Message: " << error["msg"].asString() << std::endl;
 
+    OrderError order_error;
+    order_error.symbol = request.symbol;
+    order_error.has_side = request.has_side;
+    order_error.side = request.side;
+    order_error.code = error["code"].asInt();
+    order_error.message = error["msg"].asString();
+    if (error.isMember("data") && error["data"].isMember("retryAfter")) {
+        order_error.retry_after_ms = error["data"]["retryAfter"].asInt64();
+    }
+    order_error.transport = "WS";
+    OrderErrorTracker::instance().record(order_error);
+
     if (error_handler_) {
         error_handler_(error["msg"].asString());
     }
 }
 
-std::string WebSocketTradingClient::generate_request_id() {
-    return "req_" + std::to_string(request_id_counter_++);
+void WebSocketTradingClient::handle_ack(const WsApiAck& ack, const PendingRequest& request) {
+    if (ack.has_error) {
+        metrics_.failed_orders++;
+
+        std::cerr << "WebSocket API Error - Code: " << ack.error_code
+                  << ", Message: " << ack.error_msg << std::endl;
+
+        OrderError order_error;
+        order_error.symbol = request.symbol;
+        order_error.has_side = request.has_side;
+        order_error.side = request.side;
+        order_error.code = ack.error_code;
+        order_error.message = ack.error_msg;
+        order_error.retry_after_ms = ack.retry_after_ms;
+        order_error.transport = "WS";
+        OrderErrorTracker::instance().record(order_error);
+
+        if (error_handler_) {
+            error_handler_(ack.error_msg);
+        }
+        return;
+    }
+
+    if (ack.has_order_status && ack.order_status == OrderStatus::CANCELED && ack.cancelled_order_id == 0) {
+        metrics_.cancelled_orders++;
+        std::cout << "Order cancelled successfully" << std::endl;
+    } else if (ack.order_id != 0) {
+        metrics_.successful_orders++;
+        std::cout << "Order successful - ID: " << ack.order_id << std::endl;
+    }
+}
+
+void WebSocketTradingClient::record_rate_limits(const WsApiAck& ack) {
+    if (ack.rate_limit_count == 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(rate_limits_mutex_);
+    std::copy(ack.rate_limits, ack.rate_limits + ack.rate_limit_count, rate_limits_);
+    rate_limit_count_ = ack.rate_limit_count;
+}
+
+std::vector<WsApiRateLimit> WebSocketTradingClient::get_rate_limits() const {
+    std::lock_guard<std::mutex> lock(rate_limits_mutex_);
+    return std::vector<WsApiRateLimit>(rate_limits_, rate_limits_ + rate_limit_count_);
+}
+
+uint64_t WebSocketTradingClient::generate_request_id() {
+    // Numeric ids: the scanner reads them without allocating
+    return request_id_counter_++;
 }
 
 std::string WebSocketTradingClient::generate_signature(const std::string& query_string) {
@@ -361,9 +406,7 @@ std::string WebSocketTradingClient::generate_signature(const std::string& query_
 }
 
 int64_t WebSocketTradingClient::get_timestamp() {
-    auto now = std::chrono::system_clock::now();
-    auto duration = now.time_since_epoch();
-    return std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
+    return ExchangeClock::instance().now_ms();
 }
 
 Json::Value WebSocketTradingClient::create_signed_request(
@@ -371,7 +414,7 @@ Json::Value WebSocketTradingClient::create_signed_request(
     const Json::Value& params) {
 
     Json::Value request;
-    request["id"] = generate_request_id();
+    request["id"] = Json::UInt64(generate_request_id());
     request["method"] = method;
 
     // Create a copy of params and add authentication
@@ -397,25 +440,51 @@ Json::Value WebSocketTradingClient::create_signed_request(
     return request;
 }
 
-std::optional<Json::Value> WebSocketTradingClient::send_request_and_wait(
+Json::Value WebSocketTradingClient::create_unsigned_request(
     const std::string& method,
-    const Json::Value& params,
-    std::chrono::milliseconds timeout) {
+    const Json::Value& params) {
 
-    if (!connected_) {
-        std::cerr << "Not connected to WebSocket" << std::endl;
-        return std::nullopt;
+    Json::Value request;
+    request["id"] = Json::UInt64(generate_request_id());
+    request["method"] = method;
+    if (!params.isNull()) {
+        request["params"] = params;
     }
+    return request;
+}
 
-    Json::Value request = create_signed_request(method, params);
-    std::string request_id = request["id"].asString();
+bool WebSocketTradingClient::requires_signature(const std::string& method) {
+    // Public queries and listenKey management are rejected if they carry a signature
+    return method != "ping" && method != "time" && method != "exchangeInfo" &&
+           method.compare(0, 15, "userDataStream.") != 0;
+}
+
+std::shared_ptr<WebSocketTradingClient::PendingRequest> WebSocketTradingClient::send_tracked_request(
+    const std::string& method,
+    const Json::Value& params,
+    bool waiting) {
+
+    Json::Value request = requires_signature(method)
+        ? create_signed_request(method, params)
+        : create_unsigned_request(method, params);
+    uint64_t request_id = request["id"].asUInt64();
 
     // Create pending request
     auto pending = std::make_shared<PendingRequest>();
+    pending->id = request_id;
     pending->method = method;
+    pending->fast_path = WsApiResponseScanner::is_fast_method(method);
+    if (params.isMember("symbol")) {
+        pending->symbol = params["symbol"].asString();
+    }
+    if (params.isMember("side")) {
+        pending->has_side = true;
+        pending->side = params["side"].asString() == "BUY" ? OrderSide::BUY : OrderSide::SELL;
+    }
+    pending->waiting = waiting;
     pending->sent_time = std::chrono::steady_clock::now();
 
-    // Store the pending request
+    // Store the pending request before sending, the response may beat us back
     {
         std::lock_guard<std::mutex> lock(requests_mutex_);
         pending_requests_[request_id] = pending;
@@ -425,11 +494,8 @@ std::optional<Json::Value> WebSocketTradingClient::send_request_and_wait(
     Json::FastWriter writer;
     std::string message = writer.write(request);
 
-    websocketpp::lib::error_code ec;
-    ws_client_->send(connection_hdl_, message, websocketpp::frame::opcode::text, ec);
-
-    if (ec) {
-        std::cerr << "Failed to send WebSocket message: " << ec.message() << std::endl;
+    if (!connection_->send_text(message)) {
+        std::cerr << "Failed to send WebSocket message for method: " << method << std::endl;
 
         // Remove pending request
         {
@@ -437,6 +503,24 @@ std::optional<Json::Value> WebSocketTradingClient::send_request_and_wait(
             pending_requests_.erase(request_id);
         }
 
+        return nullptr;
+    }
+
+    return pending;
+}
+
+std::optional<Json::Value> WebSocketTradingClient::send_request_and_wait(
+    const std::string& method,
+    const Json::Value& params,
+    std::chrono::milliseconds timeout) {
+
+    if (!connected_) {
+        std::cerr << "Not connected to WebSocket" << std::endl;
+        return std::nullopt;
+    }
+
+    auto pending = send_tracked_request(method, params, true);
+    if (!pending) {
         return std::nullopt;
     }
 
@@ -449,7 +533,38 @@ std::optional<Json::Value> WebSocketTradingClient::send_request_and_wait(
         {
             std::lock_guard<std::mutex> lock(requests_mutex_);
             pending->waiting = false;
-            pending_requests_.erase(request_id);
+            pending_requests_.erase(pending->id);
+        }
+
+        return std::nullopt;
+    }
+
+    return future.get();
+}
+
+std::optional<WsApiAck> WebSocketTradingClient::send_ack_request_and_wait(
+    const std::string& method,
+    const Json::Value& params,
+    std::chrono::milliseconds timeout) {
+
+    if (!connected_) {
+        std::cerr << "Not connected to WebSocket" << std::endl;
+        return std::nullopt;
+    }
+
+    auto pending = send_tracked_request(method, params, true);
+    if (!pending) {
+        return std::nullopt;
+    }
+
+    auto future = pending->ack_promise.get_future();
+    if (future.wait_for(timeout) == std::future_status::timeout) {
+        std::cerr << "Request timeout for method: " << method << std::endl;
+
+        {
+            std::lock_guard<std::mutex> lock(requests_mutex_);
+            pending->waiting = false;
+            pending_requests_.erase(pending->id);
         }
 
         return std::nullopt;
@@ -472,22 +587,11 @@ void WebSocketTradingClient::send_request_async(
         return;
     }
 
-    Json::Value request = create_signed_request(method, params);
-
-    // Send the request without waiting
-    Json::FastWriter writer;
-    std::string message = writer.write(request);
-
-    websocketpp::lib::error_code ec;
-    ws_client_->send(connection_hdl_, message, websocketpp::frame::opcode::text, ec);
-
-    if (ec) {
-        std::cerr << "Failed to send async WebSocket message: " << ec.message() << std::endl;
-        if (callback) {
-            Json::Value error;
-            error["error"] = ec.message();
-            callback(error);
-        }
+    // Tracked without a waiter so the response still feeds metrics and handlers
+    if (!send_tracked_request(method, params, false) && callback) {
+        Json::Value error;
+        error["error"] = "Send failed";
+        callback(error);
     }
 }
 
@@ -497,13 +601,19 @@ std::optional<std::string> WebSocketTradingClient::place_limit_order(
     double price,
     double quantity,
     const std::string& client_order_id,
-    bool wait_for_response) {
+    bool wait_for_response,
+    bool post_only,
+    OrderResponseType response_type) {
 
     Json::Value params;
     params["symbol"] = symbol;
     params["side"] = (side == OrderSide::BUY) ? "BUY" : "SELL";
-    params["type"] = "LIMIT";
-    params["timeInForce"] = "GTC";
+    if (post_only) {
+        params["type"] = "LIMIT_MAKER";  // No timeInForce
+    } else {
+        params["type"] = "LIMIT";
+        params["timeInForce"] = "GTC";
+    }
     params["price"] = format_price(price);
     params["quantity"] = format_quantity(quantity);
 
@@ -511,23 +621,24 @@ std::optional<std::string> WebSocketTradingClient::place_limit_order(
         params["newClientOrderId"] = client_order_id;
     }
 
+    switch (response_type) {
+        case OrderResponseType::ACK: params["newOrderRespType"] = "ACK"; break;
+        case OrderResponseType::RESULT: params["newOrderRespType"] = "RESULT"; break;
+        case OrderResponseType::FULL: params["newOrderRespType"] = "FULL"; break;
+    }
+
     if (!wait_for_response) {
         send_request_async("order.place", params);
         return "async_request_sent";
     }
 
-    auto response = send_request_and_wait("order.place", params);
+    auto ack = send_ack_request_and_wait("order.place", params);
 
-    if (!response || !response->isMember("result")) {
+    if (!ack || !ack->ok() || ack->order_id == 0) {
         return std::nullopt;
     }
 
-    const Json::Value& result = (*response)["result"];
-    if (result.isMember("orderId")) {
-        return result["orderId"].asString();
-    }
-
-    return std::nullopt;
+    return std::to_string(ack->order_id);
 }
 
 std::optional<bool> WebSocketTradingClient::cancel_order(
@@ -544,14 +655,13 @@ std::optional<bool> WebSocketTradingClient::cancel_order(
         return true;
     }
 
-    auto response = send_request_and_wait("order.cancel", params);
+    auto ack = send_ack_request_and_wait("order.cancel", params);
 
-    if (!response || !response->isMember("result")) {
+    if (!ack || !ack->ok()) {
         return false;
     }
 
-    const Json::Value& result = (*response)["result"];
-    return result.isMember("status") && result["status"].asString() == "CANCELED";
+    return ack->has_order_status && ack->order_status == OrderStatus::CANCELED;
 }
 
 std::optional<bool> WebSocketTradingClient::cancel_all_orders(
@@ -615,6 +725,82 @@ std::optional<Json::Value> WebSocketTradingClient::get_open_orders(
     return (*response)["result"];
 }
 
+std::optional<std::string> WebSocketTradingClient::start_user_data_stream() {
+    Json::Value params;
+    params["apiKey"] = api_key_;
+
+    auto response = send_request_and_wait("userDataStream.start", params);
+
+    if (!response || !(*response)["result"].isMember("listenKey")) {
+        return std::nullopt;
+    }
+
+    return (*response)["result"]["listenKey"].asString();
+}
+
+bool WebSocketTradingClient::ping_user_data_stream(const std::string& listen_key) {
+    Json::Value params;
+    params["apiKey"] = api_key_;
+    params["listenKey"] = listen_key;
+
+    auto response = send_request_and_wait("userDataStream.ping", params);
+    return response && response->isMember("result");
+}
+
+std::optional<int64_t> WebSocketTradingClient::get_server_time() {
+    auto response = send_request_and_wait("time", Json::Value());
+
+    if (!response || !(*response)["result"].isMember("serverTime")) {
+        return std::nullopt;
+    }
+
+    return (*response)["result"]["serverTime"].asInt64();
+}
+
+std::optional<int64_t> WebSocketTradingClient::ping() {
+    auto start = std::chrono::steady_clock::now();
+    auto response = send_request_and_wait("ping", Json::Value());
+    if (!response || !response->isMember("result")) {
+        return std::nullopt;
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+std::optional<int64_t> WebSocketTradingClient::test_order(const std::string& symbol, OrderSide side, double price,
+                                                          double quantity, bool post_only) {
+    Json::Value params;
+    params["symbol"] = symbol;
+    params["side"] = (side == OrderSide::BUY) ? "BUY" : "SELL";
+    if (post_only) {
+        params["type"] = "LIMIT_MAKER";
+    } else {
+        params["type"] = "LIMIT";
+        params["timeInForce"] = "GTC";
+    }
+    params["price"] = format_price(price);
+    params["quantity"] = format_quantity(quantity);
+
+    auto start = std::chrono::steady_clock::now();
+    auto response = send_request_and_wait("order.test", params);
+    if (!response || !response->isMember("result")) {
+        return std::nullopt;
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+std::optional<Json::Value> WebSocketTradingClient::get_exchange_info(const std::string& symbol) {
+    Json::Value params;
+    params["symbol"] = symbol;
+
+    auto response = send_request_and_wait("exchangeInfo", params);
+
+    if (!response || !response->isMember("result")) {
+        return std::nullopt;
+    }
+
+    return (*response)["result"];
+}
+
 void WebSocketTradingClient::place_orders_batch(
     const std::vector<std::tuple<std::string, OrderSide, double, double>>& orders,
     [[maybe_unused]] OrderResponseHandler handler) {
@@ -0,0 +1,395 @@
+#include "ws_api_response.h"
+#include <json/json.h>
+#include <cstring>
+
+namespace MarketMaker {
+
+namespace {
+
+// Minimal JSON cursor: just enough to walk objects/arrays, read integers and
+// raw (still escaped) string contents, and skip values we don't care about.
+class Cursor {
+public:
+    explicit Cursor(std::string_view text) : p_(text.data()), end_(text.data() + text.size()) {}
+
+    void skip_ws() {
+        while (p_ < end_ && (*p_ == ' ' || *p_ == '\n' || *p_ == '\r' || *p_ == '\t')) {
+            ++p_;
+        }
+    }
+
+    bool consume(char c) {
+        skip_ws();
+        if (p_ < end_ && *p_ == c) {
+            ++p_;
+            return true;
+        }
+        return false;
+    }
+
+    bool peek(char c) {
+        skip_ws();
+        return p_ < end_ && *p_ == c;
+    }
+
+    // Raw string contents without the quotes; escapes are kept as-is
+    bool read_string(std::string_view& out) {
+        if (!consume('"')) return false;
+        const char* start = p_;
+        while (p_ < end_ && *p_ != '"') {
+            if (*p_ == '\\') {
+                ++p_;
+                if (p_ >= end_) return false;
+            }
+            ++p_;
+        }
+        if (p_ >= end_) return false;
+        out = std::string_view(start, p_ - start);
+        ++p_;
+        return true;
+    }
+
+    // Integer value; a quoted integer ("123") is accepted as well
+    bool read_int(int64_t& out) {
+        skip_ws();
+        bool quoted = consume('"');
+        bool negative = false;
+        if (p_ < end_ && *p_ == '-') {
+            negative = true;
+            ++p_;
+        }
+        if (p_ >= end_ || *p_ < '0' || *p_ > '9') return false;
+
+        int64_t value = 0;
+        while (p_ < end_ && *p_ >= '0' && *p_ <= '9') {
+            value = value * 10 + (*p_ - '0');
+            ++p_;
+        }
+        if (quoted && !consume('"')) return false;
+        out = negative ? -value : value;
+        return true;
+    }
+
+    bool skip_value() {
+        skip_ws();
+        if (p_ >= end_) return false;
+
+        switch (*p_) {
+            case '"': {
+                std::string_view ignored;
+                return read_string(ignored);
+            }
+            case '{':
+            case '[': {
+                // Walk to the matching bracket, stepping over strings
+                int depth = 0;
+                while (p_ < end_) {
+                    char c = *p_;
+                    if (c == '"') {
+                        std::string_view ignored;
+                        if (!read_string(ignored)) return false;
+                        continue;
+                    }
+                    if (c == '{' || c == '[') {
+                        ++depth;
+                    } else if (c == '}' || c == ']') {
+                        if (--depth == 0) {
+                            ++p_;
+                            return true;
+                        }
+                    }
+                    ++p_;
+                }
+                return false;
+            }
+            default:
+                // Number, true, false, null
+                while (p_ < end_ && *p_ != ',' && *p_ != '}' && *p_ != ']') {
+                    ++p_;
+                }
+                return true;
+        }
+    }
+
+    // Iterate the members of an object: on_member(key) must consume the value
+    template <typename F>
+    bool for_each_member(F&& on_member) {
+        if (!consume('{')) return false;
+        if (consume('}')) return true;
+        do {
+            std::string_view key;
+            if (!read_string(key) || !consume(':')) return false;
+            if (!on_member(key)) return false;
+        } while (consume(','));
+        return consume('}');
+    }
+
+    // Iterate the elements of an array: on_element() must consume the value
+    template <typename F>
+    bool for_each_element(F&& on_element) {
+        if (!consume('[')) return false;
+        if (consume(']')) return true;
+        do {
+            if (!on_element()) return false;
+        } while (consume(','));
+        return consume(']');
+    }
+
+private:
+    const char* p_;
+    const char* end_;
+};
+
+template <size_t N>
+void copy_truncated(char (&dest)[N], std::string_view source) {
+    size_t length = source.size() < N - 1 ? source.size() : N - 1;
+    memcpy(dest, source.data(), length);
+    dest[length] = '\0';
+}
+
+bool parse_order_status(std::string_view text, OrderStatus& status) {
+    if (text == "NEW") status = OrderStatus::NEW;
+    else if (text == "PARTIALLY_FILLED") status = OrderStatus::PARTIALLY_FILLED;
+    else if (text == "FILLED") status = OrderStatus::FILLED;
+    else if (text == "CANCELED") status = OrderStatus::CANCELED;
+    else if (text == "REJECTED") status = OrderStatus::REJECTED;
+    else if (text == "EXPIRED" || text == "EXPIRED_IN_MATCH") status = OrderStatus::EXPIRED;
+    else return false;
+    return true;
+}
+
+WsApiRateLimit::Type parse_rate_limit_type(std::string_view text) {
+    if (text == "REQUEST_WEIGHT") return WsApiRateLimit::Type::REQUEST_WEIGHT;
+    if (text == "ORDERS") return WsApiRateLimit::Type::ORDERS;
+    if (text == "RAW_REQUESTS") return WsApiRateLimit::Type::RAW_REQUESTS;
+    return WsApiRateLimit::Type::UNKNOWN;
+}
+
+WsApiRateLimit::Interval parse_interval(std::string_view text) {
+    if (text == "SECOND") return WsApiRateLimit::Interval::SECOND;
+    if (text == "MINUTE") return WsApiRateLimit::Interval::MINUTE;
+    if (text == "HOUR") return WsApiRateLimit::Interval::HOUR;
+    if (text == "DAY") return WsApiRateLimit::Interval::DAY;
+    return WsApiRateLimit::Interval::UNKNOWN;
+}
+
+// Order fields shared by order.place/order.cancel results and the nested
+// cancelResponse/newOrderResponse objects of order.cancelReplace
+bool scan_order(Cursor& cursor, WsApiAck& ack, int64_t& order_id) {
+    return cursor.for_each_member([&](std::string_view key) {
+        if (key == "orderId") {
+            return cursor.read_int(order_id);
+        }
+        if (key == "clientOrderId") {
+            std::string_view value;
+            if (!cursor.read_string(value)) return false;
+            copy_truncated(ack.client_order_id, value);
+            return true;
+        }
+        if (key == "status") {
+            std::string_view value;
+            if (!cursor.read_string(value)) return false;
+            ack.has_order_status = parse_order_status(value, ack.order_status);
+            return true;
+        }
+        return cursor.skip_value();
+    });
+}
+
+bool scan_result(Cursor& cursor, WsApiAck& ack) {
+    if (!cursor.peek('{')) {
+        return false;  // Array results (openOrders etc.) are not acks
+    }
+    ack.has_result = true;
+
+    return cursor.for_each_member([&](std::string_view key) {
+        if (key == "orderId") {
+            return cursor.read_int(ack.order_id);
+        }
+        if (key == "clientOrderId") {
+            std::string_view value;
+            if (!cursor.read_string(value)) return false;
+            copy_truncated(ack.client_order_id, value);
+            return true;
+        }
+        if (key == "status") {
+            std::string_view value;
+            if (!cursor.read_string(value)) return false;
+            ack.has_order_status = parse_order_status(value, ack.order_status);
+            return true;
+        }
+        if (key == "cancelResponse") {
+            // Status/clientOrderId of the new order win: it is scanned last
+            return scan_order(cursor, ack, ack.cancelled_order_id);
+        }
+        if (key == "newOrderResponse") {
+            return scan_order(cursor, ack, ack.order_id);
+        }
+        return cursor.skip_value();
+    });
+}
+
+bool scan_error(Cursor& cursor, WsApiAck& ack) {
+    ack.has_error = true;
+
+    return cursor.for_each_member([&](std::string_view key) {
+        if (key == "code") {
+            int64_t code = 0;
+            if (!cursor.read_int(code)) return false;
+            ack.error_code = static_cast<int>(code);
+            return true;
+        }
+        if (key == "msg") {
+            std::string_view value;
+            if (!cursor.read_string(value)) return false;
+            copy_truncated(ack.error_msg, value);
+            return true;
+        }
+        if (key == "data" && cursor.peek('{')) {
+            return cursor.for_each_member([&](std::string_view data_key) {
+                if (data_key == "retryAfter") {
+                    return cursor.read_int(ack.retry_after_ms);
+                }
+                return cursor.skip_value();
+            });
+        }
+        return cursor.skip_value();
+    });
+}
+
+bool scan_rate_limits(Cursor& cursor, WsApiAck& ack) {
+    return cursor.for_each_element([&]() {
+        WsApiRateLimit limit;
+        bool ok = cursor.for_each_member([&](std::string_view key) {
+            std::string_view text;
+            int64_t number = 0;
+            if (key == "rateLimitType") {
+                if (!cursor.read_string(text)) return false;
+                limit.type = parse_rate_limit_type(text);
+            } else if (key == "interval") {
+                if (!cursor.read_string(text)) return false;
+                limit.interval = parse_interval(text);
+            } else if (key == "intervalNum") {
+                if (!cursor.read_int(number)) return false;
+                limit.interval_num = static_cast<int>(number);
+            } else if (key == "limit") {
+                if (!cursor.read_int(number)) return false;
+                limit.limit = static_cast<int>(number);
+            } else if (key == "count") {
+                if (!cursor.read_int(number)) return false;
+                limit.count = static_cast<int>(number);
+            } else {
+                return cursor.skip_value();
+            }
+            return true;
+        });
+
+        if (ok && ack.rate_limit_count < WsApiAck::MAX_RATE_LIMITS) {
+            ack.rate_limits[ack.rate_limit_count++] = limit;
+        }
+        return ok;
+    });
+}
+
+void order_from_json(const Json::Value& order, WsApiAck& ack, int64_t& order_id) {
+    if (order.isMember("orderId")) {
+        order_id = order["orderId"].asInt64();
+    }
+    if (order.isMember("clientOrderId")) {
+        copy_truncated(ack.client_order_id, order["clientOrderId"].asString());
+    }
+    if (order.isMember("status")) {
+        ack.has_order_status = parse_order_status(order["status"].asString(), ack.order_status);
+    }
+}
+
+} // namespace
+
+bool WsApiResponseScanner::from_json(const Json::Value& response, WsApiAck& ack) {
+    if (!response.isObject()) {
+        return false;
+    }
+
+    const Json::Value& id = response["id"];
+    if (id.isIntegral()) {
+        ack.request_id = id.asUInt64();
+        ack.has_id = true;
+    }
+    if (response["status"].isIntegral()) {
+        ack.status = response["status"].asInt();
+    }
+
+    const Json::Value& result = response["result"];
+    if (result.isObject()) {
+        ack.has_result = true;
+        order_from_json(result, ack, ack.order_id);
+        // Status/clientOrderId of the new order win, as in scan()
+        if (result.isMember("cancelResponse")) {
+            order_from_json(result["cancelResponse"], ack, ack.cancelled_order_id);
+        }
+        if (result.isMember("newOrderResponse")) {
+            order_from_json(result["newOrderResponse"], ack, ack.order_id);
+        }
+    }
+
+    const Json::Value& error = response["error"];
+    if (error.isObject()) {
+        ack.has_error = true;
+        ack.error_code = error["code"].asInt();
+        copy_truncated(ack.error_msg, error["msg"].asString());
+        if (error["data"].isObject() && error["data"]["retryAfter"].isIntegral()) {
+            ack.retry_after_ms = error["data"]["retryAfter"].asInt64();
+        }
+    }
+
+    for (const auto& entry : response["rateLimits"]) {
+        if (ack.rate_limit_count >= WsApiAck::MAX_RATE_LIMITS || !entry.isObject()) {
+            break;
+        }
+        WsApiRateLimit& limit = ack.rate_limits[ack.rate_limit_count++];
+        limit.type = parse_rate_limit_type(entry["rateLimitType"].asString());
+        limit.interval = parse_interval(entry["interval"].asString());
+        limit.interval_num = entry["intervalNum"].asInt();
+        limit.limit = entry["limit"].asInt();
+        limit.count = entry["count"].asInt();
+    }
+
+    return ack.has_id && (ack.has_result || ack.has_error);
+}
+
+bool WsApiResponseScanner::scan(std::string_view message, WsApiAck& ack) {
+    Cursor cursor(message);
+
+    bool ok = cursor.for_each_member([&](std::string_view key) {
+        if (key == "id") {
+            int64_t id = 0;
+            if (cursor.peek('n')) {
+                return cursor.skip_value();  // "id": null on unparseable requests
+            }
+            if (!cursor.read_int(id)) return false;
+            ack.request_id = static_cast<uint64_t>(id);
+            ack.has_id = true;
+            return true;
+        }
+        if (key == "status") {
+            int64_t status = 0;
+            if (!cursor.read_int(status)) return false;
+            ack.status = static_cast<int>(status);
+            return true;
+        }
+        if (key == "result") {
+            return scan_result(cursor, ack);
+        }
+        if (key == "error") {
+            return scan_error(cursor, ack);
+        }
+        if (key == "rateLimits") {
+            return scan_rate_limits(cursor, ack);
+        }
+        return cursor.skip_value();
+    });
+
+    return ok && ack.has_id && (ack.has_result || ack.has_error);
+}
+
+} // namespace MarketMaker
@@ -0,0 +1,657 @@
+#include "ws_connection.h"
+#include <iostream>
+#include <sstream>
+#include <random>
+#include <cstring>
+#include <cerrno>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <openssl/ssl.h>
+#include <openssl/err.h>
+#include <openssl/bio.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#include <openssl/sha.h>
+
+namespace MarketMaker {
+
+namespace {
+
+constexpr size_t INITIAL_RECV_BUFFER = 1 << 20;   // 1 MB, grows for large responses
+constexpr size_t INITIAL_SEND_BUFFER = 64 * 1024;
+constexpr size_t MIN_READ_SPACE = 16 * 1024;
+constexpr size_t MAX_UPGRADE_RESPONSE = 16 * 1024;
+constexpr const char* WS_GUID = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+std::string base64_encode(const unsigned char* data, size_t length) {
+    std::string out(4 * ((length + 2) / 3), '\0');
+    int written = EVP_EncodeBlock(reinterpret_cast<unsigned char*>(&out[0]), data, static_cast<int>(length));
+    out.resize(written);
+    return out;
+}
+
+int64_t steady_now_ns() {
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+} // namespace
+
+WsConnection::WsConnection()
+    : recv_buffer_(INITIAL_RECV_BUFFER) {
+    send_buffer_.resize(INITIAL_SEND_BUFFER);
+    fragment_buffer_.reserve(64 * 1024);
+
+    std::random_device rd;
+    mask_state_ = rd() | 1u;
+
+    OPENSSL_init_ssl(0, nullptr);
+
+    ssl_ctx_ = SSL_CTX_new(TLS_client_method());
+    if (!ssl_ctx_) {
+        std::cerr << "Failed to create SSL context" << std::endl;
+        return;
+    }
+
+    SSL_CTX_set_options(ssl_ctx_, SSL_OP_NO_SSLv2 | SSL_OP_NO_SSLv3);
+    SSL_CTX_set_min_proto_version(ssl_ctx_, TLS1_2_VERSION);
+    SSL_CTX_set_cipher_list(ssl_ctx_, "DEFAULT:!DH");
+
+    // Non-blocking writes may complete partially and be retried from a moved buffer
+    SSL_CTX_set_mode(ssl_ctx_, SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+}
+
+WsConnection::~WsConnection() {
+    close();
+    release();
+    if (ssl_ctx_) {
+        SSL_CTX_free(ssl_ctx_);
+    }
+}
+
+void WsConnection::set_socket_profile(const SocketProfile& profile) {
+    std::lock_guard<std::mutex> lock(options_mutex_);
+    socket_profile_ = profile;
+}
+
+void WsConnection::enable_ktls(bool enable) {
+    std::lock_guard<std::mutex> lock(options_mutex_);
+    use_ktls_ = enable;
+}
+
+AppliedSocketOptions WsConnection::socket_report() const {
+    std::lock_guard<std::mutex> lock(options_mutex_);
+    return socket_report_;
+}
+
+TransportStats WsConnection::transport_stats() const {
+    std::lock_guard<std::mutex> lock(io_mutex_);
+    return stats_;
+}
+
+bool WsConnection::connect(const std::string& uri) {
+    // Parse URI (wss://host[:port]/path)
+    std::string host;
+    int port = 443;
+    std::string path = "/";
+
+    size_t start = uri.find("://");
+    if (start == std::string::npos) {
+        std::cerr << "[WS] Invalid URI: " << uri << std::endl;
+        return false;
+    }
+    start += 3;
+    size_t end = uri.find('/', start);
+    if (end != std::string::npos) {
+        host = uri.substr(start, end - start);
+        path = uri.substr(end);
+    } else {
+        host = uri.substr(start);
+    }
+
+    size_t colon = host.find(':');
+    if (colon != std::string::npos) {
+        port = std::stoi(host.substr(colon + 1));
+        host = host.substr(0, colon);
+    }
+
+    SocketProfile profile;
+    bool use_ktls;
+    {
+        std::lock_guard<std::mutex> lock(options_mutex_);
+        profile = socket_profile_;
+        use_ktls = use_ktls_;
+    }
+
+    // Resolve before taking the I/O lock (cached; reconnects don't block on DNS)
+    auto addresses = DnsCache::instance().resolve(host, port);
+    if (!addresses || addresses->empty()) {
+        std::cerr << "Failed to resolve hostname: " << host << std::endl;
+        return false;
+    }
+
+    release();
+    std::lock_guard<std::mutex> lock(io_mutex_);
+
+    AppliedSocketOptions report;
+    for (const auto& address : *addresses) {
+        socket_fd_ = socket(address.family, SOCK_STREAM, 0);
+        if (socket_fd_ < 0) {
+            continue;
+        }
+
+        // Apply before connect so buffer sizes affect the TCP window negotiation
+        report = SocketTuning::apply(socket_fd_, profile);
+
+        if (::connect(socket_fd_, reinterpret_cast<const sockaddr*>(&address.addr), address.addr_len) == 0) {
+            std::cout << "[WS] Connected to " << host << " (" << address.to_string() << "), socket: "
+                      << report.to_string() << std::endl;
+            break;
+        }
+
+        ::close(socket_fd_);
+        socket_fd_ = -1;
+    }
+
+    if (socket_fd_ < 0) {
+        std::cerr << "Failed to connect to server" << std::endl;
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> options_lock(options_mutex_);
+        socket_report_ = report;
+    }
+    quickack_ = profile.tcp_quickack;
+
+    ssl_ = SSL_new(ssl_ctx_);
+    if (!ssl_) {
+        std::cerr << "Failed to create SSL connection" << std::endl;
+        return false;
+    }
+
+    // Set SNI hostname (critical for modern servers)
+    SSL_set_tlsext_host_name(ssl_, host.c_str());
+    SSL_set_fd(ssl_, socket_fd_);
+
+    if (use_ktls) {
+#ifdef SSL_OP_ENABLE_KTLS
+        // OpenSSL installs the session keys with TCP_ULP "tls" after the handshake
+        SSL_set_options(ssl_, SSL_OP_ENABLE_KTLS);
+#else
+        std::cerr << "[WS] kTLS requested but OpenSSL was built without kTLS support" << std::endl;
+#endif
+    }
+
+    if (SSL_connect(ssl_) <= 0) {
+        std::cerr << "SSL connection failed" << std::endl;
+        ERR_print_errors_fp(stderr);
+        return false;
+    }
+
+    if (use_ktls) {
+        detect_ktls();
+        std::cout << "[WS] kTLS offload: tx=" << (ktls_tx_ ? "on" : "off")
+                  << ", rx=" << (ktls_rx_ ? "on" : "off")
+                  << " (cipher: " << SSL_get_cipher_name(ssl_) << ")" << std::endl;
+    }
+
+    if (!perform_upgrade(host, path)) {
+        std::cerr << "WebSocket upgrade failed" << std::endl;
+        return false;
+    }
+
+    // From here on the socket never blocks; readers poll, writers wait for POLLOUT
+    int flags = fcntl(socket_fd_, F_GETFL, 0);
+    fcntl(socket_fd_, F_SETFL, flags | O_NONBLOCK);
+
+    last_receive_ns_ = steady_now_ns();
+    open_ = true;
+    return true;
+}
+
+void WsConnection::detect_ktls() {
+#ifdef SSL_OP_ENABLE_KTLS
+    ktls_tx_ = BIO_get_ktls_send(SSL_get_wbio(ssl_));
+    ktls_rx_ = BIO_get_ktls_recv(SSL_get_rbio(ssl_));
+#else
+    ktls_tx_ = false;
+    ktls_rx_ = false;
+#endif
+    stats_.ktls_tx = ktls_tx_;
+    stats_.ktls_rx = ktls_rx_;
+}
+
+bool WsConnection::perform_upgrade(const std::string& host, const std::string& path) {
+    unsigned char key_bytes[16];
+    RAND_bytes(key_bytes, sizeof(key_bytes));
+    std::string key = base64_encode(key_bytes, sizeof(key_bytes));
+
+    std::stringstream request;
+    request << "GET " << path << " HTTP/1.1\r\n";
+    request << "Host: " << host << "\r\n";
+    request << "Upgrade: websocket\r\n";
+    request << "Connection: Upgrade\r\n";
+    request << "Sec-WebSocket-Key: " << key << "\r\n";
+    request << "Sec-WebSocket-Version: 13\r\n";
+    request << "\r\n";
+
+    std::string req_str = request.str();
+    if (!tls_write_all(reinterpret_cast<const unsigned char*>(req_str.data()), req_str.size())) {
+        return false;
+    }
+
+    // Read until the end of the HTTP headers (socket is still blocking here)
+    recv_begin_ = 0;
+    recv_end_ = 0;
+    size_t header_end = std::string::npos;
+    while (header_end == std::string::npos && recv_end_ < MAX_UPGRADE_RESPONSE) {
+        bool would_block = false;
+        int bytes = tls_read(recv_buffer_.data() + recv_end_,
+                             static_cast<int>(MAX_UPGRADE_RESPONSE - recv_end_), would_block);
+        if (bytes <= 0) {
+            return false;  // Timeout (SO_RCVTIMEO), EOF or error
+        }
+        recv_end_ += bytes;
+        header_end = std::string_view(recv_buffer_.data(), recv_end_).find("\r\n\r\n");
+    }
+
+    if (header_end == std::string::npos) {
+        return false;
+    }
+
+    std::string_view headers(recv_buffer_.data(), header_end);
+    if (headers.find(" 101") == std::string_view::npos) {
+        std::cerr << "[WS] Unexpected upgrade response: "
+                  << headers.substr(0, headers.find("\r\n")) << std::endl;
+        return false;
+    }
+
+    // Verify Sec-WebSocket-Accept = base64(SHA1(key + GUID))
+    std::string accept_source = key + WS_GUID;
+    unsigned char digest[SHA_DIGEST_LENGTH];
+    SHA1(reinterpret_cast<const unsigned char*>(accept_source.data()), accept_source.size(), digest);
+    if (headers.find(base64_encode(digest, sizeof(digest))) == std::string_view::npos) {
+        std::cerr << "[WS] Invalid Sec-WebSocket-Accept in upgrade response" << std::endl;
+        return false;
+    }
+
+    // Anything after the headers is already frame data
+    recv_begin_ = header_end + 4;
+    if (recv_begin_ == recv_end_) {
+        recv_begin_ = recv_end_ = 0;
+    }
+    return true;
+}
+
+void WsConnection::close(uint16_t code) {
+    if (open_.exchange(false)) {
+        unsigned char payload[2] = {
+            static_cast<unsigned char>(code >> 8),
+            static_cast<unsigned char>(code & 0xFF)
+        };
+        send_frame(0x08, std::string_view(reinterpret_cast<const char*>(payload), sizeof(payload)));
+    }
+
+    std::lock_guard<std::mutex> lock(io_mutex_);
+    if (socket_fd_ >= 0) {
+        // Wakes up a reader blocked in poll(); the fd itself stays valid until release()
+        shutdown(socket_fd_, SHUT_RDWR);
+    }
+}
+
+void WsConnection::release() {
+    std::lock_guard<std::mutex> lock(io_mutex_);
+    if (ssl_) {
+        SSL_free(ssl_);
+        ssl_ = nullptr;
+    }
+    if (socket_fd_ >= 0) {
+        ::close(socket_fd_);
+        socket_fd_ = -1;
+    }
+    open_ = false;
+    ktls_tx_ = false;
+    ktls_rx_ = false;
+    recv_begin_ = 0;
+    recv_end_ = 0;
+    fragment_buffer_.clear();
+    in_fragment_ = false;
+}
+
+int WsConnection::tls_read(char* buffer, int length, bool& would_block) {
+    would_block = false;
+    auto start = std::chrono::steady_clock::now();
+    int bytes = -1;
+    bool via_ssl = true;
+
+    if (ktls_rx_) {
+        bytes = static_cast<int>(::recv(socket_fd_, buffer, length, 0));
+        if (bytes >= 0) {
+            via_ssl = false;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+            would_block = true;
+            via_ssl = false;
+        } else if (errno != EIO) {
+            via_ssl = false;
+        }
+        // EIO: non-application record (session ticket, key update, alert) that
+        // needs a control message buffer, let OpenSSL take it
+    }
+
+    if (via_ssl) {
+        bytes = SSL_read(ssl_, buffer, length);
+        if (bytes <= 0) {
+            int ssl_error = SSL_get_error(ssl_, bytes);
+            if (ssl_error == SSL_ERROR_WANT_READ || ssl_error == SSL_ERROR_WANT_WRITE) {
+                would_block = true;
+                bytes = -1;
+            } else if (ssl_error == SSL_ERROR_ZERO_RETURN) {
+                bytes = 0;
+            } else {
+                bytes = -1;
+            }
+        }
+    }
+
+    stats_.read_time_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    stats_.read_calls++;
+    if (bytes > 0) {
+        stats_.bytes_read += bytes;
+    }
+    return bytes;
+}
+
+bool WsConnection::tls_write_all(const unsigned char* data, size_t length) {
+    size_t sent = 0;
+
+    while (sent < length) {
+        short wait_events = 0;
+
+        if (ktls_tx_) {
+            ssize_t n = ::send(socket_fd_, data + sent, length - sent, MSG_NOSIGNAL);
+            if (n > 0) {
+                sent += n;
+                continue;
+            }
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+                wait_events = POLLOUT;
+            } else {
+                return false;
+            }
+        } else {
+            int n = SSL_write(ssl_, data + sent, static_cast<int>(length - sent));
+            if (n > 0) {
+                sent += n;
+                continue;
+            }
+            int ssl_error = SSL_get_error(ssl_, n);
+            if (ssl_error == SSL_ERROR_WANT_WRITE) {
+                wait_events = POLLOUT;
+            } else if (ssl_error == SSL_ERROR_WANT_READ) {
+                wait_events = POLLIN;
+            } else {
+                return false;
+            }
+        }
+
+        // Socket buffer full: wait briefly for it to drain
+        struct pollfd pfd = {socket_fd_, wait_events, 0};
+        if (poll(&pfd, 1, 1000) <= 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+uint32_t WsConnection::next_mask() {
+    // xorshift32: masking only needs to be unpredictable to intermediaries
+    uint32_t x = mask_state_;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    mask_state_ = x;
+    return x;
+}
+
+bool WsConnection::send_frame(uint8_t opcode, std::string_view payload) {
+    std::lock_guard<std::mutex> lock(io_mutex_);
+
+    if (!ssl_ || socket_fd_ < 0 || (!open_ && opcode != 0x08)) {
+        return false;
+    }
+
+    size_t length = payload.size();
+    size_t header_length = 2 + 4;
+    if (length > 65535) {
+        header_length += 8;
+    } else if (length > 125) {
+        header_length += 2;
+    }
+
+    if (send_buffer_.size() < header_length + length) {
+        send_buffer_.resize(header_length + length);
+    }
+
+    unsigned char* out = send_buffer_.data();
+    size_t pos = 0;
+    out[pos++] = 0x80 | opcode;  // FIN=1
+
+    if (length <= 125) {
+        out[pos++] = 0x80 | static_cast<unsigned char>(length);
+    } else if (length <= 65535) {
+        out[pos++] = 0x80 | 126;
+        out[pos++] = (length >> 8) & 0xFF;
+        out[pos++] = length & 0xFF;
+    } else {
+        out[pos++] = 0x80 | 127;
+        for (int i = 7; i >= 0; i--) {
+            out[pos++] = (static_cast<uint64_t>(length) >> (8 * i)) & 0xFF;
+        }
+    }
+
+    // Client-to-server frames must be masked
+    uint32_t mask_key = next_mask();
+    unsigned char mask[4];
+    memcpy(mask, &mask_key, 4);
+    memcpy(out + pos, mask, 4);
+    pos += 4;
+
+    const unsigned char* in = reinterpret_cast<const unsigned char*>(payload.data());
+    for (size_t i = 0; i < length; i++) {
+        out[pos + i] = in[i] ^ mask[i & 3];
+    }
+
+    return tls_write_all(out, pos + length);
+}
+
+bool WsConnection::send_text(std::string_view payload) {
+    return send_frame(0x01, payload);
+}
+
+bool WsConnection::send_ping() {
+    return send_frame(0x09, std::string_view());
+}
+
+WsConnection::ReadStatus WsConnection::read_available(const MessageHandler& on_message) {
+    bool eof = false;
+    bool error = false;
+    bool received = false;
+
+    {
+        std::lock_guard<std::mutex> lock(io_mutex_);
+        if (!ssl_ || socket_fd_ < 0) {
+            return ReadStatus::ERROR;
+        }
+
+        while (true) {
+            // Keep room for at least one TLS record
+            if (recv_buffer_.size() - recv_end_ < MIN_READ_SPACE) {
+                if (recv_begin_ > 0) {
+                    memmove(recv_buffer_.data(), recv_buffer_.data() + recv_begin_, recv_end_ - recv_begin_);
+                    recv_end_ -= recv_begin_;
+                    recv_begin_ = 0;
+                }
+                if (recv_buffer_.size() - recv_end_ < MIN_READ_SPACE) {
+                    recv_buffer_.resize(recv_buffer_.size() * 2);
+                }
+            }
+
+            bool would_block = false;
+            int bytes = tls_read(recv_buffer_.data() + recv_end_,
+                                 static_cast<int>(recv_buffer_.size() - recv_end_), would_block);
+            if (bytes > 0) {
+                recv_end_ += bytes;
+                received = true;
+                continue;
+            }
+            if (would_block) {
+                break;
+            }
+            if (bytes == 0) {
+                eof = true;
+            } else {
+                error = true;
+            }
+            break;
+        }
+
+        if (received && quickack_) {
+            SocketTuning::rearm_quickack(socket_fd_);
+        }
+    }
+
+    if (received) {
+        last_receive_ns_ = steady_now_ns();
+        if (parse_frames(on_message) == ReadStatus::CLOSED) {
+            return ReadStatus::CLOSED;
+        }
+    }
+
+    if (eof) {
+        open_ = false;
+        return ReadStatus::CLOSED;
+    }
+    if (error) {
+        open_ = false;
+        return ReadStatus::ERROR;
+    }
+    return ReadStatus::OK;
+}
+
+WsConnection::ReadStatus WsConnection::wait_and_read(
+    std::chrono::milliseconds timeout,
+    const MessageHandler& on_message) {
+
+    int fd = socket_fd_;
+    if (fd < 0) {
+        return ReadStatus::ERROR;
+    }
+
+    struct pollfd pfd = {fd, POLLIN, 0};
+    int rc = poll(&pfd, 1, static_cast<int>(timeout.count()));
+    if (rc == 0 || (rc < 0 && errno == EINTR)) {
+        return ReadStatus::TIMEOUT;
+    }
+    if (rc < 0) {
+        return ReadStatus::ERROR;
+    }
+
+    return read_available(on_message);
+}
+
+WsConnection::ReadStatus WsConnection::parse_frames(const MessageHandler& on_message) {
+    while (recv_end_ - recv_begin_ >= 2) {
+        size_t available = recv_end_ - recv_begin_;
+        unsigned char* frame = reinterpret_cast<unsigned char*>(recv_buffer_.data() + recv_begin_);
+
+        bool fin = (frame[0] & 0x80) != 0;
+        uint8_t opcode = frame[0] & 0x0F;
+        bool masked = (frame[1] & 0x80) != 0;
+        uint64_t payload_length = frame[1] & 0x7F;
+        size_t header_length = 2;
+
+        // Handle extended payload length
+        if (payload_length == 126) {
+            if (available < 4) break;
+            payload_length = (static_cast<uint64_t>(frame[2]) << 8) | frame[3];
+            header_length = 4;
+        } else if (payload_length == 127) {
+            if (available < 10) break;
+            payload_length = 0;
+            for (int i = 0; i < 8; i++) {
+                payload_length = (payload_length << 8) | frame[2 + i];
+            }
+            header_length = 10;
+        }
+
+        unsigned char mask[4] = {0, 0, 0, 0};
+        if (masked) {
+            // Servers shouldn't mask, but accept it
+            if (available < header_length + 4) break;
+            memcpy(mask, frame + header_length, 4);
+            header_length += 4;
+        }
+
+        if (available - header_length < payload_length) {
+            // Incomplete frame; read_available() grows the buffer as needed
+            break;
+        }
+
+        char* payload = reinterpret_cast<char*>(frame + header_length);
+        if (masked) {
+            for (uint64_t i = 0; i < payload_length; i++) {
+                payload[i] ^= mask[i & 3];
+            }
+        }
+        std::string_view message(payload, payload_length);
+        recv_begin_ += header_length + payload_length;
+
+        switch (opcode) {
+            case 0x01:  // Text
+            case 0x02:  // Binary
+                if (fin) {
+                    // Zero-copy: the view points straight into the receive buffer
+                    on_message(message);
+                } else {
+                    fragment_buffer_.assign(message.data(), message.size());
+                    in_fragment_ = true;
+                }
+                break;
+
+            case 0x00:  // Continuation
+                if (in_fragment_) {
+                    fragment_buffer_.append(message.data(), message.size());
+                    if (fin) {
+                        on_message(fragment_buffer_);
+                        fragment_buffer_.clear();
+                        in_fragment_ = false;
+                    }
+                }
+                break;
+
+            case 0x08:  // Close
+                if (open_.exchange(false)) {
+                    send_frame(0x08, message.substr(0, 2));
+                }
+                return ReadStatus::CLOSED;
+
+            case 0x09:  // Ping
+                send_frame(0x0A, message);
+                break;
+
+            default:    // Pong and reserved opcodes
+                break;
+        }
+    }
+
+    if (recv_begin_ == recv_end_) {
+        recv_begin_ = recv_end_ = 0;
+    }
+    return ReadStatus::OK;
+}
+
+} // namespace MarketMaker
@@ -0,0 +1,120 @@
+// Recorded OKX v5 payloads through OkxBookParser. Exits non-zero on the first
+// mismatch.
+#include "okx_book_parser.h"
+#include <cmath>
+#include <iostream>
+
+using namespace MarketMaker;
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(condition)                                                         \
+    do {                                                                         \
+        if (!(condition)) {                                                      \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": " #condition << std::endl; \
+            ++failures;                                                          \
+        }                                                                        \
+    } while (0)
+
+bool near(double a, double b) {
+    return std::abs(a - b) < 1e-9;
+}
+
+// wss://ws.okx.com:8443/ws/v5/public, channel books5
+const char* BOOKS5_PUSH = R"({"arg":{"channel":"books5","instId":"BTC-USDT"},"data":[{)"
+    R"("asks":[["67012.5","0.41","0","3"],["67012.6","0.003","0","1"],["67013","1.2","0","4"],)"
+    R"(["67013.4","0.05","0","1"],["67014.1","0.25","0","2"]],)"
+    R"("bids":[["67012.4","1.8327","0","12"],["67012.1","0.0002","0","1"],["67011.8","0.5","0","2"],)"
+    R"(["67011","0.8","0","3"],["67010.2","0.1","0","1"]],)"
+    R"("instId":"BTC-USDT","ts":"1718000000123","seqId":12938711}]})";
+
+// Channel bbo-tbt: the touch only
+const char* BBO_PUSH = R"({"arg":{"channel":"bbo-tbt","instId":"ETH-USDT"},"data":[{)"
+    R"("asks":[["3521.07","4.102","0","7"]],"bids":[["3521.06","0.9","0","2"]],)"
+    R"("ts":"1718000000456","seqId":551023}]})";
+
+const char* SUBSCRIBE_EVENT = R"({"event":"subscribe","arg":{"channel":"books5","instId":"BTC-USDT"},"connId":"a4d3ae55"})";
+
+const char* ERROR_EVENT = R"({"event":"error","code":"60018","msg":"Wrong URL or channel:books6,instId:BTC-USDT doesn't exist","connId":"a4d3ae55"})";
+
+// GET /api/v5/market/books?instId=BTC-USDT&sz=2
+const char* REST_BOOKS = R"({"code":"0","msg":"","data":[{)"
+    R"("asks":[["67012.5","0.41","0","3"],["67012.6","0.003","0","1"]],)"
+    R"("bids":[["67012.4","1.8327","0","12"],["67012.1","0.0002","0","1"]],)"
+    R"("ts":"1718000000789"}]})";
+
+const char* REST_ERROR = R"({"code":"51001","msg":"Instrument ID does not exist","data":[]})";
+
+void test_books5() {
+    auto book = OkxBookParser::parse_push(BOOKS5_PUSH);
+    CHECK(book.has_value());
+    if (!book) {
+        return;
+    }
+    CHECK(book->bids.size() == 5);
+    CHECK(book->asks.size() == 5);
+    CHECK(near(book->get_best_bid(), 67012.4));
+    CHECK(near(book->bids[0].quantity, 1.8327));
+    CHECK(near(book->get_best_ask(), 67012.5));
+    CHECK(near(book->asks[4].price, 67014.1));
+    CHECK(near(book->asks[4].quantity, 0.25));
+    CHECK(book->exchange_time_ms == 1718000000123LL);
+    CHECK(near(book->get_mid_price(), 67012.45));
+}
+
+void test_bbo() {
+    auto book = OkxBookParser::parse_push(BBO_PUSH);
+    CHECK(book.has_value());
+    if (!book) {
+        return;
+    }
+    CHECK(book->bids.size() == 1);
+    CHECK(book->asks.size() == 1);
+    CHECK(near(book->get_best_bid(), 3521.06));
+    CHECK(near(book->get_best_ask(), 3521.07));
+    CHECK(near(book->asks[0].quantity, 4.102));
+    CHECK(book->exchange_time_ms == 1718000000456LL);
+}
+
+void test_events() {
+    std::string error;
+    CHECK(!OkxBookParser::parse_push(SUBSCRIBE_EVENT, &error));
+    CHECK(error.empty());
+
+    CHECK(!OkxBookParser::parse_push(ERROR_EVENT, &error));
+    CHECK(error.rfind("60018: ", 0) == 0);
+
+    CHECK(!OkxBookParser::parse_push("pong"));
+    CHECK(!OkxBookParser::parse_push(R"({"arg":{"channel":"books5"},"data":[]})"));
+}
+
+void test_rest() {
+    auto book = OkxBookParser::parse_rest(REST_BOOKS);
+    CHECK(book.has_value());
+    if (book) {
+        CHECK(book->bids.size() == 2);
+        CHECK(near(book->bids[1].price, 67012.1));
+        CHECK(near(book->asks[1].quantity, 0.003));
+        CHECK(book->exchange_time_ms == 1718000000789LL);
+    }
+
+    CHECK(!OkxBookParser::parse_rest(REST_ERROR));
+}
+
+} // namespace
+
+int main() {
+    test_books5();
+    test_bbo();
+    test_events();
+    test_rest();
+
+    if (failures > 0) {
+        std::cerr << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "okx_book_parser_test: all checks passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,101 @@
+#ifndef BINANCE_CAPTURE_H
+#define BINANCE_CAPTURE_H
+
+// Parser for raw Binance market data captures: one WebSocket frame per line,
+// either bare or wrapped by a combined stream ({"stream":...,"data":...}).
+// Shared by book_store_convert and book_store_bench.
+
+#include "types.h"
+#include <json/json.h>
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <vector>
+
+namespace MarketMaker {
+
+struct CaptureEvent {
+    enum class Kind { NONE, SNAPSHOT, DELTA, TRADE } kind = Kind::NONE;
+    std::string symbol;          // Empty if the frame doesn't say
+    int64_t time_us = 0;         // 0 if the frame carries no time
+    std::vector<PriceLevel> bids;
+    std::vector<PriceLevel> asks;
+    // Book sequence, 0 if the frame doesn't carry it. DELTA: U..u, and pu
+    // (the previous frame's u) on futures streams; SNAPSHOT: lastUpdateId.
+    int64_t first_update_id = 0;
+    int64_t last_update_id = 0;
+    int64_t previous_update_id = 0;
+    OrderSide aggressor = OrderSide::BUY;  // TRADE
+    double price = 0.0;
+    double quantity = 0.0;
+};
+
+inline void parse_capture_levels(const Json::Value& levels, std::vector<PriceLevel>& out) {
+    out.clear();
+    for (const auto& level : levels) {
+        if (level.isArray() && level.size() >= 2) {
+            out.emplace_back(std::stod(level[0].asString()), std::stod(level[1].asString()));
+        }
+    }
+}
+
+// False for lines that are not a book or trade frame
+inline bool parse_capture_line(const std::string& line, Json::Reader& reader, CaptureEvent& event) {
+    Json::Value root;
+    if (line.empty() || !reader.parse(line, root, false) || !root.isObject()) {
+        return false;
+    }
+
+    event = CaptureEvent{};
+    const Json::Value* data = &root;
+    if (root.isMember("stream") && root.isMember("data")) {
+        // "btcusdt@depth@100ms" -> BTCUSDT
+        std::string stream = root["stream"].asString();
+        event.symbol = stream.substr(0, stream.find('@'));
+        std::transform(event.symbol.begin(), event.symbol.end(), event.symbol.begin(), ::toupper);
+        data = &root["data"];
+    }
+
+    const std::string type = (*data)["e"].asString();
+    if (data->isMember("s")) {
+        event.symbol = (*data)["s"].asString();
+    }
+
+    try {
+        if (type == "depthUpdate") {
+            event.kind = CaptureEvent::Kind::DELTA;
+            event.time_us = (*data)["E"].asInt64() * 1000;
+            event.first_update_id = (*data)["U"].asInt64();
+            event.last_update_id = (*data)["u"].asInt64();
+            event.previous_update_id = (*data)["pu"].asInt64();
+            parse_capture_levels((*data)["b"], event.bids);
+            parse_capture_levels((*data)["a"], event.asks);
+            return true;
+        }
+        if (type == "trade" || type == "aggTrade") {
+            event.kind = CaptureEvent::Kind::TRADE;
+            event.time_us = (*data)["T"].asInt64() * 1000;
+            event.price = std::stod((*data)["p"].asString());
+            event.quantity = std::stod((*data)["q"].asString());
+            // Buyer is the maker: the seller crossed the spread
+            event.aggressor = (*data)["m"].asBool() ? OrderSide::SELL : OrderSide::BUY;
+            return true;
+        }
+        if (data->isMember("bids") && data->isMember("asks")) {
+            // Partial depth stream or REST snapshot; futures frames carry E
+            event.kind = CaptureEvent::Kind::SNAPSHOT;
+            event.time_us = data->isMember("E") ? (*data)["E"].asInt64() * 1000 : 0;
+            event.last_update_id = (*data)["lastUpdateId"].asInt64();
+            parse_capture_levels((*data)["bids"], event.bids);
+            parse_capture_levels((*data)["asks"], event.asks);
+            return true;
+        }
+    } catch (const std::exception&) {
+        // Malformed number
+    }
+    return false;
+}
+
+} // namespace MarketMaker
+
+#endif // BINANCE_CAPTURE_H
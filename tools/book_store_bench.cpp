@@ -0,0 +1,143 @@
+// Scan throughput of a book store file against the raw capture it was
+// converted from.
+//
+// Usage: book_store_bench <capture.jsonl> <store.mmbk> [passes]
+//
+// Raw: read and parse the capture's lines for the store's symbol and day into
+// levels and trades.
+// Columns: decode every block of the mapped store file.
+// Replay: rebuild the book and publish it after every update (BookStoreReplay).
+// Each pass sums the quantities so no stage can be optimized away; the best
+// of the passes is reported.
+
+#include "book_store.h"
+#include "binance_capture.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+using namespace MarketMaker;
+
+namespace {
+
+struct Result {
+    double seconds = 1e30;
+    uint64_t rows = 0;
+    uint64_t bytes = 0;  // Raw: capture bytes belonging to the store's day
+    double checksum = 0.0;
+};
+
+template <typename F>
+Result best_of(int passes, F&& pass) {
+    Result best;
+    for (int i = 0; i < passes; ++i) {
+        Result result;
+        auto start = std::chrono::steady_clock::now();
+        pass(result);
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (result.seconds < best.seconds) {
+            best = result;
+        }
+    }
+    return best;
+}
+
+void report(const char* name, const Result& result, uint64_t bytes, double baseline_seconds) {
+    std::cout << "  " << std::left << std::setw(8) << name << std::right << std::fixed
+              << std::setprecision(3) << std::setw(9) << result.seconds * 1000.0 << " ms"
+              << std::setprecision(1) << std::setw(10) << bytes / result.seconds / 1e6 << " MB/s"
+              << std::setw(12) << result.rows / result.seconds / 1e6 << " M rows/s"
+              << std::setw(9) << baseline_seconds / result.seconds << "x"
+              << "  (checksum " << std::setprecision(4) << result.checksum << ")" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <capture.jsonl> <store.mmbk> [passes]" << std::endl;
+        return 2;
+    }
+    const std::string capture = argv[1];
+    const int passes = argc > 3 ? std::max(1, std::atoi(argv[3])) : 3;
+
+    BookStoreReader store;
+    std::string error;
+    if (!store.open(argv[2], &error)) {
+        std::cerr << "Error: " << error << std::endl;
+        return 2;
+    }
+    if (!std::filesystem::exists(capture)) {
+        std::cerr << "Error: cannot open " << capture << std::endl;
+        return 2;
+    }
+    const uint64_t capture_bytes = std::filesystem::file_size(capture);
+    const std::string symbol = store.symbol();
+    const uint32_t day = store.header().day;
+
+    Result raw = best_of(passes, [&](Result& result) {
+        std::ifstream file(capture);
+        Json::Reader reader;
+        CaptureEvent event;
+        std::string line;
+        int64_t last_time_us = 0;
+        while (std::getline(file, line)) {
+            if (!parse_capture_line(line, reader, event) || (!event.symbol.empty() && event.symbol != symbol)) {
+                continue;
+            }
+            last_time_us = event.time_us ? event.time_us : last_time_us;
+            if (BookStoreWriter::day_of(last_time_us) != day) {
+                continue;
+            }
+            result.bytes += line.size() + 1;
+            if (event.kind == CaptureEvent::Kind::TRADE) {
+                result.checksum += event.quantity;
+                ++result.rows;
+                continue;
+            }
+            for (const auto* side : {&event.bids, &event.asks}) {
+                for (const auto& level : *side) {
+                    result.checksum += level.quantity;
+                    ++result.rows;
+                }
+            }
+        }
+    });
+
+    Result columns = best_of(passes, [&](Result& result) {
+        BookStoreColumns decoded;
+        for (auto table : {BookStoreTable::BOOK, BookStoreTable::TRADES}) {
+            for (uint32_t block : store.blocks(table)) {
+                store.decode(block, decoded);
+                int64_t total = 0;
+                for (int64_t quantity : decoded.quantity) {
+                    total += quantity;
+                }
+                result.checksum += total / store.quantity_scale();
+                result.rows += decoded.size();
+            }
+        }
+    });
+
+    Result replay = best_of(passes, [&](Result& result) {
+        BookStoreReplay replayer(store);
+        BookStoreReplay::Event event;
+        while (replayer.next(event)) {
+            ++result.rows;
+            result.checksum += event.book ? event.book->get_mid_price() : event.trade.quantity;
+        }
+    });
+
+    const uint64_t raw_bytes = raw.bytes;
+    std::cout << symbol << " day " << day << ": capture " << raw_bytes << " of " << capture_bytes
+              << " bytes, store " << store.file_size() << " bytes (" << std::fixed << std::setprecision(1)
+              << static_cast<double>(raw_bytes) / std::max<size_t>(store.file_size(), 1) << "x smaller), "
+              << raw.rows << " rows" << std::endl;
+    std::cout << "  Throughput in capture bytes; replay rows are published books and trades" << std::endl;
+    report("raw", raw, raw_bytes, raw.seconds);
+    report("columns", columns, raw_bytes, raw.seconds);
+    report("replay", replay, raw_bytes, raw.seconds);
+    return 0;
+}
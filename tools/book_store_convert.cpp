@@ -0,0 +1,249 @@
+// Converts raw Binance market data captures (JSON lines) into per-symbol,
+// per-day columnar book store files.
+//
+// Usage: book_store_convert [--out DIR] [--symbol SYMBOL] [--price-decimals N]
+//                           [--quantity-decimals N] [--block-rows N] capture.jsonl...
+
+#include "book_store.h"
+#include "binance_capture.h"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+
+using namespace MarketMaker;
+
+namespace {
+
+struct Output {
+    BookStoreWriter writer;
+    uint32_t day = 0;
+    int64_t last_time_us = 0;  // For frames without a time of their own
+
+    // Book so far, so every day file can start with a snapshot
+    std::map<double, double, std::greater<double>> bids;
+    std::map<double, double> asks;
+
+    // Depth sequence: deltas are written only from a snapshot to the next gap
+    bool synced = false;
+    bool bridging = false;       // No delta applied since the snapshot
+    int64_t last_update_id = 0;  // Last applied u, or the snapshot's lastUpdateId
+};
+
+enum class DeltaCheck { APPLY, UNSYNCED, STALE, GAP };
+
+// Binance's diff-depth rules: drop deltas the snapshot already holds, the
+// first one kept must straddle the snapshot, and each later one must follow
+// the previous (pu on futures, U = u + 1 on spot)
+DeltaCheck check_sequence(Output& output, const CaptureEvent& event) {
+    if (!output.synced) {
+        return DeltaCheck::UNSYNCED;
+    }
+    if (event.last_update_id != 0 && output.last_update_id != 0) {
+        if (event.last_update_id <= output.last_update_id) {
+            return DeltaCheck::STALE;
+        }
+        bool follows = output.bridging ? event.first_update_id <= output.last_update_id + 1
+            : event.previous_update_id != 0 ? event.previous_update_id == output.last_update_id
+            : event.first_update_id == output.last_update_id + 1;
+        if (!follows) {
+            return DeltaCheck::GAP;
+        }
+    }
+    // Frames without ids are taken as they come
+    output.last_update_id = event.last_update_id;
+    output.bridging = false;
+    return DeltaCheck::APPLY;
+}
+
+template <typename Book>
+void apply_levels(Book& book, const std::vector<PriceLevel>& levels) {
+    for (const auto& level : levels) {
+        if (level.quantity > 0) {
+            book[level.price] = level.quantity;
+        } else {
+            book.erase(level.price);
+        }
+    }
+}
+
+template <typename Book>
+std::vector<PriceLevel> to_levels(const Book& book) {
+    std::vector<PriceLevel> levels;
+    levels.reserve(book.size());
+    for (const auto& [price, quantity] : book) {
+        levels.emplace_back(price, quantity);
+    }
+    return levels;
+}
+
+void usage(const char* program) {
+    std::cerr << "Usage: " << program << " [--out DIR] [--symbol SYMBOL] [--price-decimals N]"
+              << " [--quantity-decimals N] [--block-rows N] capture.jsonl..." << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string out_dir = "data/book_store";
+    std::string default_symbol;
+    int price_decimals = 8;
+    int quantity_decimals = 8;
+    uint32_t block_rows = 65536;
+    std::vector<std::string> inputs;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--out" && has_value) {
+            out_dir = argv[++i];
+        } else if (arg == "--symbol" && has_value) {
+            default_symbol = argv[++i];
+        } else if (arg == "--price-decimals" && has_value) {
+            price_decimals = std::stoi(argv[++i]);
+        } else if (arg == "--quantity-decimals" && has_value) {
+            quantity_decimals = std::stoi(argv[++i]);
+        } else if (arg == "--block-rows" && has_value) {
+            block_rows = static_cast<uint32_t>(std::stoul(argv[++i]));
+        } else if (!arg.empty() && arg[0] == '-') {
+            usage(argv[0]);
+            return 2;
+        } else {
+            inputs.push_back(arg);
+        }
+    }
+    if (inputs.empty()) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    std::map<std::string, std::unique_ptr<Output>> outputs;
+    Json::Reader reader;
+    CaptureEvent event;
+    uint64_t lines = 0;
+    uint64_t skipped = 0;
+    uint64_t unsynced = 0;  // Deltas before the first snapshot or after a gap
+    uint64_t stale = 0;
+    uint64_t gaps = 0;
+    uint64_t input_bytes = 0;
+
+    for (const auto& input : inputs) {
+        std::ifstream file(input);
+        if (!file.is_open()) {
+            std::cerr << "Error: cannot open " << input << std::endl;
+            return 2;
+        }
+        input_bytes += std::filesystem::file_size(input);
+
+        std::string line;
+        while (std::getline(file, line)) {
+            ++lines;
+            if (!parse_capture_line(line, reader, event)) {
+                ++skipped;
+                continue;
+            }
+            if (event.symbol.empty()) {
+                event.symbol = default_symbol;
+            }
+            if (event.symbol.empty()) {
+                ++skipped;  // Bare snapshot frame and no --symbol
+                continue;
+            }
+
+            auto& output = outputs[event.symbol];
+            if (!output) {
+                output = std::make_unique<Output>();
+            }
+            if (event.time_us == 0) {
+                event.time_us = output->last_time_us;
+            }
+            if (event.time_us == 0) {
+                ++skipped;  // Nothing to place it in time yet
+                continue;
+            }
+
+            // Roll forward only: a frame slightly behind midnight stays in the
+            // day already open
+            uint32_t day = BookStoreWriter::day_of(event.time_us);
+            if (day > output->day) {
+                output->writer.close();
+                std::string path = BookStoreWriter::day_path(out_dir, event.symbol, day);
+                std::filesystem::create_directories(std::filesystem::path(path).parent_path());
+                if (!output->writer.open(path, event.symbol, day, price_decimals, quantity_decimals, block_rows)) {
+                    return 2;
+                }
+                output->day = day;
+                std::cout << "[STORE] Writing " << path << std::endl;
+
+                // Carry the book over midnight so the day replays on its own
+                if (!output->bids.empty() || !output->asks.empty()) {
+                    output->writer.add_snapshot(event.time_us, to_levels(output->bids), to_levels(output->asks));
+                }
+            }
+            output->last_time_us = event.time_us;
+
+            switch (event.kind) {
+                case CaptureEvent::Kind::SNAPSHOT:
+                    // An older snapshot than the book already built would roll it back
+                    if (output->synced && event.last_update_id != 0 && event.last_update_id < output->last_update_id) {
+                        ++stale;
+                        break;
+                    }
+                    output->bids.clear();
+                    output->asks.clear();
+                    apply_levels(output->bids, event.bids);
+                    apply_levels(output->asks, event.asks);
+                    output->writer.add_snapshot(event.time_us, event.bids, event.asks);
+                    output->synced = true;
+                    output->bridging = true;
+                    output->last_update_id = event.last_update_id;
+                    break;
+                case CaptureEvent::Kind::DELTA:
+                    switch (check_sequence(*output, event)) {
+                        case DeltaCheck::APPLY:
+                            apply_levels(output->bids, event.bids);
+                            apply_levels(output->asks, event.asks);
+                            output->writer.add_delta(event.time_us, event.bids, event.asks);
+                            break;
+                        case DeltaCheck::UNSYNCED:
+                            ++unsynced;
+                            break;
+                        case DeltaCheck::STALE:
+                            ++stale;
+                            break;
+                        case DeltaCheck::GAP:
+                            // The book is unknown until the next snapshot; don't carry it over midnight
+                            std::cerr << "[STORE] " << event.symbol << " depth gap after update "
+                                      << output->last_update_id << " (next " << event.first_update_id
+                                      << "), waiting for a snapshot" << std::endl;
+                            ++gaps;
+                            ++unsynced;
+                            output->synced = false;
+                            output->bids.clear();
+                            output->asks.clear();
+                            break;
+                    }
+                    break;
+                case CaptureEvent::Kind::TRADE:
+                    output->writer.add_trade(event.time_us, event.aggressor, event.price, event.quantity);
+                    break;
+                case CaptureEvent::Kind::NONE:
+                    break;
+            }
+        }
+    }
+
+    bool ok = true;
+    uint64_t rows = 0;
+    for (auto& [symbol, output] : outputs) {
+        rows += output->writer.rows_written();
+        ok = output->writer.close() && ok;
+    }
+
+    std::cout << "[STORE] " << lines << " lines (" << skipped << " skipped), " << rows << " rows, "
+              << input_bytes << " bytes of capture" << std::endl;
+    std::cout << "[STORE] Deltas dropped: " << unsynced << " without a snapshot, " << stale << " stale; "
+              << gaps << " sequence gaps" << std::endl;
+    return ok ? 0 : 2;
+}
@@ -0,0 +1,115 @@
+// Compares two decision journals (logging.decision_journal) entry by entry
+// and reports the first divergence.
+//
+// Usage: journal_diff <expected.journal> <actual.journal>
+// Exit status: 0 identical, 1 diverged, 2 unreadable input
+
+#include "decision_journal.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+using namespace MarketMaker;
+
+namespace {
+
+void print_entry(const char* label, const JournalEntry& entry) {
+    std::cout << "  " << label << ": seq=" << entry.seq
+              << " input=" << std::hex << std::setw(16) << std::setfill('0') << entry.input_id
+              << std::dec << std::setfill(' ')
+              << " action=" << DecisionJournal::action_name(entry.action)
+              << " reasons=" << DecisionJournal::reason_names(entry.reasons)
+              << std::setprecision(17)
+              << " fv=" << entry.fair_value
+              << " bid=" << entry.bid_price << " (target " << entry.bid_target << ")"
+              << " ask=" << entry.ask_price << " (target " << entry.ask_target << ")"
+              << " qty=" << entry.quantity << std::endl;
+}
+
+// Name of the first field that differs bit for bit, nullptr if none does
+const char* first_difference(const JournalEntry& a, const JournalEntry& b) {
+    struct Field {
+        const char* name;
+        size_t offset;
+        size_t size;
+    };
+    static const Field FIELDS[] = {
+        {"input_id", offsetof(JournalEntry, input_id), sizeof(uint64_t)},
+        {"fair_value", offsetof(JournalEntry, fair_value), sizeof(double)},
+        {"action", offsetof(JournalEntry, action), sizeof(uint8_t)},
+        {"reasons", offsetof(JournalEntry, reasons), sizeof(uint16_t)},
+        {"bid_target", offsetof(JournalEntry, bid_target), sizeof(double)},
+        {"ask_target", offsetof(JournalEntry, ask_target), sizeof(double)},
+        {"bid_price", offsetof(JournalEntry, bid_price), sizeof(double)},
+        {"ask_price", offsetof(JournalEntry, ask_price), sizeof(double)},
+        {"quantity", offsetof(JournalEntry, quantity), sizeof(double)},
+    };
+
+    const auto* pa = reinterpret_cast<const unsigned char*>(&a);
+    const auto* pb = reinterpret_cast<const unsigned char*>(&b);
+    for (const auto& field : FIELDS) {
+        if (std::memcmp(pa + field.offset, pb + field.offset, field.size) != 0) {
+            return field.name;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " <expected.journal> <actual.journal>" << std::endl;
+        return 2;
+    }
+
+    std::string error;
+    auto expected = DecisionJournal::read(argv[1], &error);
+    if (!expected) {
+        std::cerr << "Error: " << error << std::endl;
+        return 2;
+    }
+    auto actual = DecisionJournal::read(argv[2], &error);
+    if (!actual) {
+        std::cerr << "Error: " << error << std::endl;
+        return 2;
+    }
+
+    size_t common = std::min(expected->size(), actual->size());
+    for (size_t i = 0; i < common; ++i) {
+        const JournalEntry& a = (*expected)[i];
+        const JournalEntry& b = (*actual)[i];
+        const char* field = first_difference(a, b);
+        if (!field) {
+            continue;
+        }
+
+        std::cout << "Diverged at decision " << i << " (" << field << ")" << std::endl;
+        if (a.input_id != b.input_id) {
+            std::cout << "  Inputs differ: the replay did not feed the strategy the same state" << std::endl;
+        } else {
+            std::cout << "  Same inputs, different decision" << std::endl;
+        }
+        print_entry("expected", a);
+        print_entry("actual  ", b);
+        if (i > 0) {
+            std::cout << "  Previous (identical):" << std::endl;
+            print_entry("        ", (*expected)[i - 1]);
+        }
+        return 1;
+    }
+
+    if (expected->size() != actual->size()) {
+        std::cout << "Identical for " << common << " decisions, then "
+                  << (expected->size() > actual->size() ? argv[1] : argv[2]) << " has "
+                  << (std::max(expected->size(), actual->size()) - common) << " more" << std::endl;
+        const auto& longer = expected->size() > actual->size() ? *expected : *actual;
+        print_entry("next    ", longer[common]);
+        return 1;
+    }
+
+    std::cout << "Identical: " << common << " decisions" << std::endl;
+    return 0;
+}
@@ -0,0 +1,142 @@
+// Runs the quoting logic over a recorded day: books from a book store file
+// are pushed through a MockExchange into an OrderManager, on one thread as
+// in inline mode, and every decision goes to a decision journal for
+// journal_diff.
+//
+// Usage: replay --journal OUT [--config FILE] [--speed X] [--from TIME_US] store.mmbk
+
+#include "book_store.h"
+#include "config_loader.h"
+#include "mock_exchange.h"
+#include "order_manager.h"
+#include <iostream>
+#include <thread>
+
+using namespace MarketMaker;
+
+namespace {
+
+void usage(const char* program) {
+    std::cerr << "Usage: " << program << " --journal OUT [--config FILE] [--speed X] [--from TIME_US] store.mmbk"
+              << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string journal_path;
+    std::string config_path;
+    std::string store_path;
+    double speed = 1.0;  // Cooldowns and rate limits run on the wall clock
+    int64_t from_us = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--journal" && has_value) {
+            journal_path = argv[++i];
+        } else if (arg == "--config" && has_value) {
+            config_path = argv[++i];
+        } else if (arg == "--speed" && has_value) {
+            speed = std::stod(argv[++i]);
+        } else if (arg == "--from" && has_value) {
+            from_us = std::stoll(argv[++i]);
+        } else if (!arg.empty() && arg[0] == '-') {
+            usage(argv[0]);
+            return 2;
+        } else {
+            store_path = arg;
+        }
+    }
+    if (journal_path.empty() || store_path.empty() || speed < 0) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    BookStoreReader reader;
+    std::string error;
+    if (!reader.open(store_path, &error)) {
+        std::cerr << "Error: " << error << std::endl;
+        return 2;
+    }
+
+    // Production settings, minus everything that needs the network
+    Config config;
+    if (!config_path.empty()) {
+        auto loaded = ConfigLoader::load_from_file(config_path);
+        if (!loaded) {
+            return 2;
+        }
+        config = *loaded;
+    } else {
+        config.symbol = reader.symbol();
+    }
+    if (config.symbol != reader.symbol()) {
+        std::cerr << "Warning: config symbol " << config.symbol << " replayed over " << reader.symbol()
+                  << " books" << std::endl;
+    }
+    config.exchange_type = "mock";
+    config.sub_accounts.clear();
+    config.shared_rate_limit = false;
+    config.inline_strategy = true;
+    config.decision_journal = journal_path;
+
+    ExchangeConfig exchange_config;
+    exchange_config.exchange_type = config.exchange_type;
+    exchange_config.price_precision = config.price_precision;
+    exchange_config.quantity_precision = config.quantity_precision;
+
+    auto exchange = std::make_shared<MockExchange>();
+    exchange->initialize(exchange_config);
+    exchange->connect();
+
+    double mid_price = 0.0;
+    uint64_t books = 0;
+    uint64_t fills = 0;
+    {
+        OrderManager order_manager(exchange, config);
+        exchange->set_execution_handler([&](const ExecutionReport& report) {
+            ++fills;
+            order_manager.on_execution(report, mid_price);
+        });
+        // Fills go first, then the book, as the bot's handlers see them
+        exchange->set_orderbook_handler([&](const OrderBook& book) {
+            order_manager.on_orderbook(book);
+            if (book.bids.empty() || book.asks.empty()) {
+                return;
+            }
+            mid_price = book.get_mid_price();
+            order_manager.check_latency_slo();
+            order_manager.update_orders_if_needed(mid_price, book.timestamp);
+        });
+
+        BookStoreReplay replay(reader, from_us);
+        BookStoreReplay::Event event;
+        int64_t first_us = -1;
+        auto started = std::chrono::steady_clock::now();
+
+        while (replay.next(event)) {
+            if (event.kind != BookStoreReplay::Event::Kind::BOOK) {
+                continue;
+            }
+            if (first_us < 0) {
+                first_us = event.time_us;
+            }
+            if (speed > 0) {
+                std::this_thread::sleep_until(started + std::chrono::microseconds(
+                    static_cast<int64_t>(static_cast<double>(event.time_us - first_us) / speed)));
+            }
+            exchange->push_orderbook(*event.book);
+            ++books;
+        }
+
+        exchange->set_execution_handler(nullptr);
+        exchange->set_orderbook_handler(nullptr);
+        std::cout << "Replayed " << books << " books, " << fills << " fills, inventory "
+                  << order_manager.get_inventory() << std::endl;
+    }
+
+    exchange->disconnect();
+    std::cout << "Journal written to " << journal_path << std::endl;
+    return 0;
+}